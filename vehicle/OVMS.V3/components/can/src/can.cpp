@@ -48,6 +48,7 @@ static const char *TAG = "can";
 #include "ovms_config.h"
 #include "ovms_command.h"
 #include "metrics_standard.h"
+#include "ovms_malloc.h"
 
 #if defined(CONFIG_OVMS_COMP_ESP32CAN) || \
     defined(CONFIG_OVMS_COMP_MCP2515) || \
@@ -366,6 +367,8 @@ void can_status(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, c
     writer->printf("Wdg Timer: %20" PRId32 " sec(s)\n",monotonictime-sbus->m_watchdog_timer);
     }
   writer->printf("Err Resets:%20d\n",sbus->m_status.error_resets);
+
+  MyCan.ShowListenerStatus(writer);
   }
 
 void can_list(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
@@ -453,20 +456,32 @@ void can_set_register(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int a
 
 canfilter::canfilter()
   {
+  for (int i = 0; i <= CAN_MAXBUSES; i++)
+    {
+    m_compiled[i].all = false;
+    m_compiled[i].std = NULL;
+    }
   }
 
 canfilter::~canfilter()
   {
   ClearFilters();
+  for (int i = 0; i <= CAN_MAXBUSES; i++)
+    {
+    if (m_compiled[i].std)
+      free(m_compiled[i].std);
+    }
   }
 
 void canfilter::ClearFilters()
   {
+  OvmsMutexLock lock(&m_mutex);
   for (CAN_filter_t* filter : m_filters)
     {
     delete filter;
     }
   m_filters.clear();
+  Compile();
   }
 
 void canfilter::AddFilter(uint8_t bus, uint32_t id_from, uint32_t id_to)
@@ -475,7 +490,9 @@ void canfilter::AddFilter(uint8_t bus, uint32_t id_from, uint32_t id_to)
   f->bus = bus;
   f->id_from = id_from;
   f->id_to = id_to;
+  OvmsMutexLock lock(&m_mutex);
   m_filters.push_back(f);
+  Compile();
   }
 
 void canfilter::AddFilter(const char* filterstring)
@@ -506,39 +523,142 @@ void canfilter::AddFilter(const char* filterstring)
 
 bool canfilter::RemoveFilter(uint8_t bus, uint32_t id_from, uint32_t id_to)
   {
-  for (CAN_filter_t* filter : m_filters)
+  OvmsMutexLock lock(&m_mutex);
+  for (CAN_filter_list_t::iterator it = m_filters.begin(); it != m_filters.end(); ++it)
     {
+    CAN_filter_t* filter = *it;
     if ((filter->bus == bus)&&
         (filter->id_from == id_from)&&
         (filter->id_to == id_to))
       {
+      m_filters.erase(it);
       delete filter;
+      Compile();
       return true;
       }
     }
   return false;
   }
 
+/**
+ * Compile: build the per bus lookup structures from the filter list:
+ *  11 bit IDs are checked by a 2048 bit bitmap, higher IDs by a binary
+ *  search on sorted & merged ranges. Filters without bus apply to all.
+ *  - called with m_mutex held; the structures are built into new storage
+ *    and swapped in, so no frame is checked against a partial build
+ */
+void canfilter::Compile()
+  {
+  CAN_filter_bus_t compiled[CAN_MAXBUSES+1];
+
+  for (int slot = 0; slot <= CAN_MAXBUSES; slot++)
+    {
+    CAN_filter_bus_t& cb = compiled[slot];
+    char buskey = '0' + slot;
+    cb.all = false;
+    cb.std = NULL;
+
+    for (CAN_filter_t* filter : m_filters)
+      {
+      if ((filter->bus)&&(filter->bus != buskey)) continue;
+      if (filter->id_from > filter->id_to) continue;
+      if ((filter->id_from == 0)&&(filter->id_to >= 0x1fffffff))
+        {
+        cb.all = true;
+        break;
+        }
+      if (filter->id_from < CAN_FILTER_STDBITS)
+        {
+        if (!cb.std)
+          cb.std = (uint32_t*)calloc(CAN_FILTER_STDBITS/32, sizeof(uint32_t));
+        if (!cb.std)
+          continue;
+        uint32_t to = (filter->id_to < CAN_FILTER_STDBITS) ? filter->id_to : CAN_FILTER_STDBITS-1;
+        for (uint32_t id = filter->id_from; id <= to; id++)
+          cb.std[id >> 5] |= 1u << (id & 31);
+        }
+      if (filter->id_to >= CAN_FILTER_STDBITS)
+        {
+        CAN_filter_range_t range;
+        range.id_from = (filter->id_from > CAN_FILTER_STDBITS) ? filter->id_from : CAN_FILTER_STDBITS;
+        range.id_to = filter->id_to;
+        cb.ext.push_back(range);
+        }
+      }
+
+    if (cb.all && cb.std)
+      {
+      free(cb.std);
+      cb.std = NULL;
+      }
+    if (cb.all || cb.ext.size() < 2)
+      continue;
+
+    // Sort & merge overlapping ranges:
+    std::sort(cb.ext.begin(), cb.ext.end(),
+      [](const CAN_filter_range_t& a, const CAN_filter_range_t& b) { return a.id_from < b.id_from; });
+    size_t n = 0;
+    for (size_t i = 1; i < cb.ext.size(); i++)
+      {
+      if (cb.ext[i].id_from <= cb.ext[n].id_to || cb.ext[i].id_from - 1 == cb.ext[n].id_to)
+        {
+        if (cb.ext[i].id_to > cb.ext[n].id_to)
+          cb.ext[n].id_to = cb.ext[i].id_to;
+        }
+      else
+        {
+        cb.ext[++n] = cb.ext[i];
+        }
+      }
+    cb.ext.resize(n+1);
+    cb.ext.shrink_to_fit();
+    }
+
+  // Swap in the new build & free the old one:
+  for (int slot = 0; slot <= CAN_MAXBUSES; slot++)
+    {
+    std::swap(m_compiled[slot], compiled[slot]);
+    if (compiled[slot].std)
+      free(compiled[slot].std);
+    }
+  }
+
 bool canfilter::IsFiltered(const CAN_frame_t* p_frame)
   {
+  OvmsMutexLock lock(&m_mutex);
   if (m_filters.size() == 0) return true;
   if (! p_frame) return false;
 
-  char buskey = '0';
-  if (p_frame->origin) buskey = p_frame->origin->m_busnumber + '1';
+  int slot = 0;
+  if (p_frame->origin) slot = p_frame->origin->m_busnumber + 1;
+  if (slot > CAN_MAXBUSES) return false;
 
-  for (CAN_filter_t* filter : m_filters)
+  const CAN_filter_bus_t& cb = m_compiled[slot];
+  if (cb.all) return true;
+
+  uint32_t id = p_frame->MsgID;
+  if (id < CAN_FILTER_STDBITS)
+    return (cb.std) && (cb.std[id >> 5] & (1u << (id & 31)));
+
+  // Binary search for the last range starting at or below id:
+  int lo = 0, hi = (int)cb.ext.size() - 1;
+  while (lo <= hi)
     {
-    if ((filter->bus)&&(filter->bus != buskey)) continue;
-    if ((p_frame->MsgID >= filter->id_from) && (p_frame->MsgID <= filter->id_to))
-      return true;
+    int mid = (lo + hi) / 2;
+    if (cb.ext[mid].id_from <= id)
+      {
+      if (id <= cb.ext[mid].id_to) return true;
+      lo = mid + 1;
+      }
+    else
+      hi = mid - 1;
     }
-
   return false;
   }
 
 bool canfilter::IsFiltered(canbus* bus)
   {
+  OvmsMutexLock lock(&m_mutex);
   if (m_filters.size() == 0) return true;
   if (bus == NULL) return true;
 
@@ -554,6 +674,7 @@ bool canfilter::IsFiltered(canbus* bus)
 
 std::string canfilter::Info()
   {
+  OvmsMutexLock lock(&m_mutex);
   std::ostringstream buf;
 
   for (CAN_filter_t* filter : m_filters)
@@ -569,6 +690,222 @@ std::string canfilter::Info()
   return buf.str();
   }
 
+////////////////////////////////////////////////////////////////////////
+// CAN frame ring
+// Fan-out of CAN frames to multiple consumers without copying each frame
+// to each consumer queue
+////////////////////////////////////////////////////////////////////////
+
+canring::canring()
+  {
+  m_records = NULL;
+  m_head = 0;
+  m_readercount = 0;
+  }
+
+canring::~canring()
+  {
+  for (auto reader : m_readers)
+    delete reader;
+  m_readers.clear();
+  if (m_records)
+    free(m_records);
+  }
+
+/**
+ * Write: add a frame to the ring and wake up waiting readers interested in it
+ *  - no-op if there are no readers
+ */
+void canring::Write(canbus* bus, CAN_log_type_t type, const CAN_frame_t* frame)
+  {
+  if (m_readercount == 0)
+    return;
+
+  OvmsMutexLock lock(&m_mutex);
+  if (m_records == NULL)
+    return;
+  uint32_t seq = m_head + 1;
+  CAN_ring_record_t* rec = &m_records[seq & (CAN_RING_SIZE-1)];
+
+  rec->seq = seq - 1;   // invalid for any reader while being written
+  __sync_synchronize();
+  rec->type = type;
+  gettimeofday(&rec->timestamp, NULL);
+  memcpy(&rec->frame, frame, sizeof(CAN_frame_t));
+  rec->frame.origin = bus;
+  __sync_synchronize();
+  rec->seq = seq;
+  m_head = seq;
+  // Pairs with PrepareWait(): either the reader sees the new head,
+  // or we see its m_waiting flag:
+  __sync_synchronize();
+
+  for (auto reader : m_readers)
+    {
+    if (reader->m_waiting && reader->Matches(type, bus))
+      {
+      reader->m_waiting = false;
+      xTaskNotifyGive(reader->m_task);
+      }
+    }
+  }
+
+/**
+ * AddReader: create a reader starting with the next frame written
+ *  - types: CAN_RING_TYPE bit set of frame types to read
+ *  - busmask: bit set of bus numbers to read (bit 0 = can1)
+ */
+canring_reader* canring::AddReader(const char* caller, uint32_t types, uint8_t busmask)
+  {
+  OvmsMutexLock lock(&m_mutex);
+  if (m_records == NULL)
+    {
+    m_records = (CAN_ring_record_t*) ExternalRamCalloc(CAN_RING_SIZE, sizeof(CAN_ring_record_t));
+    if (m_records == NULL)
+      ESP_LOGE(TAG, "AddReader(%s): ring allocation failed, no frames will be delivered", caller);
+    }
+  canring_reader* reader = new canring_reader(this, caller, types, busmask);
+  m_readers.push_back(reader);
+  m_readercount = m_readers.size();
+  return reader;
+  }
+
+/**
+ * DetachReader: stop delivering frames & notifications to a reader
+ *  Call this before deleting the reading task, so Write() cannot notify
+ *  the deleted task. The reader stays valid until RemoveReader().
+ */
+void canring::DetachReader(canring_reader* reader)
+  {
+  if (reader == NULL)
+    return;
+  OvmsMutexLock lock(&m_mutex);
+  m_readers.remove(reader);
+  m_readercount = m_readers.size();
+  reader->m_waiting = false;
+  reader->m_task = NULL;
+  }
+
+/**
+ * RemoveReader: remove & delete a reader
+ *  Note: the reading task must not use the reader any more
+ */
+void canring::RemoveReader(canring_reader* reader)
+  {
+  if (reader == NULL)
+    return;
+  DetachReader(reader);
+  delete reader;
+  }
+
+void canring::ShowStatus(OvmsWriter* writer)
+  {
+  OvmsMutexLock lock(&m_mutex);
+  for (auto reader : m_readers)
+    {
+    writer->printf("%-16.16s %12" PRIu32 "%12" PRIu32 "%12" PRIu32 "  (ring)\n",
+      (reader->m_caller && *reader->m_caller) ? reader->m_caller : "-",
+      reader->m_delivered, reader->m_filtered, reader->m_overflows);
+    }
+  }
+
+canring_reader::canring_reader(canring* ring, const char* caller, uint32_t types, uint8_t busmask)
+  {
+  m_ring = ring;
+  m_caller = caller;
+  m_types = types;
+  m_busmask = busmask;
+  m_next = ring->m_head + 1;
+  m_task = NULL;
+  m_waiting = false;
+  m_delivered = 0;
+  m_filtered = 0;
+  m_overflows = 0;
+  }
+
+/**
+ * Available: number of frames written but not yet read (including frames
+ *  that will be skipped by type or bus)
+ */
+uint32_t canring_reader::Available()
+  {
+  uint32_t avail = m_ring->m_head + 1 - m_next;
+  return ((int32_t)avail > 0) ? avail : 0;
+  }
+
+/**
+ * PrepareWait: register the calling task for a notification on the next
+ *  matching frame. Check for available frames after calling this, then
+ *  block in ulTaskNotifyTake().
+ */
+void canring_reader::PrepareWait()
+  {
+  m_task = xTaskGetCurrentTaskHandle();
+  m_waiting = true;
+  __sync_synchronize();
+  }
+
+/**
+ * Read: get the next frame matching the reader types & buses
+ *  - wait: ticks to wait for a frame (0 = don't wait)
+ *  - type, timestamp: optional frame log type & reception time
+ *  Returns false on timeout.
+ */
+bool canring_reader::Read(CAN_frame_t* frame, TickType_t wait, CAN_log_type_t* type, struct timeval* timestamp)
+  {
+  while (1)
+    {
+    uint32_t head = m_ring->m_head;
+    if ((int32_t)(head - m_next) < 0)
+      {
+      // No new frames:
+      if (wait == 0)
+        return false;
+      PrepareWait();
+      if (m_ring->m_head != head)
+        continue;
+      if (ulTaskNotifyTake(pdTRUE, wait) == 0)
+        {
+        m_waiting = false;
+        return false;
+        }
+      continue;
+      }
+
+    if (head - m_next >= CAN_RING_SIZE)
+      {
+      // Reader too slow, skip overwritten frames:
+      uint32_t lost = head - m_next - CAN_RING_SIZE + 1;
+      m_overflows += lost;
+      m_next += lost;
+      }
+
+    const CAN_ring_record_t* rec = &m_ring->m_records[m_next & (CAN_RING_SIZE-1)];
+    CAN_log_type_t rectype = rec->type;
+    if (timestamp) *timestamp = rec->timestamp;
+    memcpy(frame, &rec->frame, sizeof(CAN_frame_t));
+    __sync_synchronize();
+    if (rec->seq != m_next)
+      {
+      // Overwritten while copying:
+      m_overflows++;
+      m_next++;
+      continue;
+      }
+    m_next++;
+
+    if (!Matches(rectype, frame->origin))
+      {
+      m_filtered++;
+      continue;
+      }
+
+    if (type) *type = rectype;
+    m_delivered++;
+    return true;
+    }
+  }
+
 ////////////////////////////////////////////////////////////////////////
 // CAN logging and tracing
 // These structures are involved in formatting, logging and tracing of
@@ -594,14 +931,12 @@ const char* GetCanLogTypeName(CAN_log_type_t type)
   return CAN_log_type_names[type];
   }
 
+/**
+ * LogFrame: frames are passed to the loggers (and other readers) via the ring
+ */
 void can::LogFrame(canbus* bus, CAN_log_type_t type, const CAN_frame_t* frame)
   {
-  OvmsRecMutexLock lock(&m_loggermap_mutex);
-
-  for (canlog_map_t::iterator it=m_loggermap.begin(); it!=m_loggermap.end(); ++it)
-    {
-    it->second->LogFrame(bus, type, frame);
-    }
+  m_ring.Write(bus, type, frame);
   }
 
 void can::LogStatus(canbus* bus, CAN_log_type_t type, const CAN_status_t* status)
@@ -713,6 +1048,14 @@ uint32_t can::AddLogger(canlog* logger, int filterc, const char* const* filterv)
     logger->SetFilter(filter);
     }
 
+  // Start feeding frames to the logger task:
+  if (!logger->m_reader)
+    {
+    logger->m_reader = m_ring.AddReader(logger->GetType(), CAN_RING_ALL);
+    if (logger->m_task)
+      xTaskNotifyGive(logger->m_task);
+    }
+
   OvmsRecMutexLock lock(&m_loggermap_mutex);
   uint32_t id = m_logger_id++;
   m_loggermap[id] = logger;
@@ -780,6 +1123,7 @@ uint32_t can::AddPlayer(canplay* player, int filterc, const char* const* filterv
   OvmsMutexLock lock(&m_playermap_mutex);
   uint32_t id = m_player_id++;
   m_playermap[id] = player;
+  player->Start();
 
   return id;
   }
@@ -963,25 +1307,75 @@ void can::IncomingFrame(CAN_frame_t* p_frame)
   NotifyListeners(p_frame, false);
   }
 
-void can::RegisterListener(QueueHandle_t queue, bool txfeedback)
+/**
+ * RegisterListener: register a queue to receive copies of CAN frames
+ *  - filter: optional canfilter (ownership is transferred), only matching
+ *    frames will be sent to the queue
+ *  - registering an already registered queue replaces its settings & filter
+ */
+void can::RegisterListener(QueueHandle_t queue, bool txfeedback, const char* caller, canfilter* filter)
   {
-  m_listeners[queue] = txfeedback;
+  OvmsMutexLock lock(&m_listeners_mutex);
+  auto it = m_listeners.find(queue);
+  if (it != m_listeners.end())
+    {
+    CanListenerEntry* entry = it->second;
+    entry->m_txfeedback = txfeedback;
+    entry->m_caller = caller;
+    if (entry->m_filter) delete entry->m_filter;
+    entry->m_filter = filter;
+    }
+  else
+    {
+    m_listeners[queue] = new CanListenerEntry(queue, txfeedback, caller, filter);
+    }
   }
 
 void can::DeregisterListener(QueueHandle_t queue)
   {
+  OvmsMutexLock lock(&m_listeners_mutex);
   auto it = m_listeners.find(queue);
   if (it != m_listeners.end())
+    {
+    delete it->second;
     m_listeners.erase(it);
+    }
   }
 
 void can::NotifyListeners(const CAN_frame_t* frame, bool tx)
   {
+  OvmsMutexLock lock(&m_listeners_mutex);
+  for (CanListenerMap_t::iterator it = m_listeners.begin(); it != m_listeners.end(); ++it)
+    {
+    CanListenerEntry* entry = it->second;
+    if (tx && !entry->m_txfeedback)
+      continue;
+    if (entry->m_filter && !entry->m_filter->IsFiltered(frame))
+      {
+      entry->m_filtered++;
+      continue;
+      }
+    if (xQueueSend(entry->m_queue,frame,0) == pdTRUE)
+      entry->m_delivered++;
+    else
+      entry->m_overflows++;
+    }
+  }
+
+void can::ShowListenerStatus(OvmsWriter* writer)
+  {
+  OvmsMutexLock lock(&m_listeners_mutex);
+  if (m_listeners.empty() && m_ring.m_readercount == 0)
+    return;
+  writer->printf("\nListener            Delivered    Filtered   Overflows\n");
   for (CanListenerMap_t::iterator it = m_listeners.begin(); it != m_listeners.end(); ++it)
     {
-    if (!tx || (tx && it->second))
-      xQueueSend(it->first,frame,0);
+    CanListenerEntry* entry = it->second;
+    writer->printf("%-16.16s %12" PRIu32 "%12" PRIu32 "%12" PRIu32 "\n",
+      (entry->m_caller && *entry->m_caller) ? entry->m_caller : "-",
+      entry->m_delivered, entry->m_filtered, entry->m_overflows);
     }
+  m_ring.ShowStatus(writer);
   }
 
 void can::RegisterCallback(const char* caller, CanFrameCallback callback, bool txfeedback)
@@ -42,9 +42,11 @@
 #include <stdint.h>
 #include <functional>
 #include <list>
+#include <vector>
 #include "pcp.h"
 #include <esp_err.h>
 #include "ovms_events.h"
+#include "ovms_mutex.h"
 
 ////////////////////////////////////////////////////////////////////////
 // Constant ESP_QUEUED to indicate a 'queued' response
@@ -212,6 +214,21 @@ typedef struct
 
 typedef std::list<CAN_filter_t*> CAN_filter_list_t;
 
+// Compiled filter for one bus (index 0 = frames without origin):
+#define CAN_FILTER_STDBITS  0x800     // 11 bit IDs covered by the bitmap
+typedef struct
+  {
+  uint32_t id_from;
+  uint32_t id_to;
+  } CAN_filter_range_t;
+
+typedef struct
+  {
+  bool all;                           // all IDs pass
+  uint32_t* std;                      // bitmap for IDs < 0x800, NULL = none
+  std::vector<CAN_filter_range_t> ext; // sorted disjoint ranges of IDs >= 0x800
+  } CAN_filter_bus_t;
+
 class canfilter
   {
   public:
@@ -230,7 +247,12 @@ class canfilter
     std::string Info();
 
   protected:
+    void Compile();
+
+  protected:
+    OvmsMutex m_mutex;                // guards filter list & compiled filters
     CAN_filter_list_t m_filters;
+    CAN_filter_bus_t m_compiled[CAN_MAXBUSES+1];
   };
 
 ////////////////////////////////////////////////////////////////////////
@@ -283,6 +305,7 @@ extern const char* GetCanLogTypeName(CAN_log_type_t type);
 
 class canlog;
 class canplay;
+class OvmsWriter;
 class dbcfile;
 
 class canbus : public pcp, public InternalRamAllocated
@@ -346,8 +369,111 @@ class canbus : public pcp, public InternalRamAllocated
 // can - the CAN system controller
 ////////////////////////////////////////////////////////////////////////
 
-typedef std::map<QueueHandle_t, bool> CanListenerMap_t;
+class CanListenerEntry
+  {
+  public:
+    CanListenerEntry(QueueHandle_t queue, bool txfeedback, const char* caller, canfilter* filter)
+      {
+      m_queue = queue;
+      m_txfeedback = txfeedback;
+      m_caller = caller;
+      m_filter = filter;
+      m_delivered = 0;
+      m_filtered = 0;
+      m_overflows = 0;
+      }
+    ~CanListenerEntry()
+      {
+      if (m_filter) delete m_filter;
+      }
+  public:
+    QueueHandle_t m_queue;
+    bool m_txfeedback;
+    const char *m_caller;
+    canfilter* m_filter;              // NULL = receive all frames
+    uint32_t m_delivered;             // Frames sent to the queue
+    uint32_t m_filtered;              // Frames not matching the filter
+    uint32_t m_overflows;             // Frames lost due to queue full
+  };
+typedef std::map<QueueHandle_t, CanListenerEntry*> CanListenerMap_t;
+
+
+/**
+ * canring: single producer / multiple consumer ring of CAN frames
+ *
+ * Frames (RX, TX & TX failures) are written once with their timestamp,
+ * readers fetch them by sequence number at their own pace. A reader that
+ * falls behind by more than the ring size loses the oldest frames, this is
+ * counted as overflows for that reader only. Writes are serialized by the
+ * ring mutex, reading is lock free.
+ */
+
+#define CAN_RING_SIZE             CONFIG_OVMS_HW_CAN_RING_SIZE
+static_assert((CAN_RING_SIZE & (CAN_RING_SIZE-1)) == 0, "CONFIG_OVMS_HW_CAN_RING_SIZE must be a power of 2");
+#define CAN_RING_TYPE(t)          (1 << (t))
+#define CAN_RING_RX               CAN_RING_TYPE(CAN_LogFrame_RX)
+#define CAN_RING_RXTX             (CAN_RING_RX | CAN_RING_TYPE(CAN_LogFrame_TX))
+#define CAN_RING_ALL              (CAN_RING_RXTX | CAN_RING_TYPE(CAN_LogFrame_TX_Queue) | CAN_RING_TYPE(CAN_LogFrame_TX_Fail))
+#define CAN_RING_ALLBUSES         0xff
 
+typedef struct
+  {
+  volatile uint32_t seq;                // Sequence number of the record
+  CAN_log_type_t type;
+  struct timeval timestamp;
+  CAN_frame_t frame;
+  } CAN_ring_record_t;
+
+class canring;
+
+class canring_reader
+  {
+  public:
+    canring_reader(canring* ring, const char* caller, uint32_t types, uint8_t busmask);
+
+  public:
+    bool Read(CAN_frame_t* frame, TickType_t wait, CAN_log_type_t* type=NULL, struct timeval* timestamp=NULL);
+    uint32_t Available();
+    void PrepareWait();
+    bool Matches(CAN_log_type_t type, const canbus* bus)
+      {
+      return (m_types & CAN_RING_TYPE(type)) && bus && (m_busmask & (1 << bus->m_busnumber));
+      }
+
+  public:
+    canring* m_ring;
+    const char* m_caller;
+    volatile uint32_t m_types;        // CAN_RING_TYPE bit set of frame types to read
+    volatile uint8_t m_busmask;       // Bit set of bus numbers to read
+    uint32_t m_next;                  // Sequence number of the next frame to read
+    TaskHandle_t m_task;              // Reading task (set on waiting)
+    volatile bool m_waiting;          // Reader waits for notification
+    uint32_t m_delivered;             // Frames read
+    uint32_t m_filtered;              // Frames skipped (type/bus)
+    uint32_t m_overflows;             // Frames lost due to reader too slow
+  };
+typedef std::list<canring_reader*> CanRingReaderList_t;
+
+class canring
+  {
+  public:
+    canring();
+    ~canring();
+
+  public:
+    void Write(canbus* bus, CAN_log_type_t type, const CAN_frame_t* frame);
+    canring_reader* AddReader(const char* caller, uint32_t types=CAN_RING_RX, uint8_t busmask=CAN_RING_ALLBUSES);
+    void DetachReader(canring_reader* reader);
+    void RemoveReader(canring_reader* reader);
+    void ShowStatus(OvmsWriter* writer);
+
+  public:
+    CAN_ring_record_t* m_records;
+    volatile uint32_t m_head;         // Sequence number of the last record written
+    volatile int m_readercount;
+    CanRingReaderList_t m_readers;
+    OvmsMutex m_mutex;
+  };
 
 class CanFrameCallbackEntry
   {
@@ -380,9 +506,14 @@ class can : public InternalRamAllocated
     QueueHandle_t m_rxqueue;
 
   public:
-    void RegisterListener(QueueHandle_t queue, bool txfeedback=false);
+    void RegisterListener(QueueHandle_t queue, bool txfeedback=false,
+                          const char* caller="", canfilter* filter=NULL);
     void DeregisterListener(QueueHandle_t queue);
     void NotifyListeners(const CAN_frame_t* frame, bool tx);
+    void ShowListenerStatus(OvmsWriter* writer);
+
+  public:
+    canring m_ring;                   // Frame fan-out to ring readers
 
   public:
     void RegisterCallback(const char* caller, CanFrameCallback callback, bool txfeedback=false);
@@ -426,6 +557,7 @@ class can : public InternalRamAllocated
   private:
     canbus* m_buslist[CAN_MAXBUSES];
     CanListenerMap_t m_listeners;
+    OvmsMutex m_listeners_mutex;
     CanFrameCallbackList_t m_rxcallbacks;
     CanFrameCallbackList_t m_txcallbacks;
     TaskHandle_t m_rxtask;            // Task to handle reception
@@ -95,6 +95,15 @@ std::string canformat::get(CAN_log_message_t* message)
   return std::string("");
   }
 
+/**
+ * append: add the formatted message to result. Formats should override this
+ *  to avoid the temporary string of get() on the logging hot path.
+ */
+void canformat::append(CAN_log_message_t* message, std::string& result)
+  {
+  result.append(get(message));
+  }
+
 std::string canformat::getheader(struct timeval *time)
   {
   return std::string("");
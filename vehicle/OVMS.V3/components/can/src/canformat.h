@@ -55,6 +55,7 @@ class canformat
 
   public: // Conversion from OVMS CAN log messages to specific format
     virtual std::string get(CAN_log_message_t* message);
+    virtual void append(CAN_log_message_t* message, std::string& result);
     virtual std::string getheader(struct timeval *time = NULL);
 
   public: // Conversion from specific format to OVMS CAN log messages
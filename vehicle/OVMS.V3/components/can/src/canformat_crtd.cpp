@@ -57,6 +57,19 @@ canformat_crtd::~canformat_crtd()
 std::string canformat_crtd::get(CAN_log_message_t* message)
   {
   char buf[CANFORMAT_CRTD_MAXLEN];
+  size_t len = format(message, buf, sizeof(buf));
+  return std::string(buf, len);
+  }
+
+void canformat_crtd::append(CAN_log_message_t* message, std::string& result)
+  {
+  char buf[CANFORMAT_CRTD_MAXLEN];
+  size_t len = format(message, buf, sizeof(buf));
+  result.append(buf, len);
+  }
+
+size_t canformat_crtd::format(CAN_log_message_t* message, char* buf, size_t size)
+  {
   char *p;
 
   char busnumber;
@@ -69,7 +82,7 @@ std::string canformat_crtd::get(CAN_log_message_t* message)
     {
     case CAN_LogFrame_RX:
     case CAN_LogFrame_TX:
-      snprintf(buf,sizeof(buf),"%l" PRId32 ".%06ld %c%c%s %0*" PRIX32,
+      snprintf(buf,size,"%l" PRId32 ".%06ld %c%c%s %0*" PRIX32,
         message->timestamp.tv_sec, message->timestamp.tv_usec,
         busnumber,
         (message->type == CAN_LogFrame_RX) ? 'R' : 'T',
@@ -87,7 +100,7 @@ std::string canformat_crtd::get(CAN_log_message_t* message)
 
     case CAN_LogFrame_TX_Queue:
     case CAN_LogFrame_TX_Fail:
-      snprintf(buf,sizeof(buf),"%l" PRId32 ".%06ld %cCER %s %c%s %0*" PRIX32,
+      snprintf(buf,size,"%l" PRId32 ".%06ld %cCER %s %c%s %0*" PRIX32,
         message->timestamp.tv_sec, message->timestamp.tv_usec,
         busnumber,
         GetCanLogTypeName(message->type),
@@ -106,7 +119,7 @@ std::string canformat_crtd::get(CAN_log_message_t* message)
 
     case CAN_LogStatus_Error:
     case CAN_LogStatus_Statistics:
-      snprintf(buf,sizeof(buf),
+      snprintf(buf,size,
         "%l" PRId32 ".%06ld %c%s %s intr=%" PRId32 " rxpkt=%" PRId32 " txpkt=%" PRId32 " errflags=%#" PRIx32 " rxerr=%d txerr=%d"
         " rxinval=%d rxovr=%d txovr=%d txdelay=%" PRId32 " txfail=%" PRId32 " wdgreset=%d errreset=%d",
         message->timestamp.tv_sec, message->timestamp.tv_usec,
@@ -124,7 +137,7 @@ std::string canformat_crtd::get(CAN_log_message_t* message)
     case CAN_LogInfo_Config:
     case CAN_LogInfo_Event:
     case CAN_LogInfo_Metric:
-      snprintf(buf,sizeof(buf),"%l" PRId32 ".%06ld %c%s %s %s",
+      snprintf(buf,size,"%l" PRId32 ".%06ld %c%s %s %s",
         message->timestamp.tv_sec, message->timestamp.tv_usec,
         busnumber,
         (message->type == CAN_LogInfo_Event) ? "CEV" : (message->type == CAN_LogInfo_Metric) ? "CMT" : "CXX",
@@ -137,8 +150,11 @@ std::string canformat_crtd::get(CAN_log_message_t* message)
       break;
     }
 
-  strcat(buf,"\n");
-  return std::string(buf);
+  size_t len = strlen(buf);
+  if (len > size-2) len = size-2;
+  buf[len++] = '\n';
+  buf[len] = 0;
+  return len;
   }
 
 std::string canformat_crtd::getheader(struct timeval *time)
@@ -178,6 +194,20 @@ size_t canformat_crtd::put(CAN_log_message_t* message, uint8_t *buffer, size_t l
     // We look for something like
     // 1524311386.811100 1R11 100 01 02 03
     if (!isdigit(b[0])) return consumed;    // Discard invalid line
+    message->timestamp.tv_sec = strtol(b,NULL,10);
+    for (;((*b != 0)&&(*b != ' ')&&(*b != '.'));b++) {}
+    if (*b == '.')
+      {
+      // Fraction may have any precision, scale to microseconds:
+      long usec = 0;
+      int digits = 0;
+      for (b++;isdigit(*b);b++)
+        {
+        if (digits++ < 6) usec = usec*10 + (*b - '0');
+        }
+      for (;digits < 6;digits++) usec *= 10;
+      message->timestamp.tv_usec = usec;
+      }
     for (;((*b != 0)&&(*b != ' '));b++) {}
     if (*b == 0) return consumed;           // Discard invalid line
     b++;
@@ -39,8 +39,12 @@ class canformat_crtd : public canformat
 
   public:
     virtual std::string get(CAN_log_message_t* message);
+    virtual void append(CAN_log_message_t* message, std::string& result);
     virtual std::string getheader(struct timeval *time);
     virtual size_t put(CAN_log_message_t* message, uint8_t *buffer, size_t len, bool* hasmore, canlogconnection* clc=NULL);
+
+  protected:
+    size_t format(CAN_log_message_t* message, char* buf, size_t size);
   };
 
 #endif // __CANFORMAT_CRTD_H__
@@ -126,7 +126,8 @@ size_t canformat_gvret_ascii::put(CAN_log_message_t* message, uint8_t *buffer, s
   else
     {
     std::string line = m_buf.ReadLine();
-    char *b = strdup(line.c_str());
+    char *s = strdup(line.c_str());
+    char *b = s;
 
     // We look for something like
     // 1000 - 100 S 0 4 01 02 03 04
@@ -135,8 +136,8 @@ size_t canformat_gvret_ascii::put(CAN_log_message_t* message, uint8_t *buffer, s
     message->type = CAN_LogFrame_RX;
 
     uint32_t timestamp = strtol(b,&b,10);
-    message->timestamp.tv_sec = timestamp % 1000000;
-    message->timestamp.tv_usec = timestamp / 1000000;
+    message->timestamp.tv_sec = timestamp / 1000000;
+    message->timestamp.tv_usec = timestamp % 1000000;
 
     b += 2; // Skip the '-'
 
@@ -152,7 +153,7 @@ size_t canformat_gvret_ascii::put(CAN_log_message_t* message, uint8_t *buffer, s
     else
       {
       // Bad frame type - discard
-      free(b);
+      free(s);
       return consumed;
       }
 
@@ -164,7 +165,7 @@ size_t canformat_gvret_ascii::put(CAN_log_message_t* message, uint8_t *buffer, s
     if (message->frame.FIR.B.DLC > 8)
       {
       // Bad frame length - discard
-      free(b);
+      free(s);
       return consumed;
       }
 
@@ -173,9 +174,9 @@ size_t canformat_gvret_ascii::put(CAN_log_message_t* message, uint8_t *buffer, s
       message->frame.data.u8[x] = strtol(b,&b,16);
       }
 
-    message->origin = MyCan.GetBus(busnumber-'0');
+    message->origin = MyCan.GetBus(busnumber);
 
-    free(b);
+    free(s);
     return consumed;
     }
   }
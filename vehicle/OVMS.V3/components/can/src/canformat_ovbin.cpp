@@ -0,0 +1,382 @@
+/*
+;    Project:       Open Vehicle Monitor System
+;    Module:        CAN dump compact binary format
+;    Date:          16th October 2026
+;
+;    (C) 2026       OVMS contributors
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in
+; all copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+; THE SOFTWARE.
+*/
+
+#include "ovms_log.h"
+static const char *TAG = "canformat-ovbin";
+
+#include "canformat_ovbin.h"
+#include "pcp.h"
+
+class OvmsCanFormatOVBINInit
+  {
+  public: OvmsCanFormatOVBINInit();
+} MyOvmsCanFormatOVBINInit  __attribute__ ((init_priority (4505)));
+
+OvmsCanFormatOVBINInit::OvmsCanFormatOVBINInit()
+  {
+  ESP_LOGI(TAG, "Registering CAN Format: OVBIN (4505)");
+
+  MyCanFormatFactory.RegisterCanFormat<canformat_ovbin>("ovbin");
+  }
+
+static const char ovbin_marker[4] = { '\xff', 'O', 'V', 'B' };
+
+static inline void AppendVarint(std::string& result, uint64_t value)
+  {
+  while (value >= 0x80)
+    {
+    result.push_back((char)(value | 0x80));
+    value >>= 7;
+    }
+  result.push_back((char)value);
+  }
+
+/**
+ * GetVarint: decode a varint from buf at pos
+ *  Returns 1 on success (pos advanced), 0 if incomplete, -1 if invalid
+ */
+static inline int GetVarint(const uint8_t* buf, size_t len, size_t& pos, uint64_t& value)
+  {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7)
+    {
+    if (pos >= len) return 0;
+    uint8_t b = buf[pos++];
+    value |= (uint64_t)(b & 0x7f) << shift;
+    if ((b & 0x80) == 0) return 1;
+    }
+  return -1;
+  }
+
+canformat_ovbin::canformat_ovbin(const char* type)
+  : canformat(type)
+  {
+  m_enctime = 0;
+  m_encrecords = 0;
+  m_enctotal = 0;
+  m_encbytes = 0;
+  m_encsync = true;
+  m_dectime = 0;
+  m_decsynced = false;
+  }
+
+canformat_ovbin::~canformat_ovbin()
+  {
+  }
+
+std::string canformat_ovbin::get(CAN_log_message_t* message)
+  {
+  std::string result;
+  append(message, result);
+  return result;
+  }
+
+void canformat_ovbin::append(CAN_log_message_t* message, std::string& result)
+  {
+  if (message->type < CAN_LogFrame_RX || message->type > CAN_LogInfo_Metric)
+    return;
+
+  size_t start = result.size();
+  int64_t time = (int64_t)message->timestamp.tv_sec * 1000000 + message->timestamp.tv_usec;
+  if (m_encsync || m_encrecords >= CANFORMAT_OVBIN_SYNCRECORDS || time < m_enctime)
+    AppendSync(result, &message->timestamp);
+
+  int bus = CANFORMAT_OVBIN_NOBUS;
+  if (message->origin != NULL && message->origin->m_busnumber < CANFORMAT_OVBIN_NOBUS)
+    bus = message->origin->m_busnumber;
+
+  if (message->type <= CAN_LogFrame_TX_Fail)
+    {
+    CAN_frame_t* frame = &message->frame;
+    uint8_t dlc = (frame->FIR.B.DLC <= 8) ? frame->FIR.B.DLC : 8;
+    uint8_t spec = ((message->type - CAN_LogFrame_RX) << 6)
+      | ((frame->FIR.B.FF == CAN_frame_ext) ? 0x20 : 0)
+      | ((frame->FIR.B.RTR == CAN_RTR) ? 0x10 : 0)
+      | dlc;
+    uint64_t key = ((uint64_t)spec << 32) | frame->MsgID;
+
+    auto it = m_encdict[bus].find(key);
+    if (it != m_encdict[bus].end())
+      {
+      result.push_back((char)(bus << 3));
+      AppendVarint(result, it->second);
+      }
+    else
+      {
+      if (m_encdict[bus].size() >= CANFORMAT_OVBIN_DICTSIZE)
+        {
+        // Dictionary full: start over
+        start = result.size();
+        AppendSync(result, &message->timestamp);
+        }
+      uint32_t index = m_encdict[bus].size();
+      m_encdict[bus][key] = index;
+      result.push_back((char)(0x40 | (bus << 3)));
+      result.push_back((char)spec);
+      AppendVarint(result, frame->MsgID);
+      }
+    AppendVarint(result, time - m_enctime);
+    result.append((const char*)frame->data.u8, dlc);
+    }
+  else
+    {
+    result.push_back((char)(0x80 | (bus << 3) | (message->type - CAN_LogStatus_Error)));
+    AppendVarint(result, time - m_enctime);
+    if (message->type <= CAN_LogStatus_Statistics)
+      {
+      CAN_status_t* s = &message->status;
+      AppendVarint(result, s->interrupts);
+      AppendVarint(result, s->packets_rx);
+      AppendVarint(result, s->packets_tx);
+      AppendVarint(result, s->txbuf_delay);
+      AppendVarint(result, s->rxbuf_overflow);
+      AppendVarint(result, s->txbuf_overflow);
+      AppendVarint(result, s->tx_fails);
+      AppendVarint(result, s->error_flags);
+      AppendVarint(result, s->errors_rx);
+      AppendVarint(result, s->errors_tx);
+      AppendVarint(result, s->invalid_rx);
+      AppendVarint(result, s->watchdog_resets);
+      AppendVarint(result, s->error_resets);
+      AppendVarint(result, s->error_time);
+      }
+    else
+      {
+      size_t len = message->text ? strlen(message->text) : 0;
+      if (len > CANFORMAT_OVBIN_MAXTEXT) len = CANFORMAT_OVBIN_MAXTEXT;
+      AppendVarint(result, len);
+      result.append(message->text ? message->text : "", len);
+      }
+    }
+
+  m_enctime = time;
+  m_encrecords++;
+  m_enctotal++;
+  m_encbytes += result.size() - start;
+  }
+
+void canformat_ovbin::AppendSync(std::string& result, const struct timeval* time)
+  {
+  result.append(ovbin_marker, sizeof(ovbin_marker));
+  result.push_back('S');
+  AppendVarint(result, time->tv_sec);
+  AppendVarint(result, time->tv_usec);
+  AppendVarint(result, m_enctotal);
+  AppendVarint(result, m_encbytes);
+
+  for (int bus = 0; bus < CANFORMAT_OVBIN_BUSES; bus++)
+    m_encdict[bus].clear();
+  m_enctime = (int64_t)time->tv_sec * 1000000 + time->tv_usec;
+  m_encrecords = 0;
+  m_encbytes = 0;
+  m_encsync = false;
+  }
+
+/**
+ * getheader: a new stream starts, the next record will be preceded by a
+ *  sync block (so e.g. every cycled log file can be decoded on its own)
+ */
+std::string canformat_ovbin::getheader(struct timeval *time)
+  {
+  m_encsync = true;
+  m_enctotal = 0;
+  m_encbytes = 0;
+
+  std::string result(ovbin_marker, sizeof(ovbin_marker));
+  result.push_back('H');
+  result.push_back((char)CANFORMAT_OVBIN_VERSION);
+  return result;
+  }
+
+size_t canformat_ovbin::put(CAN_log_message_t* message, uint8_t *buffer, size_t len, bool* hasmore, canlogconnection* clc)
+  {
+  if (m_buf.FreeSpace()==0) SetServeDiscarding(true); // Buffer full, so discard from now on
+  if (IsServeDiscarding()) return len;  // Quick return if discarding
+
+  size_t consumed = Stuff(buffer,len);  // Stuff m_buf with as much as possible
+  size_t used = m_buf.UsedSpace();
+  if (used == 0) return consumed;
+
+  size_t avail = m_buf.Peek(std::min(used, (size_t)CANFORMAT_OVBIN_PEEKSIZE), m_rec);
+
+  if (!m_decsynced)
+    {
+    // Search for the next header / sync block:
+    size_t skip = 0;
+    while (skip < avail && memcmp(m_rec+skip, ovbin_marker, std::min(avail-skip, sizeof(ovbin_marker))) != 0)
+      skip++;
+    if (skip > 0)
+      {
+      *hasmore = true;
+      m_buf.Pop(skip, m_rec);
+      return consumed;
+      }
+    }
+
+  int reclen = Decode(message, m_rec, avail);
+  if (reclen == 0 && avail < used)
+    {
+    // Long record, peek more:
+    avail = m_buf.Peek(std::min(used, (size_t)CANFORMAT_OVBIN_MAXRECORD), m_rec);
+    reclen = Decode(message, m_rec, avail);
+    }
+
+  if (reclen == 0 && avail >= CANFORMAT_OVBIN_MAXRECORD)
+    reclen = -1;  // Cannot be a valid record
+
+  if (reclen < 0)
+    {
+    // Invalid data: skip to the next sync block
+    if (m_decsynced) ESP_LOGD(TAG, "Invalid record, resyncing");
+    m_decsynced = false;
+    memset(message, 0, sizeof(*message));
+    *hasmore = true;
+    m_buf.Pop(1, m_rec);
+    }
+  else if (reclen > 0)
+    {
+    *hasmore = true;
+    m_buf.Pop(reclen, m_rec);
+    }
+
+  return consumed;
+  }
+
+/**
+ * Decode: decode a record from buf
+ *  Only frame records are returned in message, other records are consumed
+ *  Returns the record length, 0 if incomplete, -1 if invalid
+ *  Decoder state is only changed on success.
+ */
+int canformat_ovbin::Decode(CAN_log_message_t* message, const uint8_t* buf, size_t len)
+  {
+  size_t pos = 1;
+  uint8_t tag = buf[0];
+  uint64_t v1, v2, v3, v4;
+  int res;
+
+  if (tag == (uint8_t)ovbin_marker[0])
+    {
+    // Header / sync block:
+    if (len < 5) return (memcmp(buf, ovbin_marker, len) == 0) ? 0 : -1;
+    if (memcmp(buf, ovbin_marker, sizeof(ovbin_marker)) != 0) return -1;
+    pos = 5;
+    if (buf[4] == 'H')
+      {
+      if (len < 6) return 0;
+      if (buf[5] != CANFORMAT_OVBIN_VERSION)
+        {
+        ESP_LOGW(TAG, "Unsupported format version %d", buf[5]);
+        return -1;
+        }
+      return 6;
+      }
+    else if (buf[4] == 'S')
+      {
+      if ((res = GetVarint(buf, len, pos, v1)) <= 0) return res;
+      if ((res = GetVarint(buf, len, pos, v2)) <= 0) return res;
+      if ((res = GetVarint(buf, len, pos, v3)) <= 0) return res;
+      if ((res = GetVarint(buf, len, pos, v4)) <= 0) return res;
+      if (v2 >= 1000000) return -1;
+      for (int bus = 0; bus < CANFORMAT_OVBIN_BUSES; bus++)
+        m_decdict[bus].clear();
+      m_dectime = (int64_t)v1 * 1000000 + v2;
+      m_decsynced = true;
+      return pos;
+      }
+    return -1;
+    }
+
+  if (!m_decsynced) return -1;
+
+  int bus = (tag >> 3) & 0x07;
+
+  if ((tag & 0x80) == 0)
+    {
+    // Frame:
+    if (tag & 0x07) return -1;
+    uint64_t key;
+    bool define = (tag & 0x40);
+    if (define)
+      {
+      if (pos >= len) return 0;
+      uint8_t spec = buf[pos++];
+      if ((res = GetVarint(buf, len, pos, v1)) <= 0) return res;
+      if ((spec & 0x0f) > 8 || v1 > 0x1fffffff) return -1;
+      if (m_decdict[bus].size() >= CANFORMAT_OVBIN_DICTSIZE) return -1;
+      key = ((uint64_t)spec << 32) | v1;
+      }
+    else
+      {
+      if ((res = GetVarint(buf, len, pos, v1)) <= 0) return res;
+      if (v1 >= m_decdict[bus].size()) return -1;
+      key = m_decdict[bus][v1];
+      }
+    if ((res = GetVarint(buf, len, pos, v2)) <= 0) return res;
+    uint8_t spec = key >> 32;
+    uint8_t dlc = spec & 0x0f;
+    if (pos + dlc > len) return 0;
+
+    // Complete, commit:
+    if (define) m_decdict[bus].push_back(key);
+    m_dectime += v2;
+    message->type = (CAN_log_type_t)(CAN_LogFrame_RX + (spec >> 6));
+    message->timestamp.tv_sec = m_dectime / 1000000;
+    message->timestamp.tv_usec = m_dectime % 1000000;
+    message->frame.FIR.B.FF = (spec & 0x20) ? CAN_frame_ext : CAN_frame_std;
+    message->frame.FIR.B.RTR = (spec & 0x10) ? CAN_RTR : CAN_no_RTR;
+    message->frame.FIR.B.DLC = dlc;
+    message->frame.MsgID = (uint32_t)key;
+    memcpy(message->frame.data.u8, buf+pos, dlc);
+    message->origin = (bus == CANFORMAT_OVBIN_NOBUS) ? NULL : MyCan.GetBus(bus);
+    return pos + dlc;
+    }
+  else if (tag < 0xc0)
+    {
+    // Status / info:
+    int type = CAN_LogStatus_Error + (tag & 0x07);
+    if (type > CAN_LogInfo_Metric) return -1;
+    if ((res = GetVarint(buf, len, pos, v2)) <= 0) return res;
+    if (type <= CAN_LogStatus_Statistics)
+      {
+      for (int k = 0; k < 14; k++)
+        {
+        if ((res = GetVarint(buf, len, pos, v1)) <= 0) return res;
+        }
+      }
+    else
+      {
+      if ((res = GetVarint(buf, len, pos, v1)) <= 0) return res;
+      if (v1 > CANFORMAT_OVBIN_MAXTEXT) return -1;
+      if (pos + v1 > len) return 0;
+      pos += v1;
+      }
+    m_dectime += v2;
+    return pos;
+    }
+
+  return -1;
+  }
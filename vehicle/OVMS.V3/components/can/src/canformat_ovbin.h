@@ -0,0 +1,95 @@
+/*
+;    Project:       Open Vehicle Monitor System
+;    Module:        CAN dump compact binary format
+;    Date:          16th October 2026
+;
+;    (C) 2026       OVMS contributors
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in
+; all copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+; THE SOFTWARE.
+*/
+
+#ifndef __CANFORMAT_OVBIN_H__
+#define __CANFORMAT_OVBIN_H__
+
+#include <map>
+#include <vector>
+#include "canformat.h"
+
+// Compact binary log format "ovbin":
+//
+// All multi byte numbers are unsigned LEB128 varints ("v").
+// Stream header:  FF 'O' 'V' 'B' 'H' <version>
+// Sync block:     FF 'O' 'V' 'B' 'S' v:sec v:usec v:records v:prevbytes
+//                 (records: number of records since stream start,
+//                 prevbytes: distance in bytes to the previous sync block)
+// Frame:          0NBBB000 [spec v:id | v:index] v:dt <DLC data bytes>
+//                 N=1: new dictionary entry for bus BBB follows:
+//                   spec = <type-RX:2><FF:1><RTR:1><DLC:4>
+//                 N=0: reference to dictionary entry <index>
+// Other:          10BBBTTT v:dt <payload>
+//                 TTT = type - CAN_LogStatus_Error
+//                 payload status: CAN_status_t fields as varints
+//                 payload info: v:length <text>
+//
+// dt is the time in microseconds since the previous record. Sync blocks
+// provide the absolute time and reset all bus dictionaries. A decoder joining
+// a stream or hitting corrupted data skips input up to the next sync block.
+
+#define CANFORMAT_OVBIN_VERSION       1
+#define CANFORMAT_OVBIN_SYNCRECORDS   1024    // Records between sync blocks
+#define CANFORMAT_OVBIN_DICTSIZE      512     // Max entries per bus dictionary
+#define CANFORMAT_OVBIN_MAXTEXT       255     // Max info text length
+#define CANFORMAT_OVBIN_PEEKSIZE      32      // Max frame record size
+#define CANFORMAT_OVBIN_MAXRECORD     (CANFORMAT_OVBIN_MAXTEXT+32)
+#define CANFORMAT_OVBIN_BUSES         8       // Bus field range
+#define CANFORMAT_OVBIN_NOBUS         7       // Bus field value for no origin
+
+class canformat_ovbin : public canformat
+  {
+  public:
+    canformat_ovbin(const char* type);
+    virtual ~canformat_ovbin();
+
+  public:
+    virtual std::string get(CAN_log_message_t* message);
+    virtual void append(CAN_log_message_t* message, std::string& result);
+    virtual std::string getheader(struct timeval *time);
+    virtual size_t put(CAN_log_message_t* message, uint8_t *buffer, size_t len, bool* hasmore, canlogconnection* clc=NULL);
+
+  protected:
+    void AppendSync(std::string& result, const struct timeval* time);
+    int Decode(CAN_log_message_t* message, const uint8_t* buf, size_t len);
+
+  protected:
+    // Encoder state:
+    std::map<uint64_t, uint32_t> m_encdict[CANFORMAT_OVBIN_BUSES];
+    int64_t             m_enctime;
+    uint32_t            m_encrecords;         // Records since last sync
+    uint32_t            m_enctotal;           // Records since stream start
+    uint32_t            m_encbytes;           // Bytes since last sync
+    bool                m_encsync;            // Sync block needed
+
+    // Decoder state:
+    std::vector<uint64_t> m_decdict[CANFORMAT_OVBIN_BUSES];
+    int64_t             m_dectime;
+    bool                m_decsynced;
+    uint8_t             m_rec[CANFORMAT_OVBIN_MAXRECORD];
+  };
+
+#endif // __CANFORMAT_OVBIN_H__
@@ -35,6 +35,7 @@ static const char *TAG = "canlog";
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <esp_timer.h>
 #include "ovms_utils.h"
 #include "ovms_config.h"
 #include "ovms_command.h"
@@ -208,6 +209,10 @@ canlogconnection::canlogconnection(canlog* logger, std::string format, canformat
   m_dropcount = 0;
   m_discardcount = 0;
   m_filtercount = 0;
+  m_outcount = 0;
+  m_ratetime = 0;
+  m_ratecount = 0;
+  m_rate = 0;
   }
 
 canlogconnection::~canlogconnection()
@@ -234,26 +239,81 @@ void canlogconnection::OutputMsg(CAN_log_message_t& msg, std::string &result)
     return;
     }
 
+  if (m_nc == NULL)
+    {
+    m_dropcount++;
+    return;
+    }
+
 #ifdef CONFIG_OVMS_SC_GPL_MONGOOSE
-  // The standard base implemention here is for mongoose network connections
-  if (m_nc != NULL)
+  if (m_nc->flags & MG_F_UDP)
     {
+    // Keep one datagram per message:
     if (result.length()>0)
       {
       if (m_nc->send_mbuf.len < 32768)
-        {
         mg_send(m_nc, (const char*)result.c_str(), result.length());
-        }
       else
-        {
         m_dropcount++;
-        }
       }
+    return;
     }
-  else
 #endif // CONFIG_OVMS_SC_GPL_MONGOOSE
+
+  // Collect for Flush() at the end of the batch:
+  if (result.length()>0)
     {
-    m_dropcount++;
+    m_outbuf.append(result);
+    m_outcount++;
+    if (m_outbuf.size() >= CANLOG_CONN_BUFSIZE)
+      Flush(false);
+    }
+  }
+
+/**
+ * Flush: send out buffered messages
+ *  - called by the logger task with m_cmmutex held after each batch
+ *    (force=false) and when idle (force=true)
+ */
+void canlogconnection::Flush(bool force)
+  {
+  if (!m_outbuf.empty())
+    {
+#ifdef CONFIG_OVMS_SC_GPL_MONGOOSE
+    // The standard base implemention here is for mongoose network connections
+    if ((m_nc != NULL)&&(m_nc->send_mbuf.len < 32768))
+      {
+      mg_send(m_nc, m_outbuf.data(), m_outbuf.size());
+      }
+    else
+#endif // CONFIG_OVMS_SC_GPL_MONGOOSE
+      {
+      m_dropcount += m_outcount;
+      }
+    m_outbuf.clear();
+    m_outcount = 0;
+    }
+
+  UpdateRate();
+  }
+
+/**
+ * UpdateRate: measure sustained output throughput in messages per second
+ */
+void canlogconnection::UpdateRate()
+  {
+  int64_t now = esp_timer_get_time();
+  uint32_t count = m_msgcount - m_filtercount - m_dropcount - m_discardcount - m_outcount;
+  if (m_ratetime == 0)
+    {
+    m_ratetime = now;
+    m_ratecount = count;
+    }
+  else if (now - m_ratetime >= CANLOG_RATE_INTERVAL_US)
+    {
+    m_rate = (float)(count - m_ratecount) * 1000000 / (now - m_ratetime);
+    m_ratetime = now;
+    m_ratecount = count;
     }
   }
 
@@ -327,7 +387,8 @@ std::string canlogconnection::GetStats()
     << " Discarded:" << m_discardcount
     << " Dropped:" << m_dropcount
     << " Filtered:" << m_filtercount
-    << " Rate:" << std::fixed << std::setprecision(1) << droprate << "%";
+    << " Rate:" << std::fixed << std::setprecision(1) << droprate << "%"
+    << " Throughput:" << m_rate << "/s";
 
   return buf.str();
   }
@@ -347,6 +408,9 @@ canlog::canlog(const char* type, std::string format, canformat::canformat_serve_
   m_formatter->SetServeMode(mode);
   m_filter = NULL;
   m_isopen = false;
+  m_reader = NULL;
+  m_ringpending = false;
+  m_ringoverflows = 0;
 
   m_msgcount = 0;
   m_dropcount = 0;
@@ -359,6 +423,8 @@ canlog::canlog(const char* type, std::string format, canformat::canformat_serve_
   MyEvents.RegisterEvent(IDTAG,"config.changed", std::bind(&canlog::UpdatedConfig, this, _1, _2));
   MyMetrics.RegisterListener(IDTAG, "*", std::bind(&canlog::MetricListener, this, _1));
 
+  // Frames are read from the shared CAN frame ring (CONFIG_OVMS_HW_CAN_RING_SIZE),
+  // log.queuesize only sizes the queue for status, info, event & metric messages:
   int queuesize = MyConfig.GetParamValueInt(CAN_PARAM, "log.queuesize",100);
   LoadConfig();
   m_queue = xQueueCreate(queuesize, sizeof(CAN_log_message_t));
@@ -370,6 +436,8 @@ canlog::~canlog()
   MyEvents.DeregisterEvent(IDTAG);
   MyMetrics.DeregisterListener(IDTAG);
 
+  MyCan.m_ring.DetachReader(m_reader);
+
   if (m_task)
     {
     TaskHandle_t t = m_task;
@@ -378,6 +446,12 @@ canlog::~canlog()
     vTaskDelete(t);
     }
 
+  if (m_reader)
+    {
+    MyCan.m_ring.RemoveReader(m_reader);
+    m_reader = NULL;
+    }
+
   if (m_queue)
     {
     QueueHandle_t q = m_queue;
@@ -420,22 +494,95 @@ void canlog::RxTask(void *context)
   CAN_log_message_t msg;
   while (1)
     {
-    if (xQueueReceive(me->m_queue, &msg, (portTickType)portMAX_DELAY) == pdTRUE)
+    if (me->ReadMsg(msg, pdMS_TO_TICKS(CANLOG_FLUSH_INTERVAL_MS)))
       {
-      switch (msg.type)
+      // Process a batch of messages with one lock & flush:
+      OvmsRecMutexLock lock(&me->m_cmmutex);
+      int cnt = 0;
+      do
         {
-        case CAN_LogInfo_Comment:
-        case CAN_LogInfo_Config:
-        case CAN_LogInfo_Event:
-        case CAN_LogInfo_Metric:
-          me->OutputMsg(msg);
-          free(msg.text);
-          break;
-        default:
-          me->OutputMsg(msg);
-          break;
+        me->OutputMsg(msg);
+        switch (msg.type)
+          {
+          case CAN_LogInfo_Comment:
+          case CAN_LogInfo_Config:
+          case CAN_LogInfo_Event:
+          case CAN_LogInfo_Metric:
+            free(msg.text);
+            break;
+          default:
+            break;
+          }
+        } while (++cnt < CANLOG_BATCH_SIZE && me->ReadMsg(msg, 0));
+      me->FlushConnections(false);
+      }
+    else
+      {
+      OvmsRecMutexLock lock(&me->m_cmmutex);
+      me->FlushConnections(true);
+      }
+    }
+  }
+
+/**
+ * ReadMsg: get the next message to log
+ *  - frames are read from the CAN ring, status & info messages from the
+ *    logger queue, both are merged in timestamp order
+ *  - frames are filtered here, ring overflows are accounted as drops
+ *  Returns false on timeout.
+ */
+bool canlog::ReadMsg(CAN_log_message_t& msg, TickType_t wait)
+  {
+  CAN_log_message_t qmsg;
+  while (1)
+    {
+    while (!m_ringpending && m_reader &&
+           m_reader->Read(&m_ringmsg.frame, 0, &m_ringmsg.type, &m_ringmsg.timestamp))
+      {
+      if (!m_isopen)
+        continue;
+      if (m_filter && !m_filter->IsFiltered(&m_ringmsg.frame))
+        {
+        m_filtercount++;
+        continue;
         }
+      m_msgcount++;
+      m_ringpending = true;
       }
+    if (m_reader && m_reader->m_overflows != m_ringoverflows)
+      {
+      uint32_t lost = m_reader->m_overflows - m_ringoverflows;
+      m_ringoverflows += lost;
+      m_msgcount += lost;
+      m_dropcount += lost;
+      }
+
+    if (xQueuePeek(m_queue, &qmsg, 0) == pdTRUE &&
+        (!m_ringpending || !timercmp(&m_ringmsg.timestamp, &qmsg.timestamp, <)))
+      {
+      xQueueReceive(m_queue, &msg, 0);
+      return true;
+      }
+    if (m_ringpending)
+      {
+      msg = m_ringmsg;
+      m_ringpending = false;
+      return true;
+      }
+
+    if (wait == 0)
+      return false;
+    if (m_reader)
+      {
+      m_reader->PrepareWait();
+      if (m_reader->Available() > 0)
+        continue;
+      }
+    if (uxQueueMessagesWaiting(m_queue) > 0)
+      continue;
+    if (ulTaskNotifyTake(pdTRUE, wait) == 0)
+      return false;
+    wait = 0;
     }
   }
 
@@ -528,10 +675,11 @@ void canlog::OutputMsg(CAN_log_message_t& msg)
     return;
     }
 
-  std::string result = m_formatter->get(&msg);
-  if (result.length()>0)
+  // Note: called by the logger task with m_cmmutex held
+  m_fmtbuf.clear();
+  m_formatter->append(&msg, m_fmtbuf);
+  if (m_fmtbuf.length()>0)
     {
-    OvmsRecMutexLock lock(&m_cmmutex);
     for (conn_map_t::iterator it=m_connmap.begin(); it!=m_connmap.end(); ++it)
       {
       if (it->second->m_ispaused)
@@ -541,12 +689,20 @@ void canlog::OutputMsg(CAN_log_message_t& msg)
         }
       else
         {
-        it->second->OutputMsg(msg, result);
+        it->second->OutputMsg(msg, m_fmtbuf);
         }
       }
     }
   }
 
+void canlog::FlushConnections(bool force)
+  {
+  for (conn_map_t::iterator it=m_connmap.begin(); it!=m_connmap.end(); ++it)
+    {
+    it->second->Flush(force);
+    }
+  }
+
 std::string canlog::GetInfo()
   {
   std::ostringstream buf;
@@ -612,26 +768,6 @@ void canlog::ClearFilter()
     }
   }
 
-void canlog::LogFrame(canbus* bus, CAN_log_type_t type, const CAN_frame_t* frame)
-  {
-  if (!IsOpen() || !bus || !frame) return;
-
-  if (((m_filter == NULL)||(m_filter->IsFiltered(frame)))&&(m_queue))
-    {
-    CAN_log_message_t msg;
-    msg.type = type;
-    gettimeofday(&msg.timestamp,NULL);
-    memcpy(&msg.frame,frame,sizeof(CAN_frame_t));
-    msg.frame.origin = bus;
-    m_msgcount++;
-    if (xQueueSend(m_queue, &msg, 0) != pdTRUE) m_dropcount++;
-    }
-  else
-    {
-    m_filtercount++;
-    }
-  }
-
 void canlog::LogStatus(canbus* bus, CAN_log_type_t type, const CAN_status_t* status)
   {
   if (!IsOpen() || !bus) return;
@@ -644,7 +780,10 @@ void canlog::LogStatus(canbus* bus, CAN_log_type_t type, const CAN_status_t* sta
     msg.origin = bus;
     memcpy(&msg.status,status,sizeof(CAN_status_t));
     m_msgcount++;
-    if (xQueueSend(m_queue, &msg, 0) != pdTRUE) m_dropcount++;
+    if (xQueueSend(m_queue, &msg, 0) != pdTRUE)
+      m_dropcount++;
+    else if (m_task)
+      xTaskNotifyGive(m_task);
     }
   else
     {
@@ -669,6 +808,10 @@ void canlog::LogInfo(canbus* bus, CAN_log_type_t type, const char* text)
       m_dropcount++;
       free(msg.text);
       }
+    else if (m_task)
+      {
+      xTaskNotifyGive(m_task);
+      }
     }
   else
     {
@@ -37,6 +37,11 @@
 #include "ovms_metrics.h"
 #include "id_filter.h"
 
+#define CANLOG_BATCH_SIZE           32      // Max messages processed per lock & flush
+#define CANLOG_FLUSH_INTERVAL_MS    1000    // Max time buffered output is held back
+#define CANLOG_CONN_BUFSIZE         2048    // Output buffer flush threshold (network)
+#define CANLOG_RATE_INTERVAL_US     10000000 // Throughput measurement interval
+
 /**
  * canlog is the general interface and base implementation for all can loggers.
  *  It provides standard methods to open files and configure message filters
@@ -48,7 +53,9 @@
  *
  * Log messages are sent to a canlog through a queue handled by a separate
  *  task for the logger, so logging doesn't affect CAN framework speed and
- *  a log can be written/streamed to a slow medium.
+ *  a log can be written/streamed to a slow medium. The task processes the
+ *  queue in batches: connections collect the formatted messages in their
+ *  output buffer, which is flushed once per batch (or less often for files).
  *
  * Log entries can be frames, status or info messages (see CAN_LogEntry_t).
  * The timestamp of the original event is preserved.
@@ -67,6 +74,10 @@ class canlogconnection: public InternalRamAllocated
 
   public:
     virtual void OutputMsg(CAN_log_message_t& msg, std::string &result);
+    virtual void Flush(bool force);
+
+  protected:
+    void UpdateRate();
 
   public:
     virtual void TransmitCallback(uint8_t *buffer, size_t len);
@@ -95,6 +106,13 @@ class canlogconnection: public InternalRamAllocated
     uint32_t       m_dropcount;
     uint32_t       m_discardcount;
     uint32_t       m_filtercount;
+
+  protected:
+    std::string    m_outbuf;          // Formatted messages pending output
+    uint32_t       m_outcount;        // Messages in m_outbuf
+    int64_t        m_ratetime;        // Throughput interval start
+    uint32_t       m_ratecount;       // Messages output at interval start
+    float          m_rate;            // Messages/second in last interval
   };
 
 class canlog : public InternalRamAllocated
@@ -120,14 +138,14 @@ class canlog : public InternalRamAllocated
     virtual bool IsOpen();
     virtual std::string GetInfo();
     virtual void OutputMsg(CAN_log_message_t& msg);
+    virtual void FlushConnections(bool force);
 
   public:
     virtual void SetFilter(canfilter* filter);
     virtual void ClearFilter();
 
   public:
-    // Logging API:
-    virtual void LogFrame(canbus* bus, CAN_log_type_t type, const CAN_frame_t* p_frame);
+    // Logging API (frames are read from the MyCan ring):
     virtual void LogStatus(canbus* bus, CAN_log_type_t type, const CAN_status_t* status);
     virtual void LogInfo(canbus* bus, CAN_log_type_t type, const char* text);
 
@@ -149,12 +167,22 @@ class canlog : public InternalRamAllocated
 
   public:
     TaskHandle_t        m_task;
-    QueueHandle_t       m_queue;
+    QueueHandle_t       m_queue;          // Status & info messages
+    canring_reader*     m_reader;         // Frames
     bool                m_isopen;
     uint32_t            m_msgcount;
     uint32_t            m_dropcount;
     uint32_t            m_filtercount;
 
+  protected:
+    std::string         m_fmtbuf;         // Reused message formatting buffer
+    CAN_log_message_t   m_ringmsg;        // Next frame from the ring
+    bool                m_ringpending;    // m_ringmsg is valid
+    uint32_t            m_ringoverflows;  // Ring overflows accounted as drops
+
+  protected:
+    bool ReadMsg(CAN_log_message_t& msg, TickType_t wait);
+
   protected:
     virtual void UpdatedConfig(std::string event, void* data);
     virtual void LoadConfig();
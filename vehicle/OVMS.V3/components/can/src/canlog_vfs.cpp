@@ -30,20 +30,78 @@ static const char *TAG = "canlog-vfs";
 #include "can.h"
 #include "canformat.h"
 #include "canlog_vfs.h"
+#include <esp_timer.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <time.h>
 #include "ovms_utils.h"
 #include "ovms_config.h"
 #include "ovms_peripherals.h"
+#include "ovms_malloc.h"
+#ifdef CONFIG_OVMS_SC_ZIP
+#include "zlib.h"
+#endif // #ifdef CONFIG_OVMS_SC_ZIP
 
 void can_log_vfs_start(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
   {
   std::string format(cmd->GetName());
-  canlog_vfs* logger = new canlog_vfs(argv[0],format);
+  const char* path = NULL;
+  std::vector<const char*> filterv;
+  size_t maxsize = 0;
+  uint32_t maxtime = 0, keep = 0;
+  bool compress = false;
+
+  // parse args: [-s<size_kb>] [-t<minutes>] [-k<count>] [-z] <path> [filter1] ... [filterN]
+  for (int i = 0; i < argc; i++)
+    {
+    if (argv[i][0] == '-')
+      {
+      switch (argv[i][1])
+        {
+        case 's':
+          maxsize = atoi(argv[i]+2) * 1024;
+          break;
+        case 't':
+          maxtime = atoi(argv[i]+2) * 60;
+          break;
+        case 'k':
+          keep = atoi(argv[i]+2);
+          break;
+        case 'z':
+#ifdef CONFIG_OVMS_SC_ZIP
+          compress = true;
+          break;
+#else
+          writer->puts("ERROR: compression not available in this build");
+          return;
+#endif // #ifdef CONFIG_OVMS_SC_ZIP
+        default:
+          writer->printf("ERROR: unknown option '%s'\n", argv[i]);
+          return;
+        }
+      }
+    else if (!path)
+      path = argv[i];
+    else
+      filterv.push_back(argv[i]);
+    }
+  if (!path)
+    {
+    writer->puts("ERROR: missing path");
+    return;
+    }
+
+  canlog_vfs* logger = new canlog_vfs(path,format);
+  logger->m_maxsize = maxsize;
+  logger->m_maxtime = maxtime;
+  logger->m_keep = keep;
+  logger->m_compress = compress;
   logger->Open();
 
   if (logger->IsOpen())
     {
-    if (argc>1)
-      { MyCan.AddLogger(logger, argc-1, &argv[1]); }
+    if (filterv.size()>0)
+      { MyCan.AddLogger(logger, filterv.size(), filterv.data()); }
     else
       { MyCan.AddLogger(logger); }
     writer->printf("CAN logging to VFS active: %s\n", logger->GetInfo().c_str());
@@ -78,10 +136,14 @@ OvmsCanLogVFSInit::OvmsCanLogVFSInit()
         OvmsCommand* start = cmd_can_log_start->RegisterCommand("vfs", "CAN logging to VFS");
         MyCanFormatFactory.RegisterCommandSet(start, "Start CAN logging to VFS",
           can_log_vfs_start,
-          "<path> [filter1] ... [filterN]\n"
+          "[-s<size_kb>] [-t<minutes>] [-k<count>] [-z] <path> [filter1] ... [filterN]\n"
           "Filter: <bus> | <id>[-<id>] | <bus>:<id>[-<id>]\n"
-          "Example: 2:2a0-37f",
-          1, 9);
+          "-s / -t: archive file after reaching <size_kb> / running <minutes>\n"
+          "-k: keep <count> archived files (default: all)\n"
+          "-z: gzip archived files in the background\n"
+          "Archived files are named <path>.YYYYMMDD-HHMMSS[.gz]\n"
+          "Example: -s10240 -k5 -z /sd/can.crtd 2:2a0-37f",
+          1, 13);
         }
       }
     }
@@ -92,12 +154,16 @@ canlog_vfs_conn::canlog_vfs_conn(canlog* logger, std::string format, canformat::
   : canlogconnection(logger, format, mode), m_file_size(0)
   {
   m_file = NULL;
+  m_flushtime = 0;
+  m_closing = false;
   }
 
 canlog_vfs_conn::~canlog_vfs_conn()
   {
   if (m_file)
     {
+    m_closing = true;
+    Flush(true);
     fclose(m_file);
     m_file = NULL;
     }
@@ -115,9 +181,78 @@ void canlog_vfs_conn::OutputMsg(CAN_log_message_t& msg, std::string &result)
 
   if (result.length()>0)
     {
-    fwrite(result.c_str(),result.length(),1,m_file);
-    m_file_size += result.length();
+    m_outbuf.append(result);
+    m_outcount++;
+    if (m_outbuf.size() >= CANLOG_VFS_BUFSIZE)
+      Flush(false);
+    }
+  }
+
+/**
+ * Flush: write buffered messages to the file
+ *  - normally only whole blocks aligned to the file position are written,
+ *    the remainder is kept for the next flush
+ *  - all data is written & flushed when forced (idle/close) or after
+ *    CANLOG_FLUSH_INTERVAL_MS
+ *  - the file is cycled after the write if the logger's size or time
+ *    limit has been reached
+ */
+void canlog_vfs_conn::Flush(bool force)
+  {
+  canlog_vfs* logger = static_cast<canlog_vfs*>(m_logger);
+  int64_t now = esp_timer_get_time();
+  if (m_flushtime == 0)
+    m_flushtime = now;
+  if (now - m_flushtime >= CANLOG_FLUSH_INTERVAL_MS * 1000)
+    force = true;
+
+  bool cycle = !m_closing && m_file && logger->CycleDue(m_file_size + m_outbuf.size(), now);
+  if (cycle)
+    force = true;
+
+  size_t len = m_outbuf.size();
+  if (!force)
+    {
+    size_t end = (m_file_size + len) & ~(CANLOG_VFS_BLOCKSIZE-1);
+    len = (end > m_file_size) ? end - m_file_size : 0;
+    }
+
+  if (!m_file && !m_closing)
+    logger->ReopenFile(this, now);
+
+  if (!m_file)
+    {
+    // file could not be reopened after cycling, drop until a retry succeeds:
+    m_dropcount += m_outcount;
+    m_outbuf.clear();
+    m_outcount = 0;
+    }
+  else if (len > 0)
+    {
+    if (fwrite(m_outbuf.data(), len, 1, m_file) == 1)
+      {
+      m_file_size += len;
+      }
+    else
+      {
+      ESP_LOGE(TAG, "Write error on '%s'", m_peer.c_str());
+      m_dropcount += m_outcount;
+      len = m_outbuf.size();
+      }
+    m_outbuf.erase(0, len);
+    m_outcount = 0;
+    }
+
+  if (force)
+    {
+    if (m_file) fflush(m_file);
+    m_flushtime = now;
     }
+
+  if (cycle)
+    logger->CycleFile(this);
+
+  UpdateRate();
   }
 
 
@@ -125,6 +260,14 @@ canlog_vfs::canlog_vfs(std::string path, std::string format)
   : canlog("vfs", format)
   {
   m_path = path;
+  m_maxsize = 0;
+  m_maxtime = 0;
+  m_keep = 0;
+  m_compress = false;
+  m_opentime = 0;
+  m_cyclecount = 0;
+  m_reopentime = 0;
+  m_openerrors = 0;
   using std::placeholders::_1;
   using std::placeholders::_2;
   MyEvents.RegisterEvent(IDTAG, "sd.mounted", std::bind(&canlog_vfs::MountListener, this, _1, _2));
@@ -153,6 +296,11 @@ bool canlog_vfs::Open()
       }
     m_connmap.clear();
     m_isopen = false;
+    if (IsCycling())
+      {
+      ArchiveFile();
+      ExpireFiles();
+      }
     }
 
   if (MyConfig.ProtectedPath(m_path))
@@ -172,23 +320,14 @@ bool canlog_vfs::Open()
   canlog_vfs_conn* clc = new canlog_vfs_conn(this, m_format, m_mode);
   clc->m_peer = m_path;
 
-  clc->m_file = fopen(m_path.c_str(), "w");
-  if (!clc->m_file)
+  if (!OpenFile(clc))
     {
-    ESP_LOGE(TAG, "Error: Can't write to '%s'", m_path.c_str());
     delete clc;
     return false;
     }
 
   ESP_LOGI(TAG, "Now logging CAN messages to '%s'", m_path.c_str());
 
-  std::string header = m_formatter->getheader();
-  if (header.length()>0)
-    {
-    fwrite(header.c_str(),header.length(),1,clc->m_file);
-    clc->m_file_size += header.length();
-    }
-
   m_connmap[NULL] = clc;
   m_isopen = true;
 
@@ -210,6 +349,143 @@ void canlog_vfs::Close()
     m_connmap.clear();
 
     m_isopen = false;
+
+    if (IsCycling())
+      {
+      ArchiveFile();
+      ExpireFiles();
+      }
+    }
+  }
+
+/**
+ * OpenFile: (re)create the log file at m_path & write the format header
+ */
+bool canlog_vfs::OpenFile(canlog_vfs_conn* clc)
+  {
+  clc->m_file = fopen(m_path.c_str(), "w");
+  if (!clc->m_file)
+    {
+    ESP_LOGE(TAG, "Error: Can't write to '%s'", m_path.c_str());
+    m_openerrors++;
+    m_reopentime = esp_timer_get_time();
+    return false;
+    }
+
+  clc->m_file_size = 0;
+  std::string header = m_formatter->getheader();
+  if (header.length()>0)
+    {
+    fwrite(header.c_str(),header.length(),1,clc->m_file);
+    clc->m_file_size += header.length();
+    }
+
+  m_opentime = esp_timer_get_time();
+  m_reopentime = 0;
+  return true;
+  }
+
+bool canlog_vfs::IsCycling()
+  {
+  return (m_maxsize || m_maxtime || m_compress);
+  }
+
+bool canlog_vfs::CycleDue(size_t size, int64_t now)
+  {
+  return m_isopen &&
+    ((m_maxsize && size >= m_maxsize) ||
+     (m_maxtime && now - m_opentime >= (int64_t)m_maxtime * 1000000));
+  }
+
+/**
+ * CycleFile: archive the current log file and continue logging to a new one
+ *  - called by the connection with m_cmmutex held after writing all buffered data
+ */
+bool canlog_vfs::CycleFile(canlog_vfs_conn* clc)
+  {
+  if (clc->m_file)
+    {
+    fclose(clc->m_file);
+    clc->m_file = NULL;
+    }
+  ArchiveFile();
+  ExpireFiles();
+  m_cyclecount++;
+  return OpenFile(clc);
+  }
+
+/**
+ * ReopenFile: retry opening the log file after a failed cycle
+ *  - called by the connection with m_cmmutex held on each flush while the
+ *    file is not open, attempts are limited to one per CANLOG_VFS_REOPEN_MS
+ */
+bool canlog_vfs::ReopenFile(canlog_vfs_conn* clc, int64_t now)
+  {
+  if (now - m_reopentime < CANLOG_VFS_REOPEN_MS * 1000)
+    return false;
+  if (!OpenFile(clc))
+    return false;
+  ESP_LOGI(TAG, "ReopenFile: logging to '%s' resumed", m_path.c_str());
+  return true;
+  }
+
+/**
+ * ArchiveFile: rename the (closed) log file to <path>.YYYYMMDD-HHMMSS and
+ *  queue it for compression
+ */
+void canlog_vfs::ArchiveFile()
+  {
+  char ts[20];
+  time_t tm = time(NULL);
+  struct tm timeinfo;
+  strftime(ts, sizeof(ts), ".%Y%m%d-%H%M%S", localtime_r(&tm, &timeinfo));
+  std::string archpath = m_path;
+  archpath.append(ts);
+
+  // avoid overwriting a previous archive cycled within the same second:
+  struct stat st;
+  for (int i = 1; stat(archpath.c_str(), &st) == 0 || stat((archpath + ".gz").c_str(), &st) == 0; i++)
+    {
+    archpath = m_path;
+    archpath.append(ts);
+    archpath.append(".");
+    archpath.append(std::to_string(i));
+    }
+
+  if (rename(m_path.c_str(), archpath.c_str()) != 0)
+    {
+    ESP_LOGE(TAG, "ArchiveFile: rename '%s' to '%s' failed", m_path.c_str(), archpath.c_str());
+    return;
+    }
+
+  ESP_LOGI(TAG, "ArchiveFile: log file '%s' archived as '%s'", m_path.c_str(), archpath.c_str());
+  m_archive.push_back(archpath);
+
+#ifdef CONFIG_OVMS_SC_ZIP
+  if (m_compress)
+    MyCanLogVfsCompressor.Add(archpath);
+#endif // #ifdef CONFIG_OVMS_SC_ZIP
+  }
+
+/**
+ * ExpireFiles: remove the oldest archived files exceeding the keep count
+ *  (only files archived by this logger are considered)
+ */
+void canlog_vfs::ExpireFiles()
+  {
+  if (m_keep == 0)
+    return;
+
+  while (m_archive.size() > m_keep)
+    {
+    std::string path = m_archive.front();
+    m_archive.pop_front();
+    ESP_LOGI(TAG, "ExpireFiles: removing '%s'", path.c_str());
+#ifdef CONFIG_OVMS_SC_ZIP
+    MyCanLogVfsCompressor.Remove(path);
+#else
+    unlink(path.c_str());
+#endif // #ifdef CONFIG_OVMS_SC_ZIP
     }
   }
 
@@ -251,6 +527,29 @@ std::string canlog_vfs::GetStats()
   result.append(" ");
   result.append(canlog::GetStats());
 
+  if (m_openerrors)
+    {
+    result.append(" OpenErrors:");
+    result.append(std::to_string(m_openerrors));
+    }
+  if (m_isopen && m_reopentime)
+    {
+    result.append(" File:not open, retrying");
+    }
+
+  if (IsCycling())
+    {
+    result.append(" Cycles:");
+    result.append(std::to_string(m_cyclecount));
+#ifdef CONFIG_OVMS_SC_ZIP
+    if (m_compress)
+      {
+      result.append(" ");
+      result.append(MyCanLogVfsCompressor.GetStats());
+      }
+#endif // #ifdef CONFIG_OVMS_SC_ZIP
+    }
+
   return result;
   }
 
@@ -259,6 +558,27 @@ std::string canlog_vfs::GetInfo()
   std::string result = canlog::GetInfo();
   result.append(" Path:");
   result.append(m_path);
+  if (m_maxsize)
+    {
+    result.append(" MaxSize:");
+    result.append(std::to_string(m_maxsize / 1024));
+    result.append("kB");
+    }
+  if (m_maxtime)
+    {
+    result.append(" MaxTime:");
+    result.append(std::to_string(m_maxtime / 60));
+    result.append("min");
+    }
+  if (m_keep)
+    {
+    result.append(" Keep:");
+    result.append(std::to_string(m_keep));
+    }
+  if (m_compress)
+    {
+    result.append(" Compress:gzip");
+    }
   return result;
   }
 
@@ -269,3 +589,191 @@ void canlog_vfs::MountListener(std::string event, void* data)
   else if (event == "sd.mounted" && startsWith(m_path, "/sd"))
     Open();
   }
+
+
+#ifdef CONFIG_OVMS_SC_ZIP
+
+canlog_vfs_compressor MyCanLogVfsCompressor __attribute__ ((init_priority (4561)));
+
+canlog_vfs_compressor::canlog_vfs_compressor()
+  {
+  m_task = NULL;
+  m_cancel = false;
+  m_filecount = 0;
+  m_bytesin = 0;
+  m_bytesout = 0;
+  }
+
+/**
+ * Add: queue an archived log file for compression
+ *  - the compressor task is started on first use and kept running
+ */
+void canlog_vfs_compressor::Add(std::string path)
+  {
+  OvmsMutexLock lock(&m_mutex);
+  m_queue.push_back(path);
+  if (!m_task)
+    xTaskCreatePinnedToCore(CompressTask, "OVMS CanLogZip", 4096, (void*)this, 1, &m_task, CORE(1));
+  else
+    xTaskNotifyGive(m_task);
+  }
+
+/**
+ * Remove: delete an archived log file (plain & compressed version)
+ *  - if the file is currently being compressed, the task is told to
+ *    cancel and delete both files itself
+ */
+void canlog_vfs_compressor::Remove(std::string path)
+  {
+  OvmsMutexLock lock(&m_mutex);
+  if (path == m_current)
+    {
+    m_cancel = true;
+    return;
+    }
+  for (auto it = m_queue.begin(); it != m_queue.end(); ++it)
+    {
+    if (*it == path)
+      {
+      m_queue.erase(it);
+      break;
+      }
+    }
+  unlink(path.c_str());
+  unlink((path + ".gz").c_str());
+  }
+
+std::string canlog_vfs_compressor::GetStats()
+  {
+  OvmsMutexLock lock(&m_mutex);
+  char buf[80];
+  snprintf(buf, sizeof(buf), "Zipped:%" PRIu32 " Ratio:%.0f%% Queued:%u",
+    m_filecount,
+    m_bytesin ? (float) m_bytesout * 100 / m_bytesin : 0.0f,
+    (unsigned) (m_queue.size() + (m_current.empty() ? 0 : 1)));
+  return std::string(buf);
+  }
+
+void canlog_vfs_compressor::CompressTask(void *pvParameters)
+  {
+  canlog_vfs_compressor* me = (canlog_vfs_compressor*)pvParameters;
+  while (1)
+    {
+    me->CompressQueue();
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+  }
+
+void canlog_vfs_compressor::CompressQueue()
+  {
+  std::string path;
+  while (1)
+    {
+      {
+      OvmsMutexLock lock(&m_mutex);
+      m_current.clear();
+      if (m_queue.empty())
+        return;
+      path = m_current = m_queue.front();
+      m_queue.pop_front();
+      m_cancel = false;
+      }
+    Compress(path);
+    }
+  }
+
+/**
+ * Compress: stream a file through deflate into <path>.gz, remove the
+ *  source file on success
+ *  - window & hash memory are reduced from the zlib defaults to keep the
+ *    heap footprint of the compressor at ~40 KB (defaults: ~260 KB)
+ */
+bool canlog_vfs_compressor::Compress(const std::string& path)
+  {
+  std::string outpath = path + ".gz";
+  FILE* in = fopen(path.c_str(), "r");
+  if (!in)
+    {
+    ESP_LOGW(TAG, "Compress: can't open '%s'", path.c_str());
+    return false;
+    }
+  FILE* out = fopen(outpath.c_str(), "w");
+  if (!out)
+    {
+    ESP_LOGE(TAG, "Compress: can't write to '%s'", outpath.c_str());
+    fclose(in);
+    return false;
+    }
+
+  uint8_t* inbuf = (uint8_t*) ExternalRamMalloc(CANLOG_VFS_ZIP_BUFSIZE);
+  uint8_t* outbuf = (uint8_t*) ExternalRamMalloc(CANLOG_VFS_ZIP_BUFSIZE);
+  z_stream zs;
+  memset(&zs, 0, sizeof(zs));
+  bool init = (inbuf && outbuf &&
+    deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + CANLOG_VFS_ZIP_WINDOWBITS,
+      CANLOG_VFS_ZIP_MEMLEVEL, Z_DEFAULT_STRATEGY) == Z_OK);
+  bool ok = init;
+  size_t insize = 0, outsize = 0;
+  int flush = Z_NO_FLUSH;
+
+  while (ok && flush != Z_FINISH && !m_cancel)
+    {
+    zs.avail_in = fread(inbuf, 1, CANLOG_VFS_ZIP_BUFSIZE, in);
+    if (ferror(in))
+      {
+      ok = false;
+      break;
+      }
+    insize += zs.avail_in;
+    flush = feof(in) ? Z_FINISH : Z_NO_FLUSH;
+    zs.next_in = inbuf;
+    do
+      {
+      zs.avail_out = CANLOG_VFS_ZIP_BUFSIZE;
+      zs.next_out = outbuf;
+      if (deflate(&zs, flush) == Z_STREAM_ERROR)
+        {
+        ok = false;
+        break;
+        }
+      size_t have = CANLOG_VFS_ZIP_BUFSIZE - zs.avail_out;
+      if (have > 0 && fwrite(outbuf, 1, have, out) != have)
+        {
+        ok = false;
+        break;
+        }
+      outsize += have;
+      } while (zs.avail_out == 0);
+    }
+
+  if (init) deflateEnd(&zs);
+  if (inbuf) free(inbuf);
+  if (outbuf) free(outbuf);
+  fclose(in);
+  if (fclose(out) != 0)
+    ok = false;
+
+  OvmsMutexLock lock(&m_mutex);
+  if (m_cancel)
+    {
+    // file expired while being compressed:
+    unlink(outpath.c_str());
+    unlink(path.c_str());
+    return false;
+    }
+  if (!ok)
+    {
+    ESP_LOGE(TAG, "Compress: failed on '%s', keeping uncompressed file", path.c_str());
+    unlink(outpath.c_str());
+    return false;
+    }
+
+  unlink(path.c_str());
+  m_filecount++;
+  m_bytesin += insize;
+  m_bytesout += outsize;
+  ESP_LOGI(TAG, "Compress: '%s' done, %u -> %u bytes", outpath.c_str(), (unsigned) insize, (unsigned) outsize);
+  return true;
+  }
+
+#endif // #ifdef CONFIG_OVMS_SC_ZIP
@@ -28,8 +28,17 @@
 #ifndef __CANLOG_VFS_H__
 #define __CANLOG_VFS_H__
 
+#include <deque>
 #include "canlog.h"
 
+#define CANLOG_VFS_BLOCKSIZE        4096    // File write alignment
+#define CANLOG_VFS_BUFSIZE          8192    // Output buffer flush threshold
+#define CANLOG_VFS_REOPEN_MS        5000    // Retry interval after a failed file (re)open
+
+#define CANLOG_VFS_ZIP_BUFSIZE      1024    // Compressor file read/write chunk size
+#define CANLOG_VFS_ZIP_WINDOWBITS   12      // deflate window 4 KB (zlib default 32 KB)
+#define CANLOG_VFS_ZIP_MEMLEVEL     5       // deflate hash memory 16 KB (zlib default 128 KB)
+
 
 class canlog_vfs_conn: public canlogconnection
   {
@@ -39,11 +48,14 @@ class canlog_vfs_conn: public canlogconnection
 
   public:
     virtual void OutputMsg(CAN_log_message_t& msg, std::string &result);
+    virtual void Flush(bool force);
     virtual std::string GetStats();
 
   public:
     FILE*               m_file;
     size_t              m_file_size;
+    int64_t             m_flushtime;
+    bool                m_closing;
   };
 
 
@@ -63,8 +75,67 @@ class canlog_vfs : public canlog
     virtual void MountListener(std::string event, void* data);
     virtual std::string GetStats();
 
+  public:
+    bool IsCycling();
+    bool CycleDue(size_t size, int64_t now);
+    bool CycleFile(canlog_vfs_conn* clc);
+    bool ReopenFile(canlog_vfs_conn* clc, int64_t now);
+
+  protected:
+    bool OpenFile(canlog_vfs_conn* clc);
+    void ArchiveFile();
+    void ExpireFiles();
+
   public:
     std::string         m_path;
+    size_t              m_maxsize;          // Cycle file at this size [bytes], 0=off
+    uint32_t            m_maxtime;          // Cycle file after this time [seconds], 0=off
+    uint32_t            m_keep;             // Number of archived files to keep, 0=all
+    bool                m_compress;         // Compress archived files (gzip)
+
+  protected:
+    int64_t             m_opentime;
+    uint32_t            m_cyclecount;
+    int64_t             m_reopentime;       // Time of last failed (re)open, 0=none
+    uint32_t            m_openerrors;
+    std::deque<std::string> m_archive;
+  };
+
+
+#ifdef CONFIG_OVMS_SC_ZIP
+/**
+ * canlog_vfs_compressor: background gzip compression of archived log files
+ *  - shared by all VFS loggers, so files closed by a stopped logger still
+ *    get compressed
+ *  - a file is replaced by its ".gz" version after successful compression
+ */
+class canlog_vfs_compressor
+  {
+  public:
+    canlog_vfs_compressor();
+
+  public:
+    void Add(std::string path);
+    void Remove(std::string path);
+    std::string GetStats();
+
+  protected:
+    static void CompressTask(void *pvParameters);
+    void CompressQueue();
+    bool Compress(const std::string& path);
+
+  protected:
+    OvmsMutex           m_mutex;
+    TaskHandle_t        m_task;
+    std::deque<std::string> m_queue;
+    std::string         m_current;
+    volatile bool       m_cancel;
+    uint32_t            m_filecount;
+    uint64_t            m_bytesin;
+    uint64_t            m_bytesout;
   };
 
+extern canlog_vfs_compressor MyCanLogVfsCompressor;
+#endif // #ifdef CONFIG_OVMS_SC_ZIP
+
 #endif // __CANLOG_VFS_H__
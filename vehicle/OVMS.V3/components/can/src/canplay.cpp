@@ -35,6 +35,7 @@ static const char *TAG = "canplay";
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <esp_timer.h>
 #include "ovms_config.h"
 #include "ovms_command.h"
 #include "ovms_events.h"
@@ -182,7 +183,9 @@ OvmsCanPlayInit::OvmsCanPlayInit()
 
   OvmsCommand* cmd_canplay = cmd_can->RegisterCommand("play", "CAN play framework");
   cmd_canplay->RegisterCommand("stop", "Stop playing", can_play_stop,"[<id>]",0,1);
-  cmd_canplay->RegisterCommand("speed", "Set playback speed", can_play_speed,"<speed> [<id>]",1,2);
+  cmd_canplay->RegisterCommand("speed", "Set playback speed", can_play_speed,
+    "<speed> [<id>]\n"
+    "<speed>: multiple of original speed, 0 = as fast as possible",1,2);
   cmd_canplay->RegisterCommand("status", "Playing status", can_play_status,"[<id>]",0,1);
   cmd_canplay->RegisterCommand("list", "Playing list", can_play_list);
   cmd_canplay->RegisterCommand("start", "CAN play start framework");
@@ -201,17 +204,27 @@ canplay::canplay(const char* type, std::string format, canformat::canformat_serv
   m_filter = NULL;
   m_speed = 1;
 
+  m_stopping = false;
   m_msgcount = 0;
+  m_skipcount = 0;
+  m_basespeed = 0;
+  m_baselog = 0;
+  m_basereal = 0;
+  m_lastlog = 0;
+  m_playstart = 0;
+  m_playtime = 0;
+  m_burststart = 0;
+  m_jittersum = 0;
+  m_jittermax = 0;
+  m_jittercount = 0;
+
+  // Note: the task waits for Start(), as the sub-class is not constructed yet
   xTaskCreatePinnedToCore(PlayTask, "OVMS CanPlay", 4096, (void*)this, 10, &m_task, CORE(1));
   }
 
 canplay::~canplay()
   {
-  if (m_task)
-    {
-    vTaskDelete(m_task);
-    m_task = NULL;
-    }
+  Stop();
 
   if (m_formatter)
     {
@@ -226,21 +239,132 @@ canplay::~canplay()
     }
   }
 
+void canplay::Start()
+  {
+  if (m_task)
+    xTaskNotifyGive(m_task);
+  }
+
+void canplay::Stop()
+  {
+  // Note: sub-classes need to call this from their destructor, before
+  //  their virtual methods become unavailable to the player task.
+  if (m_task)
+    {
+    m_stopping = true;
+    xTaskNotifyGive(m_task);
+    for (int i = 0; m_task && i < 20; i++)
+      vTaskDelay(pdMS_TO_TICKS(50)); // give player task time to finish
+    if (m_task)
+      {
+      ESP_LOGW(TAG, "Player task did not terminate, deleting it");
+      TaskHandle_t t = m_task;
+      m_task = NULL;
+      vTaskDelete(t);
+      }
+    }
+  }
+
 void canplay::PlayTask(void *context)
   {
-//  canplay* me = (canplay*) context;
+  canplay* me = (canplay*) context;
 
-//  CAN_log_message_t msg;
-//  while (me->InputMsg(&msg))
-//    {
-//    vTaskDelay(pdMS_TO_TICKS(1000));
-//    }
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
 
-//  me->Close();
-  while(1)
+  CAN_log_message_t msg;
+  while (!me->m_stopping)
     {
-    vTaskDelay(pdMS_TO_TICKS(1000));
+    if (!me->IsOpen())
+      {
+      vTaskDelay(pdMS_TO_TICKS(CANPLAY_MAX_SLEEP_MS));
+      }
+    else if (me->InputMsg(&msg))
+      {
+      me->PlayMsg(&msg);
+      }
+    else if (!me->m_stopping)
+      {
+      // End of log:
+      if (me->m_playstart)
+        me->m_playtime = esp_timer_get_time() - me->m_playstart;
+      me->Close();
+      }
     }
+
+  me->m_task = NULL;
+  vTaskDelete(NULL);
+  }
+
+/**
+ * PlayMsg: inject a log message as an incoming frame on its original bus,
+ *  after waiting for its original timestamp (relative to the first frame)
+ *  scaled by the current speed.
+ */
+void canplay::PlayMsg(CAN_log_message_t* msg)
+  {
+  if ((msg->type != CAN_LogFrame_RX) || (msg->frame.origin == NULL) ||
+      (m_filter && !m_filter->IsFiltered(&msg->frame)))
+    {
+    m_skipcount++;
+    return;
+    }
+
+  int64_t logtime = (int64_t)msg->timestamp.tv_sec * 1000000 + msg->timestamp.tv_usec;
+  int64_t now = esp_timer_get_time();
+  if (m_playstart == 0)
+    m_playstart = m_burststart = now;
+
+  if (m_speed == 0)
+    {
+    // As fast as possible, but let lower priority tasks run regularly:
+    m_basespeed = 0;
+    if (now - m_burststart > CANPLAY_MAX_BURST_MS * 1000)
+      {
+      vTaskDelay(1);
+      m_burststart = esp_timer_get_time();
+      }
+    }
+  else
+    {
+    // Set new time base on first frame, speed change or log time going backwards
+    // (i.e. timestamp wrap or concatenated logs):
+    if (m_basespeed != m_speed || logtime < m_lastlog)
+      {
+      m_basespeed = m_speed;
+      m_baselog = logtime;
+      m_basereal = now;
+      }
+    while (true)
+      {
+      int64_t due = m_basereal + (logtime - m_baselog) / m_basespeed;
+      int64_t wait = due - esp_timer_get_time();
+      if (wait < portTICK_PERIOD_MS * 1000)
+        {
+        uint32_t jitter = (wait < 0) ? -wait : wait;
+        m_jittersum += jitter;
+        m_jittercount++;
+        if (jitter > m_jittermax) m_jittermax = jitter;
+        break;
+        }
+      vTaskDelay(pdMS_TO_TICKS(MIN(wait / 1000, CANPLAY_MAX_SLEEP_MS)));
+      if (m_stopping)
+        return;
+      if (m_speed == 0)
+        break;
+      if (m_speed != m_basespeed)
+        {
+        // Speed changed while waiting: continue from here at the new speed
+        m_basespeed = m_speed;
+        m_baselog = logtime;
+        m_basereal = esp_timer_get_time();
+        }
+      }
+    m_burststart = esp_timer_get_time();
+    }
+
+  m_lastlog = logtime;
+  MyCan.IncomingFrame(&msg->frame);
+  m_msgcount++;
   }
 
 const char* canplay::GetType()
@@ -273,7 +397,10 @@ std::string canplay::GetInfo()
     buf << "(" << m_formatter->GetServeModeName() << ")";
     }
 
-  buf << " Speed:" << m_speed << "x";
+  if (m_speed)
+    buf << " Speed:" << m_speed << "x";
+  else
+    buf << " Speed:max";
 
   if (m_filter)
     {
@@ -292,6 +419,20 @@ std::string canplay::GetStats()
   std::ostringstream buf;
 
   buf << "total messages: " << m_msgcount;
+  if (m_skipcount)
+    buf << ", skipped: " << m_skipcount;
+
+  int64_t playtime = m_playtime;
+  if (playtime == 0 && m_playstart)
+    playtime = esp_timer_get_time() - m_playstart;
+  buf << std::fixed << std::setprecision(1);
+  if (playtime > 0)
+    buf << ", rate: " << (double)m_msgcount * 1000000 / playtime << " frames/s";
+  if (m_jittercount)
+    buf << ", jitter avg: " << (double)m_jittersum / m_jittercount / 1000
+        << " ms, max: " << (double)m_jittermax / 1000 << " ms";
+  if (m_playtime)
+    buf << " (finished)";
 
   return buf.str();
   }
@@ -31,6 +31,12 @@
 #include "can.h"
 #include "canformat.h"
 
+// Playback timing: longest single sleep while waiting for a frame to become
+// due (keeps the task responsive to stop & speed changes), and the maximum
+// time to run without yielding in "as fast as possible" mode:
+#define CANPLAY_MAX_SLEEP_MS      100
+#define CANPLAY_MAX_BURST_MS      50
+
 /**
  * canplay is the general interface and base implementation for all can players.
  */
@@ -42,12 +48,14 @@ class canplay : public InternalRamAllocated
 
   public:
     static void PlayTask(void* context);
+    void Start();
+    void Stop();
 
   public:
     const char* GetType();
     const char* GetFormat();
     virtual std::string GetStats();
-    void SetSpeed(uint32_t speed);
+    void SetSpeed(uint32_t speed);   // 0 = as fast as possible
 
   public:
     // Methods expected to be implemented by sub-classes
@@ -68,9 +76,27 @@ class canplay : public InternalRamAllocated
     canformat*          m_formatter;
     canfilter*          m_filter;
 
+  protected:
+    void PlayMsg(CAN_log_message_t* msg);
+
   public:
     TaskHandle_t        m_task;
+    volatile bool       m_stopping;
     uint32_t            m_msgcount;
+    uint32_t            m_skipcount;
+
+  protected:
+    // Timing state & statistics, all times in microseconds:
+    uint32_t            m_basespeed;      // speed the time base was set for
+    int64_t             m_baselog;        // log time of time base
+    int64_t             m_basereal;       // real time of time base
+    int64_t             m_lastlog;        // log time of last frame
+    int64_t             m_playstart;      // real time of first frame
+    int64_t             m_playtime;       // total real playing time
+    int64_t             m_burststart;     // start of current burst
+    uint64_t            m_jittersum;
+    uint32_t            m_jittermax;
+    uint32_t            m_jittercount;
   };
 
 #endif // __CANPLAY_H__
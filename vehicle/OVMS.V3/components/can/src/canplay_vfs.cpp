@@ -91,6 +91,8 @@ canplay_vfs::canplay_vfs(std::string path, std::string format)
   {
   m_file = NULL;
   m_path = path;
+  m_readlen = 0;
+  m_readpos = 0;
   using std::placeholders::_1;
   using std::placeholders::_2;
   MyEvents.RegisterEvent(IDTAG, "sd.mounted", std::bind(&canplay_vfs::MountListener, this, _1, _2));
@@ -99,6 +101,7 @@ canplay_vfs::canplay_vfs(std::string path, std::string format)
 
 canplay_vfs::~canplay_vfs()
   {
+  Stop();
   MyEvents.DeregisterEvent(IDTAG);
 
   if (m_file != NULL)
@@ -109,6 +112,7 @@ canplay_vfs::~canplay_vfs()
 
 bool canplay_vfs::Open()
   {
+  OvmsMutexLock lock(&m_filemutex);
   if (m_file)
     {
     fclose(m_file);
@@ -129,12 +133,21 @@ bool canplay_vfs::Open()
     }
 #endif // #ifdef CONFIG_OVMS_COMP_SDCARD
 
+  if (m_format == "gvret-b")
+    {
+    // gvret-b input is the GVRET command protocol, not the frame log format
+    ESP_LOGE(TAG, "Error: Format '%s' not supported for playback", m_format.c_str());
+    return false;
+    }
+
   m_file = fopen(m_path.c_str(), "r");
   if (!m_file)
     {
     ESP_LOGE(TAG, "Error: Can't read from '%s'", m_path.c_str());
     return false;
     }
+  m_readlen = 0;
+  m_readpos = 0;
 
   ESP_LOGI(TAG, "Now playing CAN messages from '%s'", m_path.c_str());
 
@@ -143,6 +156,7 @@ bool canplay_vfs::Open()
 
 void canplay_vfs::Close()
   {
+  OvmsMutexLock lock(&m_filemutex);
   if (m_file)
     {
     fclose(m_file);
@@ -175,8 +189,24 @@ void canplay_vfs::MountListener(std::string event, void* data)
 
 bool canplay_vfs::InputMsg(CAN_log_message_t* msg)
   {
+  OvmsMutexLock lock(&m_filemutex);
   if (m_file == NULL) return false;
   if (m_formatter == NULL) return false;
 
-  return false;
+  while (true)
+    {
+    memset(msg, 0, sizeof(*msg));
+    bool hasmore = false;
+    m_readpos += m_formatter->put(msg, m_readbuf + m_readpos, m_readlen - m_readpos, &hasmore);
+    if (msg->frame.origin != NULL)
+      return true;
+    if (hasmore || m_readpos < m_readlen)
+      continue;
+
+    // Formatter needs more input:
+    m_readpos = 0;
+    m_readlen = fread(m_readbuf, 1, sizeof(m_readbuf), m_file);
+    if (m_readlen == 0)
+      return false; // EOF or read error
+    }
   }
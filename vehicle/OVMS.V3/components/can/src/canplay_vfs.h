@@ -29,6 +29,9 @@
 #define __CANPLAY_VFS_H__
 
 #include "canplay.h"
+#include "ovms_mutex.h"
+
+#define CANPLAY_VFS_READSIZE      256
 
 class canplay_vfs : public canplay
   {
@@ -51,6 +54,10 @@ class canplay_vfs : public canplay
   public:
     std::string         m_path;
     FILE*               m_file;
+    OvmsMutex           m_filemutex;
+    uint8_t             m_readbuf[CANPLAY_VFS_READSIZE];
+    size_t              m_readlen;
+    size_t              m_readpos;
   };
 
 #endif // __CANPLAY_VFS_H__
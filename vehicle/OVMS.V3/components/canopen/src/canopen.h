@@ -390,6 +390,9 @@ class CANopen final
     CANopenWorker* GetWorker(canbus* bus);
     void StatusReport(int verbosity, OvmsWriter* writer);
 
+  private:
+    void UpdateListener();
+
   public:
     static const std::string GetJobName(const CANopenJob_t jobtype);
     static const std::string GetJobName(const CANopenJob& job);
@@ -37,12 +37,14 @@ static const char *TAG = "dbc";
 #include <sstream>
 #include <string.h>
 #include <stdlib.h>
+#include <unistd.h>
 #include <math.h>
 #include "dbc.h"
 #include "dbc_tokeniser.hpp"
 #include "dbc_parser.hpp"
 #ifdef CONFIG_OVMS
 #include "ovms_config.h"
+#include "ovms_malloc.h"
 #endif // #ifdef CONFIG_OVMS
 
 // N.B. The conditions on CONFIG_OVMS are to allow this module to be
@@ -105,6 +107,53 @@ dbc_extract_bits_big_endian(uint8_t *candata, unsigned int bpos, unsigned int bi
   return val;
   }
 
+static inline void
+dbc_insert_bits(uint8_t *candata, unsigned int bpos, unsigned int align, unsigned int shifter, uint64_t val)
+  {
+  uint8_t mask = ((1 << shifter) - 1) << align;
+  candata[bpos/8] = (candata[bpos/8] & ~mask) | ((val << align) & mask);
+  }
+
+static void
+dbc_insert_bits_little_endian(uint8_t *candata, unsigned int bpos, unsigned int bits, uint64_t val)
+  {
+  unsigned int pos, aligner, shifter;
+
+  pos = 0;
+  while (bits > 0 && bpos < 64)
+    {
+    aligner = bpos % 8;
+    shifter = 8 - aligner;
+    shifter = MIN(shifter, bits);
+
+    dbc_insert_bits(candata, bpos, aligner, shifter, val >> pos);
+    pos += shifter;
+
+    bpos += shifter;
+    bits -= shifter;
+    }
+  }
+
+static void
+dbc_insert_bits_big_endian(uint8_t *candata, unsigned int bpos, unsigned int bits, uint64_t val)
+  {
+  unsigned int pos, aligner, slicer;
+
+  pos = bits;
+  while (bits > 0 && bpos < 64)
+    {
+    slicer = (bpos % 8) + 1;
+    slicer = MIN(slicer, bits);
+    aligner = ((bpos % 8) + 1) - slicer;
+
+    pos -= slicer;
+    dbc_insert_bits(candata, bpos, aligner, slicer, val >> pos);
+
+    bpos = ((bpos / 8) + 1) * 8 + 7;
+    bits -= slicer;
+    }
+  }
+
 uint32_t dbcMessageIdFromString(const char* id)
   {
   uint32_t msgid = 0;
@@ -580,6 +629,7 @@ dbcSignal::dbcSignal()
   {
   m_start_bit = 0;
   m_signal_size = 0;
+  m_ext_value_type = DBC_EXTVALUETYPE_INTEGER;
   m_metric = NULL;
   }
 
@@ -587,6 +637,7 @@ dbcSignal::dbcSignal(std::string name)
   {
   m_start_bit = 0;
   m_signal_size = 0;
+  m_ext_value_type = DBC_EXTVALUETYPE_INTEGER;
   m_name = name;
   m_metric = MyMetrics.Find(name.c_str());
   }
@@ -738,6 +789,11 @@ dbcValueType_t dbcSignal::GetValueType()
   return m_value_type;
   }
 
+dbcExtValueType_t dbcSignal::GetExtValueType()
+  {
+  return m_ext_value_type;
+  }
+
 dbcNumber dbcSignal::GetFactor()
   {
   return m_factor;
@@ -774,6 +830,11 @@ void dbcSignal::SetValueType(const dbcValueType_t type)
   m_value_type = type;
   }
 
+void dbcSignal::SetExtValueType(const dbcExtValueType_t type)
+  {
+  m_ext_value_type = type;
+  }
+
 void dbcSignal::SetFactorOffset(const dbcNumber factor, const dbcNumber offset)
   {
   m_factor = factor;
@@ -815,20 +876,93 @@ void dbcSignal::SetUnit(const char* unit)
 
 void dbcSignal::Encode(dbcNumber* source, CAN_frame_t* msg)
   {
-  // TODO: An efficient encoding of the signal
+  if ((m_signal_size < 1)||(m_signal_size > 64)||(m_start_bit < 0)||(m_start_bit > 63))
+    return;
+
+  uint64_t val;
+  bool scaled = !(m_factor == (uint32_t)1) || !(m_offset == (uint32_t)0);
+
+  if (m_ext_value_type != DBC_EXTVALUETYPE_INTEGER)
+    {
+    double d = source->GetDouble();
+    if (scaled)
+      d = (d - m_offset.GetDouble()) / m_factor.GetDouble();
+    if (m_ext_value_type == DBC_EXTVALUETYPE_FLOAT)
+      {
+      float f = d;
+      uint32_t u;
+      memcpy(&u, &f, sizeof(u));
+      val = u;
+      }
+    else
+      {
+      memcpy(&val, &d, sizeof(val));
+      }
+    }
+  else if (scaled || source->IsDouble())
+    {
+    double d = source->GetDouble();
+    if (scaled)
+      d = (d - m_offset.GetDouble()) / m_factor.GetDouble();
+    val = (m_value_type == DBC_VALUETYPE_SIGNED)
+      ? (uint64_t)llround(d)
+      : ((d <= 0) ? 0 : (uint64_t)llround(d));
+    }
+  else
+    {
+    val = source->GetUnsignedInteger64();
+    }
+
+  if (m_signal_size < 64)
+    val &= ((uint64_t)1 << m_signal_size) - 1;
+
+  if (m_byte_order == DBC_BYTEORDER_BIG_ENDIAN)
+    dbc_insert_bits_big_endian(msg->data.u8,m_start_bit,m_signal_size,val);
+  else
+    dbc_insert_bits_little_endian(msg->data.u8,m_start_bit,m_signal_size,val);
   }
 
 dbcNumber dbcSignal::Decode(CAN_frame_t* msg)
   {
   uint64_t val;
-  dbcNumber result;
 
   if (m_byte_order == DBC_BYTEORDER_BIG_ENDIAN)
     val = dbc_extract_bits_big_endian(msg->data.u8,m_start_bit,m_signal_size);
   else
     val = dbc_extract_bits_little_endian(msg->data.u8,m_start_bit,m_signal_size);
 
-  if (m_value_type == DBC_VALUETYPE_UNSIGNED)
+  return DecodeValue(val);
+  }
+
+/**
+ * DecodeValue: convert the raw signal bits to the scaled signal value
+ */
+dbcNumber dbcSignal::DecodeValue(uint64_t val)
+  {
+  dbcNumber result;
+
+  if (m_ext_value_type == DBC_EXTVALUETYPE_FLOAT)
+    {
+    float f;
+    uint32_t u = (uint32_t)val;
+    memcpy(&f, &u, sizeof(f));
+    result = (double)f;
+    }
+  else if (m_ext_value_type == DBC_EXTVALUETYPE_DOUBLE)
+    {
+    double d;
+    memcpy(&d, &val, sizeof(d));
+    result = d;
+    }
+  else if (m_signal_size > 32)
+    {
+    if (m_value_type == DBC_VALUETYPE_UNSIGNED)
+      result.Cast64(val, DBC_NUMBER_INTEGER_UNSIGNED64);
+    else
+      result.Cast64(static_cast<uint64_t>(sign_extend<uint64_t, int64_t>(val, m_signal_size-1)),
+        DBC_NUMBER_INTEGER_SIGNED64);
+    }
+  else if (m_value_type == DBC_VALUETYPE_UNSIGNED)
     result.Cast((uint32_t)val, DBC_NUMBER_INTEGER_UNSIGNED);
   else {
     int32_t signed_val = sign_extend<uint32_t, int32_t>((uint32_t)val, m_signal_size-1);
@@ -935,6 +1069,18 @@ void dbcSignal::WriteFileValues(dbcOutputCallback callback,
     std::string prefix = ss.str();
     m_values.WriteFile(callback, param, prefix.c_str());
     }
+  if (m_ext_value_type != DBC_EXTVALUETYPE_INTEGER)
+    {
+    std::ostringstream ss;
+    ss << "SIG_VALTYPE_ ";
+    ss << messageid;
+    ss << " ";
+    ss << m_name;
+    ss << " : ";
+    ss << (int)m_ext_value_type;
+    ss << ";\n";
+    callback(param, ss.str().c_str());
+    }
   }
 
 ////////////////////////////////////////////////////////////////////////
@@ -1262,6 +1408,653 @@ void dbcMessageTable::WriteSummary(dbcOutputCallback callback, void* param)
     itt->second->WriteFile(callback, param);
   }
 
+////////////////////////////////////////////////////////////////////////
+// dbcDecodePlan
+
+dbcDecodePlan::dbcDecodePlan()
+  {
+  }
+
+dbcDecodePlan::~dbcDecodePlan()
+  {
+  }
+
+void dbcDecodePlan::Clear()
+  {
+  OvmsMutexLock lock(&m_mutex);
+  m_steps.clear();
+  m_messages.clear();
+  m_stdindex.clear();
+  }
+
+bool dbcDecodePlan::AddStep(dbcSignal* signal)
+  {
+  dbcDecodeStep_t step;
+  int start = signal->GetStartBit();
+  int size = signal->GetSignalSize();
+  if ((start < 0)||(start > 63)||(size < 1)||(size > 64))
+    return false;
+
+  if (signal->GetByteOrder() == DBC_BYTEORDER_LITTLE_ENDIAN)
+    {
+    if (start + size > 64) return false;
+    if ((start % 8) == 0 && size == 8)
+      { step.kind = DBC_DECODE_U8; step.shift = start / 8; }
+    else if ((start % 8) == 0 && size == 16)
+      { step.kind = DBC_DECODE_LE16; step.shift = start / 8; }
+    else
+      { step.kind = DBC_DECODE_LE; step.shift = start; }
+    }
+  else
+    {
+    // Motorola start bit is the MSB, counted LSB first within the byte:
+    int lsb = (7 - start / 8) * 8 + (start % 8) - (size - 1);
+    if (lsb < 0) return false;
+    if ((start % 8) == 7 && size == 8)
+      { step.kind = DBC_DECODE_U8; step.shift = start / 8; }
+    else if ((start % 8) == 7 && size == 16)
+      { step.kind = DBC_DECODE_BE16; step.shift = start / 8; }
+    else
+      { step.kind = DBC_DECODE_BE; step.shift = lsb; }
+    }
+
+  step.size = size;
+  step.mask = (size == 64) ? ~(uint64_t)0 : (((uint64_t)1 << size) - 1);
+  step.is_signed = (signal->GetValueType() == DBC_VALUETYPE_SIGNED);
+  step.multiplexed = signal->IsMultiplexSwitch();
+  step.switchvalue = signal->GetMultiplexSwitchvalue();
+  step.signal = signal;
+  step.metric = signal->GetMetric();
+
+  // Precompute the scaling, matching the dbcNumber arithmetic of dbcSignal::Decode():
+  dbcNumber factor = signal->GetFactor();
+  dbcNumber offset = signal->GetOffset();
+  bool scaled = !(factor == (uint32_t)1);
+  bool offsetted = !(offset == (uint32_t)0);
+  step.factor = scaled ? factor.GetDouble() : 1.0;
+  step.offset = offsetted ? offset.GetDouble() : 0.0;
+  if ((size > 32)||(signal->GetExtValueType() != DBC_EXTVALUETYPE_INTEGER))
+    step.scale = DBC_SCALE_NUMBER;
+  else if (!scaled && !offsetted)
+    step.scale = DBC_SCALE_NONE;
+  else if ((scaled && factor.IsDouble()) || (!scaled && offset.IsDouble()))
+    step.scale = DBC_SCALE_DOUBLE;
+  else
+    step.scale = DBC_SCALE_NUMBER;
+
+  m_steps.push_back(step);
+  return true;
+  }
+
+void dbcDecodePlan::Compile(dbcMessageTable* messages, bool all)
+  {
+  // Build a new plan and swap it in, the old one is freed after unlocking:
+  dbcDecodePlan plan;
+  plan.Build(messages, all);
+  OvmsMutexLock lock(&m_mutex);
+  m_steps.swap(plan.m_steps);
+  m_messages.swap(plan.m_messages);
+  m_stdindex.swap(plan.m_stdindex);
+  }
+
+void dbcDecodePlan::Build(dbcMessageTable* messages, bool all)
+  {
+  // The message table is ordered by ID with extended IDs (bit 31 set) last:
+  for (dbcMessageEntry_t::iterator it = messages->m_entrymap.begin();
+       it != messages->m_entrymap.end();
+       ++it)
+    {
+    dbcMessage* msg = it->second;
+    dbcDecodeMessage_t plan;
+    plan.id = it->first;
+    plan.first = m_steps.size();
+    plan.mux = false;
+
+    dbcSignal* mux = msg->GetMultiplexorSignal();
+    if (mux && AddStep(mux))
+      plan.mux = true;
+    else if (mux)
+      ESP_LOGW(TAG, "Multiplexor %s of message 0x%x exceeds payload, multiplexed signals not decoded",
+        mux->GetName().c_str(), (unsigned int)(it->first & 0x7FFFFFFF));
+    for (dbcSignal* sig : msg->m_signals)
+      {
+      if (sig == mux) continue;
+      if (mux && !plan.mux && sig->IsMultiplexSwitch()) continue;
+      if (!all && sig->GetMetric() == NULL) continue;
+      if (!AddStep(sig))
+        ESP_LOGW(TAG, "Signal %s of message 0x%x exceeds payload, not decoded",
+          sig->GetName().c_str(), (unsigned int)(it->first & 0x7FFFFFFF));
+      }
+
+    plan.count = m_steps.size() - plan.first;
+    bool bound = all;
+    for (int i = plan.first; i < (int)m_steps.size() && !bound; i++)
+      bound = (m_steps[i].metric != NULL);
+    if (!bound)
+      {
+      // Nothing to decode for this message:
+      m_steps.resize(plan.first);
+      continue;
+      }
+    m_messages.push_back(plan);
+    }
+
+  for (int i = 0; i < (int)m_messages.size(); i++)
+    {
+    uint32_t id = m_messages[i].id;
+    if (id & 0x80000000) break;
+    if (id >= m_stdindex.size())
+      m_stdindex.resize(id + 1, -1);
+    m_stdindex[id] = i;
+    }
+
+  m_steps.shrink_to_fit();
+  m_messages.shrink_to_fit();
+  }
+
+const dbcDecodeMessage_t* dbcDecodePlan::Find(CAN_frame_format_t format, uint32_t id)
+  {
+  if (format != CAN_frame_ext)
+    {
+    id &= 0x7FFFFFFF;
+    if (id >= m_stdindex.size() || m_stdindex[id] < 0)
+      return NULL;
+    return &m_messages[m_stdindex[id]];
+    }
+
+  id |= 0x80000000;
+  auto it = std::lower_bound(m_messages.begin(), m_messages.end(), id,
+    [](const dbcDecodeMessage_t& msg, uint32_t id) { return msg.id < id; });
+  if (it == m_messages.end() || it->id != id)
+    return NULL;
+  return &(*it);
+  }
+
+dbcNumber dbcDecodePlan::Value(const dbcDecodeStep_t& step, const uint8_t* data, uint64_t le, uint64_t be)
+  {
+  uint64_t raw;
+  switch (step.kind)
+    {
+    case DBC_DECODE_U8:
+      raw = data[step.shift];
+      break;
+    case DBC_DECODE_LE16:
+      raw = data[step.shift] | ((uint32_t)data[step.shift+1] << 8);
+      break;
+    case DBC_DECODE_BE16:
+      raw = ((uint32_t)data[step.shift] << 8) | data[step.shift+1];
+      break;
+    case DBC_DECODE_LE:
+      raw = (le >> step.shift) & step.mask;
+      break;
+    default:
+      raw = (be >> step.shift) & step.mask;
+      break;
+    }
+
+  if (step.scale == DBC_SCALE_NUMBER)
+    return step.signal->DecodeValue(raw);
+
+  uint32_t val = (uint32_t)raw;
+  if (step.is_signed && step.size < 32)
+    val = static_cast<uint32_t>(sign_extend<uint32_t, int32_t>(val, step.size-1));
+
+  dbcNumber result;
+  switch (step.scale)
+    {
+    case DBC_SCALE_NONE:
+      result.Cast(val, step.is_signed ? DBC_NUMBER_INTEGER_SIGNED : DBC_NUMBER_INTEGER_UNSIGNED);
+      break;
+    default:
+      result.Set((step.is_signed ? (double)(int32_t)val : (double)val) * step.factor + step.offset);
+      break;
+    }
+  return result;
+  }
+
+/**
+ * Decode: decode all planned signals of a frame and set their metrics
+ *  Returns the number of signals decoded, -1 if the frame is not planned.
+ *  Multiplexed signals are decoded if the multiplexor value matches.
+ */
+int dbcDecodePlan::Decode(CAN_frame_t* frame)
+  {
+  OvmsMutexLock lock(&m_mutex);
+  const dbcDecodeMessage_t* msg = Find(frame->FIR.B.FF, frame->MsgID);
+  if (!msg) return -1;
+
+  const uint8_t* data = frame->data.u8;
+  uint64_t le, be;
+  memcpy(&le, data, sizeof(le));
+  be = __builtin_bswap64(le);
+
+  const dbcDecodeStep_t* step = &m_steps[msg->first];
+  const dbcDecodeStep_t* end = step + msg->count;
+  uint32_t muxval = 0;
+  int decoded = 0;
+
+  if (msg->mux)
+    {
+    dbcNumber r = Value(*step, data, le, be);
+    muxval = r.GetSignedInteger();
+    if (step->metric) step->metric->SetValue(r);
+    step++;
+    decoded++;
+    }
+
+  for (; step < end; step++)
+    {
+    if (msg->mux && step->multiplexed && step->switchvalue != muxval)
+      continue;
+    dbcNumber r = Value(*step, data, le, be);
+    if (step->metric) step->metric->SetValue(r);
+    decoded++;
+    }
+
+  return decoded;
+  }
+
+int dbcDecodePlan::GetSignalCount()
+  {
+  OvmsMutexLock lock(&m_mutex);
+  return m_steps.size();
+  }
+
+////////////////////////////////////////////////////////////////////////
+// dbcfile binary cache
+//
+// A parsed DBC file is cached as "<path>.cache", validated by the size
+// and FNV-1a hash of the source file. The cache is read with a single
+// read and deserialized directly into the object model, skipping the
+// lexer & parser. Layout: header (magic, source size, source hash), then
+// all sections in load order using varint integers and length prefixed
+// strings, ending with an end marker.
+
+#define DBC_CACHE_MAGIC   "OVDBC\x01"
+#define DBC_CACHE_SUFFIX  ".cache"
+#define DBC_CACHE_END     0xdbcedbce
+
+class dbcCacheWriter
+  {
+  public:
+    void U8(uint8_t value)
+      {
+      m_buf.push_back((char)value);
+      }
+    void U32(uint32_t value)
+      {
+      while (value >= 0x80)
+        {
+        U8((value & 0x7f) | 0x80);
+        value >>= 7;
+        }
+      U8(value);
+      }
+    void Raw64(uint64_t value)
+      {
+      m_buf.append((const char*)&value, sizeof(value));
+      }
+    void Str(const std::string& value)
+      {
+      U32(value.size());
+      m_buf.append(value);
+      }
+    void Comments(dbcCommentTable& comments)
+      {
+      U32(comments.m_entrymap.size());
+      for (const std::string& c : comments.m_entrymap)
+        Str(c);
+      }
+    void Values(dbcValueTable& values)
+      {
+      U32(values.m_entrymap.size());
+      for (auto& it : values.m_entrymap)
+        {
+        U32(it.first);
+        Str(it.second);
+        }
+      }
+    void Number(dbcNumber value)
+      {
+      if (!value.IsDefined())
+        U8(DBC_NUMBER_NONE);
+      else if (value.IsDouble())
+        {
+        double d = value.GetDouble();
+        uint64_t raw;
+        memcpy(&raw, &d, sizeof(raw));
+        U8(DBC_NUMBER_DOUBLE);
+        Raw64(raw);
+        }
+      else if (value.IsInteger64())
+        {
+        U8(value.IsSigned() ? DBC_NUMBER_INTEGER_SIGNED64 : DBC_NUMBER_INTEGER_UNSIGNED64);
+        Raw64(value.GetUnsignedInteger64());
+        }
+      else
+        {
+        U8(value.IsSigned() ? DBC_NUMBER_INTEGER_SIGNED : DBC_NUMBER_INTEGER_UNSIGNED);
+        U32(value.GetUnsignedInteger());
+        }
+      }
+
+  public:
+    std::string m_buf;
+  };
+
+class dbcCacheReader
+  {
+  public:
+    dbcCacheReader(const uint8_t* data, size_t size)
+      {
+      m_pos = data;
+      m_end = data + size;
+      m_error = false;
+      }
+    uint8_t U8()
+      {
+      if (m_pos >= m_end) { m_error = true; return 0; }
+      return *m_pos++;
+      }
+    uint32_t U32()
+      {
+      uint32_t value = 0;
+      for (int shift = 0; shift < 35; shift += 7)
+        {
+        uint8_t b = U8();
+        value |= (uint32_t)(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) return value;
+        }
+      m_error = true;
+      return 0;
+      }
+    uint64_t Raw64()
+      {
+      uint64_t value = 0;
+      if (m_end - m_pos < (int)sizeof(value)) { m_error = true; return 0; }
+      memcpy(&value, m_pos, sizeof(value));
+      m_pos += sizeof(value);
+      return value;
+      }
+    std::string Str()
+      {
+      uint32_t len = U32();
+      if ((uint32_t)(m_end - m_pos) < len) { m_error = true; return std::string(); }
+      std::string value((const char*)m_pos, len);
+      m_pos += len;
+      return value;
+      }
+    void Comments(dbcCommentTable& comments)
+      {
+      for (uint32_t n = U32(); n > 0 && !m_error; n--)
+        comments.AddComment(Str());
+      }
+    void Values(dbcValueTable& values)
+      {
+      for (uint32_t n = U32(); n > 0 && !m_error; n--)
+        {
+        uint32_t id = U32();
+        values.AddValue(id, Str());
+        }
+      }
+    dbcNumber Number()
+      {
+      dbcNumber value;
+      uint8_t type = U8();
+      switch (type)
+        {
+        case DBC_NUMBER_INTEGER_SIGNED:
+          value.Set((int32_t)U32());
+          break;
+        case DBC_NUMBER_INTEGER_UNSIGNED:
+          value.Set((uint32_t)U32());
+          break;
+        case DBC_NUMBER_DOUBLE:
+          {
+          uint64_t raw = Raw64();
+          double d;
+          memcpy(&d, &raw, sizeof(d));
+          value = d;
+          }
+          break;
+        case DBC_NUMBER_INTEGER_SIGNED64:
+        case DBC_NUMBER_INTEGER_UNSIGNED64:
+          value.Cast64(Raw64(), (dbcNumberType_t)type);
+          break;
+        case DBC_NUMBER_NONE:
+          break;
+        default:
+          m_error = true;
+          break;
+        }
+      return value;
+      }
+
+  public:
+    const uint8_t* m_pos;
+    const uint8_t* m_end;
+    bool m_error;
+  };
+
+static bool dbc_source_hash(FILE* fd, uint32_t* size, uint32_t* hash)
+  {
+  uint8_t buf[512];
+  size_t len;
+  *size = 0;
+  *hash = 2166136261U;
+  while ((len = fread(buf, 1, sizeof(buf), fd)) > 0)
+    {
+    for (size_t i = 0; i < len; i++)
+      *hash = (*hash ^ buf[i]) * 16777619U;
+    *size += len;
+    }
+  bool ok = !ferror(fd);
+  fseek(fd, 0, SEEK_SET);
+  return ok;
+  }
+
+bool dbcfile::SaveCache(const char* path, uint32_t size, uint32_t hash)
+  {
+  dbcCacheWriter w;
+  w.m_buf.reserve(16384);
+  w.m_buf.append(DBC_CACHE_MAGIC, sizeof(DBC_CACHE_MAGIC)-1);
+  w.m_buf.append((const char*)&size, sizeof(size));
+  w.m_buf.append((const char*)&hash, sizeof(hash));
+
+  w.Str(m_version);
+  w.U32(m_newsymbols.m_entrymap.size());
+  for (const std::string& sym : m_newsymbols.m_entrymap)
+    w.Str(sym);
+  w.U32(m_bittiming.GetBaudRate());
+  w.U32(m_bittiming.GetBTR1());
+  w.U32(m_bittiming.GetBTR2());
+
+  w.U32(m_nodes.m_entrymap.size());
+  for (auto& it : m_nodes.m_entrymap)
+    {
+    w.Str(it.second->GetName());
+    w.Comments(it.second->m_comments);
+    }
+
+  w.U32(m_values.m_entrymap.size());
+  for (auto& it : m_values.m_entrymap)
+    {
+    w.Str(it.second->GetName());
+    w.Values(*it.second);
+    }
+
+  w.U32(m_messages.m_entrymap.size());
+  for (auto& it : m_messages.m_entrymap)
+    {
+    dbcMessage* msg = it.second;
+    w.U32(msg->GetID());
+    w.Str(msg->GetName());
+    w.U32(msg->GetSize());
+    w.Str(msg->GetTransmitterNode());
+    w.Comments(msg->m_comments);
+    w.U32(msg->m_signals.size());
+    for (dbcSignal* sig : msg->m_signals)
+      {
+      w.Str(sig->GetName());
+      w.U8(sig->IsMultiplexor() ? DBC_MUX_MULTIPLEXOR
+        : sig->IsMultiplexSwitch() ? DBC_MUX_MULTIPLEXED : DBC_MUX_NONE);
+      w.U32(sig->GetMultiplexSwitchvalue());
+      w.U32(sig->GetStartBit());
+      w.U32(sig->GetSignalSize());
+      w.U8(sig->GetByteOrder());
+      w.U8(sig->GetValueType());
+      w.U8(sig->GetExtValueType());
+      w.Number(sig->GetFactor());
+      w.Number(sig->GetOffset());
+      w.Number(sig->GetMinimum());
+      w.Number(sig->GetMaximum());
+      w.Str(sig->GetUnit());
+      w.U32(sig->m_receivers.size());
+      for (const std::string& r : sig->m_receivers)
+        w.Str(r);
+      w.Comments(sig->m_comments);
+      w.Values(sig->m_values);
+      }
+    }
+
+  w.Comments(m_comments);
+  w.U32(DBC_CACHE_END);
+
+  std::string cachepath(path);
+  cachepath.append(DBC_CACHE_SUFFIX);
+  FILE* fd = fopen(cachepath.c_str(), "w");
+  if (!fd)
+    {
+    ESP_LOGD(TAG,"Could not open %s for writing",cachepath.c_str());
+    return false;
+    }
+  bool ok = (fwrite(w.m_buf.data(), 1, w.m_buf.size(), fd) == w.m_buf.size());
+  ok = (fclose(fd) == 0) && ok;
+  if (!ok)
+    {
+    ESP_LOGW(TAG,"Could not write %s",cachepath.c_str());
+    unlink(cachepath.c_str());
+    }
+  return ok;
+  }
+
+bool dbcfile::LoadCache(const char* path, uint32_t size, uint32_t hash)
+  {
+  std::string cachepath(path);
+  cachepath.append(DBC_CACHE_SUFFIX);
+  FILE* fd = fopen(cachepath.c_str(), "r");
+  if (!fd) return false;
+
+  fseek(fd, 0, SEEK_END);
+  long len = ftell(fd);
+  fseek(fd, 0, SEEK_SET);
+  const size_t hdrlen = sizeof(DBC_CACHE_MAGIC)-1 + 2*sizeof(uint32_t);
+  if (len < (long)hdrlen)
+    {
+    fclose(fd);
+    return false;
+    }
+#ifdef CONFIG_OVMS
+  uint8_t* buf = (uint8_t*)ExternalRamMalloc(len);
+#else
+  uint8_t* buf = (uint8_t*)malloc(len);
+#endif // #ifdef CONFIG_OVMS
+  if (!buf)
+    {
+    fclose(fd);
+    return false;
+    }
+  bool ok = (fread(buf, 1, len, fd) == (size_t)len);
+  fclose(fd);
+
+  uint32_t csize, chash;
+  memcpy(&csize, buf + sizeof(DBC_CACHE_MAGIC)-1, sizeof(csize));
+  memcpy(&chash, buf + sizeof(DBC_CACHE_MAGIC)-1 + sizeof(csize), sizeof(chash));
+  if (!ok || memcmp(buf, DBC_CACHE_MAGIC, sizeof(DBC_CACHE_MAGIC)-1) != 0 ||
+      csize != size || chash != hash)
+    {
+    free(buf);
+    return false;
+    }
+
+  dbcCacheReader r(buf + hdrlen, len - hdrlen);
+
+  m_version = r.Str();
+  for (uint32_t n = r.U32(); n > 0 && !r.m_error; n--)
+    m_newsymbols.AddSymbol(r.Str());
+  uint32_t baud = r.U32();
+  uint32_t btr1 = r.U32();
+  uint32_t btr2 = r.U32();
+  m_bittiming.SetBaud(baud, btr1, btr2);
+
+  for (uint32_t n = r.U32(); n > 0 && !r.m_error; n--)
+    {
+    dbcNode* node = new dbcNode(r.Str());
+    r.Comments(node->m_comments);
+    m_nodes.AddNode(node);
+    }
+
+  for (uint32_t n = r.U32(); n > 0 && !r.m_error; n--)
+    {
+    std::string name = r.Str();
+    dbcValueTable* vt = new dbcValueTable(name);
+    r.Values(*vt);
+    m_values.AddValueTable(name, vt);
+    }
+
+  for (uint32_t n = r.U32(); n > 0 && !r.m_error; n--)
+    {
+    dbcMessage* msg = new dbcMessage(r.U32());
+    msg->SetName(r.Str());
+    msg->SetSize(r.U32());
+    msg->SetTransmitterNode(r.Str());
+    r.Comments(msg->m_comments);
+    m_messages.AddMessage(msg->GetID(), msg);
+    for (uint32_t ns = r.U32(); ns > 0 && !r.m_error; ns--)
+      {
+      dbcSignal* sig = new dbcSignal();
+      sig->SetName(r.Str());
+      uint8_t mux = r.U8();
+      uint32_t switchvalue = r.U32();
+      if (mux == DBC_MUX_MULTIPLEXOR)
+        msg->SetMultiplexorSignal(sig);
+      else if (mux == DBC_MUX_MULTIPLEXED)
+        sig->SetMultiplexed(switchvalue);
+      else
+        sig->ClearMultiplexed();
+      int start = r.U32();
+      int size = r.U32();
+      sig->SetStartSize(start, size);
+      sig->SetByteOrder((dbcByteOrder_t)r.U8());
+      sig->SetValueType((dbcValueType_t)r.U8());
+      sig->SetExtValueType((dbcExtValueType_t)r.U8());
+      dbcNumber factor = r.Number();
+      dbcNumber offset = r.Number();
+      sig->SetFactorOffset(factor, offset);
+      dbcNumber minimum = r.Number();
+      dbcNumber maximum = r.Number();
+      sig->SetMinMax(minimum, maximum);
+      sig->SetUnit(r.Str());
+      for (uint32_t nr = r.U32(); nr > 0 && !r.m_error; nr--)
+        sig->AddReceiver(r.Str());
+      r.Comments(sig->m_comments);
+      r.Values(sig->m_values);
+      msg->AddSignal(sig);
+      }
+    }
+
+  r.Comments(m_comments);
+  ok = (r.U32() == DBC_CACHE_END) && !r.m_error;
+  free(buf);
+
+  if (!ok)
+    {
+    ESP_LOGW(TAG,"Cache %s is corrupt, reparsing %s",cachepath.c_str(),path);
+    FreeAllocations();
+    }
+  return ok;
+  }
+
 ////////////////////////////////////////////////////////////////////////
 // dbcfile
 
@@ -1282,11 +2075,12 @@ void dbcfile::FreeAllocations()
   m_bittiming.EmptyContent();
   m_nodes.EmptyContent();
   m_values.EmptyContent();
+  m_plan.Clear();
   m_messages.EmptyContent();
   m_comments.EmptyContent();
   }
 
-bool dbcfile::LoadFile(const char* name, const char* path, FILE* fd)
+bool dbcfile::LoadFile(const char* name, const char* path, FILE* fd, bool cache)
   {
   FreeAllocations();
   m_name = std::string(name);
@@ -1297,6 +2091,7 @@ bool dbcfile::LoadFile(const char* name, const char* path, FILE* fd)
     ESP_LOGW(TAG,"Path %s is protected",path);
     return false;
     }
+  cache = cache && MyConfig.GetParamValueBool("dbc", "cache", true);
 #endif // #ifdef CONFIG_OVMS
 
   void yyrestart(FILE *input_file);
@@ -1312,10 +2107,21 @@ bool dbcfile::LoadFile(const char* name, const char* path, FILE* fd)
       ESP_LOGW(TAG,"Could not open %s for reading",path);
       return false;
       }
+    uint32_t size, hash;
+    cache = cache && dbc_source_hash(fd, &size, &hash);
+    if (cache && LoadCache(path, size, hash))
+      {
+      ESP_LOGD(TAG,"Loaded %s from cache",path);
+      fclose(fd);
+      Compile();
+      return true;
+      }
     FILE *yyin = fd;
     yyrestart(yyin);
     result = (yyparse ((void *)this) == 0);
     fclose(fd);
+    if (result && cache)
+      SaveCache(path, size, hash);
     }
   else
     {
@@ -1326,6 +2132,7 @@ bool dbcfile::LoadFile(const char* name, const char* path, FILE* fd)
     fseek(fd,0,SEEK_SET);
     }
 
+  if (result) Compile();
   return result;
   }
 
@@ -1341,6 +2148,7 @@ bool dbcfile::LoadString(const char* name, const char* source, size_t length)
   bool result = (yyparse (this) == 0);
   yy_delete_buffer(buffer);
 
+  if (result) Compile();
   return result;
   }
 
@@ -1394,12 +2202,23 @@ std::string dbcfile::Status()
     ss << "% coverage";
     }
   ss << ", ";
+  ss << m_plan.GetSignalCount();
+  ss << " decoded, ";
   ss << m_locks;
   ss << " lock(s)";
 
   return ss.str();
   }
 
+/**
+ * Compile: (re)build the decode plan, needs to be called after changing
+ *  signals or their metric assignments.
+ */
+void dbcfile::Compile()
+  {
+  m_plan.Compile(&m_messages);
+  }
+
 std::string dbcfile::GetName()
   {
   return m_name;
@@ -34,11 +34,13 @@
 #include <string>
 #include <map>
 #include <list>
+#include <vector>
 #include <functional>
 #include <iostream>
 #include "dbc_number.h"
 #include "can.h"
 #include "ovms_metrics.h"
+#include "ovms_mutex.h"
 
 #define DBC_MAX_LINELENGTH 2048
 
@@ -69,6 +71,13 @@ typedef enum
   DBC_VALUETYPE_SIGNED = '-'
   } dbcValueType_t;
 
+typedef enum
+  {
+  DBC_EXTVALUETYPE_INTEGER = 0,         // SIG_VALTYPE_ codes
+  DBC_EXTVALUETYPE_FLOAT = 1,           // IEEE float32
+  DBC_EXTVALUETYPE_DOUBLE = 2           // IEEE float64
+  } dbcExtValueType_t;
+
 uint32_t dbcMessageIdFromString(const char* id);
 
 typedef std::list<std::string> dbcCommentList_t;
@@ -283,6 +292,7 @@ class dbcSignal
     int GetSignalSize();
     dbcByteOrder_t GetByteOrder();
     dbcValueType_t GetValueType();
+    dbcExtValueType_t GetExtValueType();
     dbcNumber GetFactor();
     dbcNumber GetOffset();
     dbcNumber GetMinimum();
@@ -290,6 +300,7 @@ class dbcSignal
     void SetStartSize(const int startbit, const int size);
     void SetByteOrder(const dbcByteOrder_t order);
     void SetValueType(const dbcValueType_t type);
+    void SetExtValueType(const dbcExtValueType_t type);
     void SetFactorOffset(const dbcNumber factor, const dbcNumber offset);
     void SetFactorOffset(const double factor, const double offset);
     void SetMinMax(const dbcNumber minimum, const dbcNumber maximum);
@@ -301,6 +312,7 @@ class dbcSignal
   public:
     void Encode(dbcNumber* source, CAN_frame_t* msg);
     dbcNumber Decode(CAN_frame_t* msg);
+    dbcNumber DecodeValue(uint64_t val);
 
   public:
     void AssignMetric(OvmsMetric* metric);
@@ -323,6 +335,7 @@ class dbcSignal
     int m_signal_size;
     dbcByteOrder_t m_byte_order;
     dbcValueType_t m_value_type;
+    dbcExtValueType_t m_ext_value_type;
     dbcNumber m_factor;
     dbcNumber m_offset;
     dbcNumber m_minimum;
@@ -412,6 +425,86 @@ class dbcMessageTable
     dbcMessageEntry_t m_entrymap;
   };
 
+/**
+ * dbcDecodePlan: flat decode plan for the signals bound to metrics
+ *
+ * Compiled from the message table at load time, so frame decoding needs
+ * no map lookups, list walks or per bit slice loops. Each step extracts
+ * its raw value by a shift & mask from the 64 bit payload (or by direct
+ * byte access for byte aligned 8/16 bit signals) and applies the scaling
+ * precomputed for its factor & offset types. Messages are kept sorted by
+ * ID, standard IDs are additionally indexed directly.
+ * Compile() builds a new plan and swaps it in under the plan mutex, which
+ * Decode() holds while decoding, so recompiling on a running bus is safe.
+ */
+
+typedef enum
+  {
+  DBC_DECODE_U8 = 0,                  // Byte aligned 8 bit
+  DBC_DECODE_LE16,                    // Byte aligned 16 bit little endian
+  DBC_DECODE_BE16,                    // Byte aligned 16 bit big endian
+  DBC_DECODE_LE,                      // Little endian shift & mask
+  DBC_DECODE_BE                       // Big endian shift & mask
+  } dbcDecodeKind_t;
+
+typedef enum
+  {
+  DBC_SCALE_NONE = 0,                 // Raw integer value
+  DBC_SCALE_DOUBLE,                   // Double factor & offset
+  DBC_SCALE_NUMBER                    // Integer factor/offset, 64 bit & float: dbcSignal::DecodeValue()
+  } dbcDecodeScale_t;
+
+struct dbcDecodeStep_t
+  {
+  uint8_t kind;                       // dbcDecodeKind_t
+  uint8_t scale;                      // dbcDecodeScale_t
+  uint8_t shift;                      // LSB bit position in payload, byte index for byte access
+  uint8_t size;                       // Signal size in bits
+  bool is_signed;
+  bool multiplexed;                   // Only valid for matching multiplexor value
+  uint32_t switchvalue;
+  uint64_t mask;
+  double factor;
+  double offset;
+  dbcSignal* signal;
+  OvmsMetric* metric;
+  };
+
+struct dbcDecodeMessage_t
+  {
+  uint32_t id;                        // Message ID (bit 31 set for extended IDs)
+  uint16_t first;                     // Index of first step
+  uint16_t count;                     // Number of steps
+  bool mux;                           // First step is the multiplexor
+  };
+
+class dbcDecodePlan
+  {
+  public:
+    dbcDecodePlan();
+    ~dbcDecodePlan();
+
+  public:
+    void Compile(dbcMessageTable* messages, bool all=false);
+    void Clear();
+    const dbcDecodeMessage_t* Find(CAN_frame_format_t format, uint32_t id);
+    int Decode(CAN_frame_t* frame);
+    dbcNumber Value(const dbcDecodeStep_t& step, const uint8_t* data, uint64_t le, uint64_t be);
+    int GetSignalCount();
+
+  protected:
+    void Build(dbcMessageTable* messages, bool all);
+    bool AddStep(dbcSignal* signal);
+
+  public:
+    std::vector<dbcDecodeStep_t> m_steps;
+    std::vector<dbcDecodeMessage_t> m_messages;
+    std::vector<int16_t> m_stdindex;    // Standard ID -> message index, -1 = none
+
+  protected:
+    OvmsMutex m_mutex;                  // Plan swap vs. Decode()
+  };
+
 class dbcfile
   {
   public:
@@ -420,9 +513,11 @@ class dbcfile
 
   private:
     void FreeAllocations();
+    bool LoadCache(const char* path, uint32_t size, uint32_t hash);
+    bool SaveCache(const char* path, uint32_t size, uint32_t hash);
 
   public:
-    bool LoadFile(const char* name, const char* path, FILE *fd=NULL);
+    bool LoadFile(const char* name, const char* path, FILE *fd=NULL, bool cache=true);
     bool LoadString(const char* name, const char* source, size_t length);
     void WriteFile(dbcOutputCallback callback, void* param);
     void WriteSummary(dbcOutputCallback callback, void* param);
@@ -430,6 +525,7 @@ class dbcfile
     std::string GetName();
     std::string GetPath();
     std::string GetVersion();
+    void Compile();
 
   public:
     void LockFile();
@@ -446,6 +542,7 @@ class dbcfile
     dbcValueTableTable m_values;
     dbcMessageTable m_messages;
     dbcCommentTable m_comments;
+    dbcDecodePlan m_plan;
 
   private:
     dbcMessage* m_lastmsg;
@@ -557,6 +557,7 @@ dbc::dbc()
   MyConfig.RegisterParam("dbc", "DBC Configuration", true, true);
   // Our instances:
   //   'autodirs': Space separated list of directories to auto load DBC files from
+  //   'cache': Cache parsed DBC files as binary <path>.cache for fast loading (default yes)
 
   #undef bind  // Kludgy, but works
   using std::placeholders::_1;
@@ -746,6 +747,8 @@ void dbc::DeselectFile()
   {
   if (m_selected)
     {
+    // Apply edits to the decode plan:
+    m_selected->Compile();
     m_selected->UnlockFile();
     m_selected = NULL;
     }
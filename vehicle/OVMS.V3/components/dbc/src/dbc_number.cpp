@@ -84,6 +84,16 @@ bool dbcNumber::IsDouble()
   return (m_type == DBC_NUMBER_DOUBLE);
   }
 
+bool dbcNumber::IsInteger64()
+  {
+  return ((m_type == DBC_NUMBER_INTEGER_SIGNED64)||(m_type == DBC_NUMBER_INTEGER_UNSIGNED64));
+  }
+
+bool dbcNumber::IsSigned()
+  {
+  return ((m_type == DBC_NUMBER_INTEGER_SIGNED)||(m_type == DBC_NUMBER_INTEGER_SIGNED64));
+  }
+
 void dbcNumber::Set(int32_t value)
   {
   m_type = DBC_NUMBER_INTEGER_SIGNED;
@@ -98,7 +108,22 @@ void dbcNumber::Set(uint32_t value)
 
 void dbcNumber::Set(double value)
   {
-  if (ceil(value)==value)
+  if ((ceil(value)==value)&&((value<INT32_MIN)||(value>UINT32_MAX))&&
+      (value>=-9223372036854775808.0)&&(value<18446744073709551616.0))
+    {
+    // Integer beyond 32 bit range:
+    if (value<0)
+      {
+      m_type = DBC_NUMBER_INTEGER_SIGNED64;
+      m_value.sint64val = (int64_t)value;
+      }
+    else
+      {
+      m_type = DBC_NUMBER_INTEGER_UNSIGNED64;
+      m_value.uint64val = (uint64_t)value;
+      }
+    }
+  else if (ceil(value)==value)
     {
     if (value<0)
       {
@@ -118,6 +143,18 @@ void dbcNumber::Set(double value)
     }
   }
 
+void dbcNumber::SetSigned64(int64_t value)
+  {
+  m_type = DBC_NUMBER_INTEGER_SIGNED64;
+  m_value.sint64val = value;
+  }
+
+void dbcNumber::SetUnsigned64(uint64_t value)
+  {
+  m_type = DBC_NUMBER_INTEGER_UNSIGNED64;
+  m_value.uint64val = value;
+  }
+
 void dbcNumber::Cast(uint32_t value, dbcNumberType_t type)
   {
   switch(type)
@@ -132,6 +169,20 @@ void dbcNumber::Cast(uint32_t value, dbcNumberType_t type)
     }
   }
 
+void dbcNumber::Cast64(uint64_t value, dbcNumberType_t type)
+  {
+  switch(type)
+    {
+    case DBC_NUMBER_INTEGER_SIGNED64:
+    case DBC_NUMBER_INTEGER_UNSIGNED64:
+      m_value.uint64val = value;
+      m_type = type;
+      break;
+    default:
+      break;
+    }
+  }
+
 int32_t dbcNumber::GetSignedInteger()
   {
   switch (m_type)
@@ -145,6 +196,12 @@ int32_t dbcNumber::GetSignedInteger()
     case DBC_NUMBER_DOUBLE:
       return (int32_t)m_value.doubleval;
       break;
+    case DBC_NUMBER_INTEGER_SIGNED64:
+      return (int32_t)m_value.sint64val;
+      break;
+    case DBC_NUMBER_INTEGER_UNSIGNED64:
+      return (int32_t)m_value.uint64val;
+      break;
     default:
       return 0;
       break;
@@ -164,6 +221,62 @@ uint32_t dbcNumber::GetUnsignedInteger()
     case DBC_NUMBER_DOUBLE:
       return (uint32_t)m_value.doubleval;
       break;
+    case DBC_NUMBER_INTEGER_SIGNED64:
+      return (uint32_t)m_value.sint64val;
+      break;
+    case DBC_NUMBER_INTEGER_UNSIGNED64:
+      return (uint32_t)m_value.uint64val;
+      break;
+    default:
+      return 0;
+      break;
+    }
+  }
+
+int64_t dbcNumber::GetSignedInteger64()
+  {
+  switch (m_type)
+    {
+    case DBC_NUMBER_INTEGER_SIGNED:
+      return m_value.sintval;
+      break;
+    case DBC_NUMBER_INTEGER_UNSIGNED:
+      return m_value.uintval;
+      break;
+    case DBC_NUMBER_DOUBLE:
+      return (int64_t)m_value.doubleval;
+      break;
+    case DBC_NUMBER_INTEGER_SIGNED64:
+      return m_value.sint64val;
+      break;
+    case DBC_NUMBER_INTEGER_UNSIGNED64:
+      return (int64_t)m_value.uint64val;
+      break;
+    default:
+      return 0;
+      break;
+    }
+  }
+
+uint64_t dbcNumber::GetUnsignedInteger64()
+  {
+  switch (m_type)
+    {
+    case DBC_NUMBER_INTEGER_SIGNED:
+      return (uint64_t)(int64_t)m_value.sintval;
+      break;
+    case DBC_NUMBER_INTEGER_UNSIGNED:
+      return m_value.uintval;
+      break;
+    case DBC_NUMBER_DOUBLE:
+      return (uint64_t)m_value.doubleval;
+      break;
+    case DBC_NUMBER_INTEGER_SIGNED64:
+      return (uint64_t)m_value.sint64val;
+      break;
+    case DBC_NUMBER_INTEGER_UNSIGNED64:
+      return m_value.uint64val;
+      break;
     default:
       return 0;
       break;
@@ -183,6 +296,12 @@ double dbcNumber::GetDouble()
     case DBC_NUMBER_DOUBLE:
       return m_value.doubleval;
       break;
+    case DBC_NUMBER_INTEGER_SIGNED64:
+      return (double)m_value.sint64val;
+      break;
+    case DBC_NUMBER_INTEGER_UNSIGNED64:
+      return (double)m_value.uint64val;
+      break;
     default:
       return 0;
       break;
@@ -202,6 +321,12 @@ std::ostream& operator<<(std::ostream& os, const dbcNumber& me)
     case DBC_NUMBER_DOUBLE:
       os << me.m_value.doubleval;
       break;
+    case DBC_NUMBER_INTEGER_SIGNED64:
+      os << (long long)me.m_value.sint64val;
+      break;
+    case DBC_NUMBER_INTEGER_UNSIGNED64:
+      os << (unsigned long long)me.m_value.uint64val;
+      break;
     default:
       os << 0;
       break;
@@ -241,8 +366,42 @@ dbcNumber& dbcNumber::operator=(const dbcNumber& value)
   return *this;
   }
 
+/**
+ * Arithmetic64: multiply or add with at least one 64 bit integer operand
+ *  Doubles stay doubles, integers are widened to 64 bit (signed if any
+ *  operand is signed).
+ */
+dbcNumber dbcNumber::Arithmetic64(const dbcNumber& value, bool multiply)
+  {
+  dbcNumber other(value);
+  dbcNumber result;
+  if (!IsDefined() || !other.IsDefined())
+    {
+    result.Set((uint32_t)0);
+    }
+  else if (IsDouble() || other.IsDouble())
+    {
+    double a = GetDouble(), b = other.GetDouble();
+    result = multiply ? (a * b) : (a + b);
+    }
+  else if (IsSigned() || other.IsSigned())
+    {
+    int64_t a = GetSignedInteger64(), b = other.GetSignedInteger64();
+    result.SetSigned64(multiply ? (a * b) : (a + b));
+    }
+  else
+    {
+    uint64_t a = GetUnsignedInteger64(), b = other.GetUnsignedInteger64();
+    result.SetUnsigned64(multiply ? (a * b) : (a + b));
+    }
+  return result;
+  }
+
 dbcNumber dbcNumber::operator*(const dbcNumber& value)
   {
+  if (m_type >= DBC_NUMBER_INTEGER_SIGNED64 || value.m_type >= DBC_NUMBER_INTEGER_SIGNED64)
+    return Arithmetic64(value, true);
+
   switch (value.m_type)
     {
     case DBC_NUMBER_INTEGER_SIGNED:
@@ -301,6 +460,9 @@ dbcNumber dbcNumber::operator*(const dbcNumber& value)
 
 dbcNumber dbcNumber::operator+(const dbcNumber& value)
   {
+  if (m_type >= DBC_NUMBER_INTEGER_SIGNED64 || value.m_type >= DBC_NUMBER_INTEGER_SIGNED64)
+    return Arithmetic64(value, false);
+
   switch (value.m_type)
     {
     case DBC_NUMBER_INTEGER_SIGNED:
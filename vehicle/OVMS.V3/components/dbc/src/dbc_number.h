@@ -40,7 +40,9 @@ typedef enum
   DBC_NUMBER_NONE = 0,
   DBC_NUMBER_INTEGER_SIGNED,
   DBC_NUMBER_INTEGER_UNSIGNED,
-  DBC_NUMBER_DOUBLE
+  DBC_NUMBER_DOUBLE,
+  DBC_NUMBER_INTEGER_SIGNED64,
+  DBC_NUMBER_INTEGER_UNSIGNED64
 } dbcNumberType_t;
 
 class dbcNumber
@@ -58,12 +60,19 @@ class dbcNumber
     bool IsSignedInteger();
     bool IsUnsignedInteger();
     bool IsDouble();
+    bool IsInteger64();
+    bool IsSigned();
     void Set(int32_t value);
     void Set(uint32_t value);
     void Set(double value);
+    void SetSigned64(int64_t value);
+    void SetUnsigned64(uint64_t value);
     void Cast(uint32_t value, dbcNumberType_t type);
+    void Cast64(uint64_t value, dbcNumberType_t type);
     int32_t GetSignedInteger();
     uint32_t GetUnsignedInteger();
+    int64_t GetSignedInteger64();
+    uint64_t GetUnsignedInteger64();
     double GetDouble();
     friend std::ostream& operator<<(std::ostream& os, const dbcNumber& me);
     dbcNumber& operator=(const int32_t value);
@@ -76,6 +85,9 @@ class dbcNumber
     bool operator==(const uint32_t value);
     bool operator==(const double value);
 
+  protected:
+    dbcNumber Arithmetic64(const dbcNumber& value, bool multiply);
+
   protected:
     dbcNumberType_t m_type;
     union
@@ -83,6 +95,8 @@ class dbcNumber
       uint32_t uintval;
       int32_t sintval;
       double doubleval;
+      uint64_t uint64val;
+      int64_t sint64val;
       } m_value;
   };
 
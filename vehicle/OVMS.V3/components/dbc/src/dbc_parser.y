@@ -183,6 +183,7 @@ dbc_section:
   | message_section
   | signal_section
   | value_section
+  | signal_valtype_section
   | attribute_section
   | attribute_default_section
   | comment_section
@@ -461,6 +462,40 @@ value_list:
     }
     ;
 
+/************************************************************************/
+/* signal_valtype_section (SIG_VALTYPE_)                                */
+/************************************************************************/
+
+/* SIG_VALTYPE_ 1160 DAS_steeringAngleRequest : 1; */
+signal_valtype_section:
+    T_SIG_VALTYPE T_INT_VAL T_ID T_COLON T_INT_VAL T_SEMICOLON
+    {
+    dbcMessage* m = current_dbc->m_messages.FindMessage((uint32_t)$2);
+    if (m == NULL)
+      {
+      yyerror(current_dbc, "SIG_VALTYPE_ message not found");
+      free($3);
+      YYABORT;
+      }
+    dbcSignal* s = m->FindSignal(std::string($3));
+    if (s == NULL)
+      {
+      yyerror(current_dbc, "SIG_VALTYPE_ signal not found (in message)");
+      free($3);
+      YYABORT;
+      }
+    if (($5 < DBC_EXTVALUETYPE_INTEGER)||($5 > DBC_EXTVALUETYPE_DOUBLE))
+      {
+      yyerror(current_dbc, "SIG_VALTYPE_ invalid value type");
+      free($3);
+      YYABORT;
+      }
+    ESP_LOGD(TAG,"SIG_VALTYPE_ parsed %d/%s: %d",(int)$2,$3,(int)$5);
+    s->SetExtValueType((dbcExtValueType_t)$5);
+    free($3);
+    }
+    ;
+
 /************************************************************************/
 /* attribute_section_list (BA_DEF_)                                     */
 /************************************************************************/
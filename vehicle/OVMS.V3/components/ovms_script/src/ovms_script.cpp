@@ -212,6 +212,18 @@ void OvmsScripts::EventScript(std::string event, void* data)
   MyDuktape.EventScript(event, data);
 #endif // #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
 
+  if (!m_event_dirs_valid)
+    IndexEventScripts();
+  if (m_event_dirs.find(event) == m_event_dirs.end())
+    {
+#ifdef CONFIG_OVMS_DEV_SDCARDSCRIPTS
+    m_probes_avoided += 2;
+#else
+    m_probes_avoided++;
+#endif // #ifdef CONFIG_OVMS_DEV_SDCARDSCRIPTS
+    return;
+    }
+
 #ifdef CONFIG_OVMS_DEV_SDCARDSCRIPTS
   // run event scripts on external storage:
   path=std::string("/sd/events/");
@@ -225,6 +237,45 @@ void OvmsScripts::EventScript(std::string event, void* data)
   AllScripts(path);
   }
 
+/**
+ * IndexEventScripts: collect the event script directory names
+ *  The index is invalidated on storage mounts and VFS changes below the
+ *  events directories, and rebuilt on the next event (in the event task).
+ */
+void OvmsScripts::IndexEventScripts()
+  {
+  m_event_dirs_valid = true;
+  m_event_dirs.clear();
+#ifdef CONFIG_OVMS_DEV_SDCARDSCRIPTS
+  IndexEventScripts("/sd/events");
+#endif // #ifdef CONFIG_OVMS_DEV_SDCARDSCRIPTS
+  IndexEventScripts("/store/events");
+  ESP_LOGD(TAG, "IndexEventScripts: %u events with scripts", m_event_dirs.size());
+  }
+
+void OvmsScripts::IndexEventScripts(const char* path)
+  {
+  DIR *dir;
+  struct dirent *dp;
+  if ((dir = opendir(path)) != NULL)
+    {
+    while ((dp = readdir(dir)) != NULL)
+      m_event_dirs.insert(dp->d_name);
+    closedir(dir);
+    }
+  }
+
+void OvmsScripts::InvalidateEventScripts(std::string event, void* data)
+  {
+  if (event == "system.vfs.file.changed")
+    {
+    std::string path = data ? (const char*) data : "";
+    if (!startsWith(path, "/store/events") && !startsWith(path, "/sd/events"))
+      return;
+    }
+  m_event_dirs_valid = false;
+  }
+
 OvmsScripts::OvmsScripts()
   {
   ESP_LOGI(TAG, "Initialising SCRIPTS (1600)");
@@ -242,6 +293,17 @@ OvmsScripts::OvmsScripts()
   cmd_script->RegisterCommand("meminfo","Show heap memory status",script_meminfo);
 #endif // #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
   MyCommandApp.RegisterCommand(".","Run a script",script_run,"<path>",1,1);
+
+  m_event_dirs_valid = false;
+  m_probes_avoided = 0;
+
+  #undef bind  // Kludgy, but works
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+  MyEvents.RegisterEvent(TAG, "config.mounted", std::bind(&OvmsScripts::InvalidateEventScripts, this, _1, _2));
+  MyEvents.RegisterEvent(TAG, "sd.mounted", std::bind(&OvmsScripts::InvalidateEventScripts, this, _1, _2));
+  MyEvents.RegisterEvent(TAG, "sd.unmounted", std::bind(&OvmsScripts::InvalidateEventScripts, this, _1, _2));
+  MyEvents.RegisterEvent(TAG, "system.vfs.file.changed", std::bind(&OvmsScripts::InvalidateEventScripts, this, _1, _2));
   }
 
 OvmsScripts::~OvmsScripts()
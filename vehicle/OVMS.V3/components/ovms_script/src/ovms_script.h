@@ -31,6 +31,8 @@
 #ifndef __SCRIPT_H__
 #define __SCRIPT_H__
 
+#include <set>
+#include <string>
 #include "ovms_command.h"
 #include "ovms_utils.h"
 #include "freertos/FreeRTOS.h"
@@ -51,6 +53,22 @@ class OvmsScripts
   public:
     void EventScript(std::string event, void* data);
     void AllScripts(std::string path);
+
+  public:
+    // Index of event names having script directories, avoids probing
+    // the filesystem for every event:
+    void IndexEventScripts();
+    void InvalidateEventScripts(std::string event, void* data);
+    size_t GetEventScriptsCount() { return m_event_dirs.size(); }
+    uint32_t GetProbesAvoided() { return m_probes_avoided; }
+
+  protected:
+    void IndexEventScripts(const char* path);
+
+  protected:
+    std::set<std::string> m_event_dirs;
+    volatile bool m_event_dirs_valid;
+    uint32_t m_probes_avoided;
   };
 
 extern OvmsScripts MyScripts;
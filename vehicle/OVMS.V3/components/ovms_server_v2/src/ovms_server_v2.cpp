@@ -306,11 +306,19 @@ void OvmsServerV2::ProcessServerMsg()
       std::string msg("MP-0 ET");
       msg.append(m_ptoken);
       Transmit(msg);
-      m_ptoken_ready = true;
 
       // Generate, and store, the digest for future use
       std::string modpass = MyConfig.GetParamValue("password","module");
       hmac_md5((uint8_t*) token, OVMS_PROTOCOL_V2_TOKENSIZE, (uint8_t*)modpass.c_str(), modpass.length(), m_pdigest);
+
+      // Prime the paranoid key state once, every message starts from a copy
+      RC4_setup(&m_pcrypto1, &m_pcrypto2, m_pdigest, OVMS_MD5_SIZE);
+      for (int k=0;k<1024;k++)
+        {
+        uint8_t zero = 0;
+        RC4_crypt(&m_pcrypto1, &m_pcrypto2, &zero, 1);
+        }
+      m_ptoken_ready = true;
       }
 
     m_pending_notify_info = true;
@@ -355,15 +363,9 @@ void OvmsServerV2::ProcessServerMsg()
     uint8_t *d = new uint8_t[line.length()-6];
     len = base64decode(line.c_str()+7,d+1);
 
-    RC4_CTX1* pm_crypto1 = new RC4_CTX1;
-    RC4_CTX2* pm_crypto2 = new RC4_CTX2;
-    RC4_setup(pm_crypto1, pm_crypto2, m_pdigest, OVMS_MD5_SIZE);
-    for (int k=0;k<1024;k++)
-      {
-      uint8_t zero = 0;
-      RC4_crypt(pm_crypto1, pm_crypto2, &zero, 1);
-      }
-    RC4_crypt(pm_crypto1, pm_crypto2, d, len);
+    RC4_CTX1 pm_crypto1 = m_pcrypto1;
+    RC4_CTX2 pm_crypto2 = m_pcrypto2;
+    RC4_crypt(&pm_crypto1, &pm_crypto2, d, len);
 
     line.erase(5);
     line = std::string("MP-0 ");
@@ -371,8 +373,6 @@ void OvmsServerV2::ProcessServerMsg()
     line.append((char*)d);
     len = line.length();
 
-    delete pm_crypto1;
-    delete pm_crypto2;
     delete[] d;
     ESP_LOGI(TAG, "Decoded Paranoid Msg: %s",line.c_str());
     }
@@ -749,62 +749,117 @@ void OvmsServerV2::ProcessCommand(const char* payload)
   }
 
 bool OvmsServerV2::Transmit(const std::string& message)
+  {
+  return Transmit(message.data(), message.length());
+  }
+
+bool OvmsServerV2::Transmit(const char* message, size_t len)
   {
   OvmsMutexLock mg(&m_mgconn_mutex);
   if (!m_mgconn)
     return false;
 
-  int len = message.length();
-  char* s = new char[(len*2)+4];
-  memcpy(s,message.c_str(),len);
-  ESP_LOGI(TAG, "Send %s",message.c_str());
+  ESP_LOGI(TAG, "Send %.*s", (int)len, message);
 
   if ((m_ptoken_ready)&&
-      (s[5] != 'E')&&
-      (s[5] != 'A')&&
-      (s[5] != 'a')&&
-      (s[5] != 'g')&&
-      (s[5] != 'P'))
+      (len > 5)&&
+      (message[5] != 'E')&&
+      (message[5] != 'A')&&
+      (message[5] != 'a')&&
+      (message[5] != 'g')&&
+      (message[5] != 'P'))
     {
     // We must convert the message to a paranoid one...
     // The message is of the form MP-0 X...
     // Where X is the code and ... is the (optional) data
-    char code[2]; code[0] = s[5]; code[1] = 0;
-    uint8_t* d = new uint8_t[len-6];
-    memcpy(d,s+6,len-6);
-
-    // Paranoid encrypt the message part of the transaction
-    RC4_CTX1* pm_crypto1 = new RC4_CTX1;
-    RC4_CTX2* pm_crypto2 = new RC4_CTX2;
-    RC4_setup(pm_crypto1, pm_crypto2, m_pdigest, OVMS_MD5_SIZE);
-    for (int k=0;k<1024;k++)
-      {
-      uint8_t zero = 0;
-      RC4_crypt(pm_crypto1, pm_crypto2, &zero, 1);
-      }
-    RC4_crypt(pm_crypto1, pm_crypto2, d, len-6);
-
-    strcpy(s,"MP-0 EM");
-    strcat(s,code);
-    base64encode(d, len-6, (uint8_t*)s+8);
-    // The messdage is now in paranoid mode...
-    delete[] d;
-    delete pm_crypto1;
-    delete pm_crypto2;
+    // The paranoid keystream restarts for every message, so we can simply
+    // continue from a copy of the key state primed at login:
+    size_t dlen = (len > 6) ? len-6 : 0;
+    m_txdata.assign(message+len-dlen, dlen);
+    RC4_CTX1 pm_crypto1 = m_pcrypto1;
+    RC4_CTX2 pm_crypto2 = m_pcrypto2;
+    RC4_crypt(&pm_crypto1, &pm_crypto2, (uint8_t*)&m_txdata[0], dlen);
+
+    m_txplain.resize(8 + ((dlen+2)/3)*4 + 1);
+    memcpy(&m_txplain[0], "MP-0 EM", 7);
+    m_txplain[7] = message[5];
+    char* e = base64encode((const uint8_t*)m_txdata.data(), dlen, (uint8_t*)&m_txplain[8]);
+    m_txplain.resize(e - m_txplain.data());
+    // The message is now in paranoid mode...
+    }
+  else
+    {
+    m_txplain.assign(message, len);
     }
 
-  RC4_crypt(&m_crypto_tx1, &m_crypto_tx2, (uint8_t*)s, len);
+  len = m_txplain.length();
+  RC4_crypt(&m_crypto_tx1, &m_crypto_tx2, (uint8_t*)&m_txplain[0], len);
+
+  // Append the encoded line to the transmit buffer:
+  size_t pos = m_txbuffer.length();
+  m_txbuffer.resize(pos + ((len+2)/3)*4 + 1);
+  char* e = base64encode((const uint8_t*)m_txplain.data(), len, (uint8_t*)&m_txbuffer[pos]);
+  m_txbuffer.resize(e - m_txbuffer.data());
+  m_txbuffer.append("\r\n");
 
-  char* buf = new char[(len*2)+4];
-  base64encode((uint8_t*)s, len, (uint8_t*)buf);
-  strcat(buf,"\r\n");
-  mg_send(m_mgconn, buf, strlen(buf));
+  if (!m_txbatch)
+    {
+    mg_send(m_mgconn, m_txbuffer.data(), m_txbuffer.length());
+    m_txbuffer.clear();
+    m_txcnt_sends++;
+    }
+  return true;
+  }
 
-  delete [] buf;
-  delete [] s;
+/**
+ * TransmitRecord: transmit a status record unless it's byte identical to the
+ *  last record sent with the same message code (and we're not forced to send)
+ */
+bool OvmsServerV2::TransmitRecord(const extram::string& record, bool always)
+  {
+  if (!m_txrecords_valid)
+    {
+    // New session: forget the records sent on the previous one
+    m_txrecords.clear();
+    m_txrecords_valid = true;
+    }
+  char code = (record.length() > 5) ? record[5] : 0;
+  extram::string& last = m_txrecords[code];
+  if ((!always) && (record == last))
+    {
+    ESP_LOGD(TAG, "Record %c unchanged, not sent", code);
+    m_txcnt_suppressed++;
+    return true;
+    }
+  if (!Transmit(record.data(), record.length()))
+    return false;
+  last = record;
+  m_txcnt_records++;
   return true;
   }
 
+/**
+ * TransmitBatchStart / TransmitBatchFlush: coalesce all messages transmitted
+ *  in between into a single mg_send
+ */
+void OvmsServerV2::TransmitBatchStart()
+  {
+  OvmsMutexLock mg(&m_mgconn_mutex);
+  m_txbatch = true;
+  }
+
+void OvmsServerV2::TransmitBatchFlush()
+  {
+  OvmsMutexLock mg(&m_mgconn_mutex);
+  m_txbatch = false;
+  if (m_mgconn && !m_txbuffer.empty())
+    {
+    mg_send(m_mgconn, m_txbuffer.data(), m_txbuffer.length());
+    m_txcnt_sends++;
+    }
+  m_txbuffer.clear();
+  }
+
 void OvmsServerV2::SetStatus(const char* status, bool fault, State newstate)
   {
   if (fault)
@@ -918,6 +973,7 @@ void OvmsServerV2::Disconnect()
     m_mgconn = NULL;
     }
   m_buffer->EmptyAll();
+  m_txbuffer.clear();
   m_connretry = 0;
   StandardMetrics.ms_s_v2_connected->SetValue(false);
   StandardMetrics.ms_s_v2_peers->SetValue(0);
@@ -932,6 +988,7 @@ void OvmsServerV2::Reconnect(int connretry)
     m_mgconn = NULL;
     }
   m_buffer->EmptyAll();
+  m_txbuffer.clear();
   m_connretry = connretry;
   StandardMetrics.ms_s_v2_connected->SetValue(false);
   StandardMetrics.ms_s_v2_peers->SetValue(0);
@@ -969,6 +1026,7 @@ void OvmsServerV2::SendLogin(struct mg_connection *nc)
 
   m_ptoken.clear();
   m_ptoken_ready = false;
+  m_txrecords_valid = false;
 
   uint8_t digest[OVMS_MD5_SIZE];
   hmac_md5((uint8_t*) token, OVMS_PROTOCOL_V2_TOKENSIZE, (uint8_t*)m_password.c_str(), m_password.length(), digest);
@@ -1112,7 +1170,7 @@ void OvmsServerV2::TransmitMsgStat(bool always)
     << StandardMetrics.ms_v_bat_range_speed->AsFloat(0, units_speed)
     ;
 
-  Transmit(buffer.str().c_str());
+  TransmitRecord(buffer.str(), always);
   }
 
 void OvmsServerV2::TransmitMsgGen(bool always)
@@ -1201,7 +1259,7 @@ void OvmsServerV2::TransmitMsgGen(bool always)
     << StandardMetrics.ms_v_gen_temp->AsFloat()
     ;
 
-  Transmit(buffer.str().c_str());
+  TransmitRecord(buffer.str(), always);
   }
 
 
@@ -1279,7 +1337,7 @@ void OvmsServerV2::TransmitMsgGPS(bool always)
     << StandardMetrics.ms_v_pos_gpssq->AsInt()
     ;
 
-  Transmit(buffer.str().c_str());
+  TransmitRecord(buffer.str(), always);
   }
 
 void OvmsServerV2::TransmitMsgTPMS(bool always)
@@ -1349,7 +1407,7 @@ void OvmsServerV2::TransmitMsgTPMS(bool always)
     << StandardMetrics.ms_v_tpms_alert->AsString("")
     << "," << defstale_alert
     ;
-  Transmit(buffer.str().c_str());
+  TransmitRecord(buffer.str(), always);
 
   // Transmit legacy "W" message (fixed four tyres, only pressures & temperatures):
 
@@ -1395,7 +1453,7 @@ void OvmsServerV2::TransmitMsgTPMS(bool always)
     << ","
     << defstale
     ;
-  Transmit(buffer.str().c_str());
+  TransmitRecord(buffer.str(), always);
   }
 
 void OvmsServerV2::TransmitMsgFirmware(bool always)
@@ -1447,7 +1505,7 @@ void OvmsServerV2::TransmitMsgFirmware(bool always)
     << mp_encode(StandardMetrics.ms_m_hardware->AsString(""))
     ;
 
-  Transmit(buffer.str().c_str());
+  TransmitRecord(buffer.str(), always);
   }
 
 uint8_t Doors1()
@@ -1613,7 +1671,7 @@ void OvmsServerV2::TransmitMsgEnvironment(bool always)
     << StandardMetrics.ms_v_env_cabintemp->AsString("0")
     ;
 
-  Transmit(buffer.str().c_str());
+  TransmitRecord(buffer.str(), always);
   }
 
 void OvmsServerV2::TransmitMsgCapabilities(bool always)
@@ -2033,6 +2091,9 @@ void OvmsServerV2::Ticker1(std::string event, void* data)
       return;
       }
 
+    // Coalesce all messages due in this tick into one send:
+    TransmitBatchStart();
+
     // Periodic transmission of metrics
     bool caron = StandardMetrics.ms_v_env_on->AsBool();
     int now = StandardMetrics.ms_m_monotonic->AsInt();
@@ -2079,6 +2140,8 @@ void OvmsServerV2::Ticker1(std::string event, void* data)
       m_pending_notify_data_last = 0;
       TransmitNotifyData();
       }
+
+    TransmitBatchFlush();
     }
   }
 
@@ -2128,6 +2191,12 @@ OvmsServerV2::OvmsServerV2(const char* name)
   m_peers = 0;
   m_connretry = 0;
   m_mgconn = NULL;
+  m_ptoken_ready = false;
+  m_txbatch = false;
+  m_txrecords_valid = false;
+  m_txcnt_records = 0;
+  m_txcnt_suppressed = 0;
+  m_txcnt_sends = 0;
 
   m_pending_notify_info = false;
   m_pending_notify_error = false;
@@ -2274,6 +2343,9 @@ void ovmsv2_status(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc
         break;
       }
     writer->printf("       %s\n",MyOvmsServerV2->m_status.c_str());
+    writer->printf("Records: %u sent, %u unchanged suppressed, %u socket sends\n",
+      MyOvmsServerV2->m_txcnt_records, MyOvmsServerV2->m_txcnt_suppressed,
+      MyOvmsServerV2->m_txcnt_sends);
     }
   }
 
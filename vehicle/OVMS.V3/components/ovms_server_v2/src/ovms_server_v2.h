@@ -35,6 +35,7 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <map>
 #include <sys/time.h>
 #include "ovms_server.h"
 #include "ovms_netmanager.h"
@@ -65,6 +66,10 @@ class OvmsServerV2 : public OvmsServer
     void ProcessServerMsg();
     void ProcessCommand(const char* payload);
     bool Transmit(const std::string& message);
+    bool Transmit(const char* message, size_t len);
+    bool TransmitRecord(const extram::string& record, bool always);
+    void TransmitBatchStart();
+    void TransmitBatchFlush();
 
   protected:
     void TransmitMsgStat(bool always = false);
@@ -138,6 +143,22 @@ class OvmsServerV2 : public OvmsServer
     uint8_t m_pdigest[OVMS_MD5_SIZE];
     std::string m_ptoken;
     bool m_ptoken_ready;
+    RC4_CTX1 m_pcrypto1;                        // paranoid key state after the 1024 byte discard
+    RC4_CTX2 m_pcrypto2;
+
+    extram::string m_txplain;                   // reusable message encoding buffer
+    extram::string m_txdata;                    // reusable paranoid payload buffer
+    extram::string m_txbuffer;                  // encoded lines pending mg_send
+    bool m_txbatch;                             // true = coalesce lines until TransmitBatchFlush()
+    std::map<char, extram::string> m_txrecords; // last record sent per message code
+    bool m_txrecords_valid;                     // false = clear m_txrecords on next use
+
+  public:
+    uint32_t m_txcnt_records;
+    uint32_t m_txcnt_suppressed;
+    uint32_t m_txcnt_sends;
+
+  protected:
 
     bool m_now_stat;
     bool m_now_gen;
@@ -33,6 +33,7 @@ static const char *TAG = "ovms-server-v3";
 
 #include <string.h>
 #include <stdint.h>
+#include "esp_timer.h"
 #include "ovms_server_v3.h"
 #include "buffered_shell.h"
 #include "ovms_command.h"
@@ -46,6 +47,16 @@ OvmsServerV3 *MyOvmsServerV3 = NULL;
 size_t MyOvmsServerV3Modifier = 0;
 size_t MyOvmsServerV3Reader = 0;
 
+// Size of an MQTT PUBLISH message on the wire (without TLS/TCP overhead)
+static size_t MqttPublishSize(size_t topiclen, size_t payloadlen, int qos)
+  {
+  size_t remaining = 2 + topiclen + ((qos > 0) ? 2 : 0) + payloadlen;
+  size_t size = 2 + remaining;
+  for (size_t n = remaining >> 7; n > 0; n >>= 7)
+    size++;
+  return size;
+  }
+
 bool OvmsServerV3ReaderCallback(OvmsNotifyType* type, OvmsNotifyEntry* entry)
   {
   if (MyOvmsServerV3)
@@ -185,7 +196,7 @@ OvmsServerV3::OvmsServerV3(const char* name)
   {
   if (MyOvmsServerV3Modifier == 0)
     {
-    MyOvmsServerV3Modifier = MyMetrics.RegisterModifier();
+    MyOvmsServerV3Modifier = MyMetrics.RegisterModifier(true);
     ESP_LOGI(TAG, "OVMS Server V3 registered metric modifier is #%d",MyOvmsServerV3Modifier);
     }
 
@@ -203,6 +214,11 @@ OvmsServerV3::OvmsServerV3(const char* name)
   m_updatetime_on = m_updatetime_idle;
   m_updatetime_charging = m_updatetime_idle;
   m_updatetime_sendall = 0;
+  m_metrics_batch = false;
+  m_metrics_retained = true;
+  memset(&m_txstats, 0, sizeof(m_txstats));
+  memset(&m_txstats_sync, 0, sizeof(m_txstats_sync));
+  m_metric_topics_generation = 0;
   m_notify_info_pending = false;
   m_notify_error_pending = false;
   m_notify_alert_pending = false;
@@ -265,16 +281,34 @@ void OvmsServerV3::TransmitAllMetrics()
   if (!m_mgconn)
     return;
 
+  int64_t start = esp_timer_get_time();
+  OvmsServerV3TxStats before = m_txstats;
+  extram::string batch;
+  if (m_metrics_batch)
+    {
+    batch.reserve(MyMetrics.GetCount() * 24);
+    batch.append("{");
+    }
+
   OvmsMetric* metric = MyMetrics.m_first;
   while (metric != NULL)
     {
     metric->ClearModified(MyOvmsServerV3Modifier);
     if (!metric->AsString().empty())
       {
-      TransmitMetric(metric);
+      TransmitMetric(metric, m_metrics_batch ? &batch : NULL);
       }
     metric = metric->m_next;
     }
+  if (m_metrics_batch)
+    TransmitMetricBatch(batch, true);
+
+  m_txstats.time += m_txstats_sync.time = esp_timer_get_time() - start;
+  m_txstats_sync.metrics = m_txstats.metrics - before.metrics;
+  m_txstats_sync.messages = m_txstats.messages - before.messages;
+  m_txstats_sync.bytes = m_txstats.bytes - before.bytes;
+  ESP_LOGI(TAG, "Tx all metrics: %u metrics in %u messages, %u bytes, %u ms",
+    m_txstats_sync.metrics, m_txstats_sync.messages, m_txstats_sync.bytes, m_txstats_sync.time / 1000);
   }
 
 void OvmsServerV3::TransmitModifiedMetrics()
@@ -283,40 +317,96 @@ void OvmsServerV3::TransmitModifiedMetrics()
   if (!m_mgconn)
     return;
 
-  OvmsMetric* metric = MyMetrics.m_first;
-  while (metric != NULL)
+  int64_t start = esp_timer_get_time();
+  extram::string batch;
+  if (m_metrics_batch)
+    batch.append("{");
+
+  OvmsMetric* metric;
+  while ((metric = MyMetrics.NextModified(MyOvmsServerV3Modifier)) != NULL)
     {
-    if (metric->IsModifiedAndClear(MyOvmsServerV3Modifier))
-      {
-      TransmitMetric(metric);
-      }
-    metric = metric->m_next;
+    TransmitMetric(metric, m_metrics_batch ? &batch : NULL);
     }
+  if (m_metrics_batch)
+    TransmitMetricBatch(batch, false);
+
+  m_txstats.time += esp_timer_get_time() - start;
   }
 
-void OvmsServerV3::TransmitMetric(OvmsMetric* metric)
+/**
+ * GetMetricTopic: get the cached MQTT topic for a metric
+ *  - '.' inside the metric name is replaced by '/' for MQTT like namespacing
+ *  - the cache is dropped on prefix changes (Connect) and metric removals
+ */
+const extram::string& OvmsServerV3::GetMetricTopic(OvmsMetric* metric)
+  {
+  if (m_metric_topics_generation != MyMetrics.GetGeneration())
+    {
+    m_metric_topics.clear();
+    m_metric_topics_generation = MyMetrics.GetGeneration();
+    }
+
+  auto it = m_metric_topics.find(metric);
+  if (it != m_metric_topics.end())
+    return it->second;
+
+  extram::string& topic = m_metric_topics[metric];
+  topic.reserve(m_topic_prefix.length() + 7 + strlen(metric->m_name));
+  topic.append(m_topic_prefix.data(), m_topic_prefix.length());
+  topic.append("metric/");
+  for (const char* p = metric->m_name; *p; p++)
+    topic.push_back((*p == '.') ? '/' : *p);
+  return topic;
+  }
+
+void OvmsServerV3::TransmitMetric(OvmsMetric* metric, extram::string* batch)
   {
   auto const metric_name = metric->m_name;
 
   if (!m_metrics_filter.CheckFilter(metric_name))
     return;
 
-  std::string topic(m_topic_prefix);
-  topic.append("metric/");
-  topic.append(metric_name);
+  if (m_metrics_retained)
+    {
+    const extram::string& topic = GetMetricTopic(metric);
+    std::string val = metric->AsString();
+    mg_mqtt_publish(m_mgconn, topic.c_str(), m_msgid++,
+      MG_MQTT_QOS(0) | MG_MQTT_RETAIN, val.c_str(), val.length());
+    ESP_LOGD(TAG,"Tx metric %s=%s",topic.c_str(),val.c_str());
+    m_txstats.messages++;
+    m_txstats.bytes += MqttPublishSize(topic.length(), val.length(), 0);
+    }
 
-  // Replace '.' inside the metric name by '/' for MQTT like namespacing.
-  for(size_t i = m_topic_prefix.length(); i < topic.length(); i++)
+  if (batch)
     {
-      if(topic[i] == '.')
-        topic[i] = '/';
+    // Add "name":value to the batch object:
+    std::string val = metric->AsJSON();
+    if (batch->length() > 1)
+      batch->append(",");
+    batch->append("\"");
+    batch->append(metric_name);
+    batch->append("\":");
+    batch->append(val.data(), val.length());
     }
 
-  std::string val = metric->AsString();
+  m_txstats.metrics++;
+  }
 
-  mg_mqtt_publish(m_mgconn, topic.c_str(), m_msgid++,
-    MG_MQTT_QOS(0) | MG_MQTT_RETAIN, val.c_str(), val.length());
-  ESP_LOGI(TAG,"Tx metric %s=%s",topic.c_str(),val.c_str());
+/**
+ * TransmitMetricBatch: publish metric batch JSON object to <prefix>metrics
+ *  - full syncs are retained, so new subscribers get a complete set
+ *  - batches of modified metrics are not retained
+ */
+void OvmsServerV3::TransmitMetricBatch(extram::string& batch, bool all)
+  {
+  if (batch.length() <= 1)
+    return;
+  batch.append("}");
+  mg_mqtt_publish(m_mgconn, m_batch_topic.c_str(), m_msgid++,
+    MG_MQTT_QOS(0) | (all ? MG_MQTT_RETAIN : 0), batch.data(), batch.length());
+  ESP_LOGD(TAG,"Tx metric batch %s=%s",m_batch_topic.c_str(),batch.c_str());
+  m_txstats.messages++;
+  m_txstats.bytes += MqttPublishSize(m_batch_topic.length(), batch.length(), 0);
   }
 
 int OvmsServerV3::TransmitNotificationInfo(OvmsNotifyEntry* entry)
@@ -649,6 +739,10 @@ void OvmsServerV3::Connect()
   m_will_topic = std::string(m_topic_prefix);
   m_will_topic.append("metric/s/v3/connected");
 
+  m_batch_topic = std::string(m_topic_prefix);
+  m_batch_topic.append("metrics");
+  m_metric_topics.clear();
+
   m_conn_topic[0] = std::string(m_topic_prefix);
   m_conn_topic[0].append("client/+/active");
 
@@ -828,6 +922,10 @@ void OvmsServerV3::ConfigChanged(OvmsConfigParam* param)
   m_updatetime_sendall = MyConfig.GetParamValueInt("server.v3", "updatetime.sendall", 0);
   m_metrics_filter.LoadFilters(MyConfig.GetParamValue("server.v3", "metrics.include"),
                                MyConfig.GetParamValue("server.v3", "metrics.exclude"));
+  m_metrics_batch = MyConfig.GetParamValueBool("server.v3", "metrics.batch", false);
+  m_metrics_retained = MyConfig.GetParamValueBool("server.v3", "metrics.retained", true);
+  if (!m_metrics_batch && !m_metrics_retained)
+    m_metrics_retained = true;
   }
 
 void OvmsServerV3::NetUp(std::string event, void* data)
@@ -1043,6 +1141,18 @@ void ovmsv3_status(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc
         break;
       }
     writer->printf("       %s\n",MyOvmsServerV3->m_status.c_str());
+
+    const OvmsServerV3TxStats& sync = MyOvmsServerV3->m_txstats_sync;
+    const OvmsServerV3TxStats& total = MyOvmsServerV3->m_txstats;
+    writer->printf("Metrics: %s%s%s\n",
+      MyOvmsServerV3->m_metrics_retained ? "per metric topics" : "",
+      (MyOvmsServerV3->m_metrics_retained && MyOvmsServerV3->m_metrics_batch) ? " + " : "",
+      MyOvmsServerV3->m_metrics_batch ? "batched" : "");
+    if (sync.metrics)
+      writer->printf("  Last full sync: %u metrics in %u messages, %u bytes, %u ms\n",
+        sync.metrics, sync.messages, sync.bytes, sync.time / 1000);
+    writer->printf("  Total: %u metrics in %u messages, %u bytes, %u ms\n",
+      total.metrics, total.messages, total.bytes, total.time / 1000);
     }
   }
 
@@ -1086,6 +1196,8 @@ OvmsServerV3Init::OvmsServerV3Init()
   //   'server': The server name/ip
   //   'user': The server username
   //   'port': The port to connect to (default: 1883)
+  //   'metrics.batch': Publish metrics batched as JSON object on <prefix>metrics (default: no)
+  //   'metrics.retained': Publish metrics on retained per metric topics (default: yes)
   // Also note:
   //  Parameter "vehicle", instance "id", is the vehicle ID
   //  Parameter "password", instance "server.v3", is the server password
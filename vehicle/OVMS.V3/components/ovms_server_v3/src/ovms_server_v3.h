@@ -33,6 +33,7 @@
 
 #include <string>
 #include <map>
+#include "ovms.h"
 #include "ovms_server.h"
 #include "ovms_netmanager.h"
 #include "ovms_metrics.h"
@@ -42,6 +43,16 @@
 #include "id_include_exclude_filter.h"
 
 typedef std::map<std::string, uint32_t> OvmsServerV3ClientMap;
+typedef std::map<OvmsMetric*, extram::string, std::less<OvmsMetric*>,
+  ExtRamAllocator<std::pair<OvmsMetric* const, extram::string>>> OvmsServerV3TopicMap;
+
+typedef struct
+  {
+  uint32_t metrics;                   // metric values transmitted
+  uint32_t messages;                  // MQTT messages published
+  uint32_t bytes;                     // MQTT message bytes (without TLS/TCP overhead)
+  uint32_t time;                      // publish time [us]
+  } OvmsServerV3TxStats;
 
 #define MQTT_CONN_NTOPICS 2
 
@@ -107,6 +118,11 @@ class OvmsServerV3 : public OvmsServer
     int m_updatetime_on;
     int m_updatetime_charging;
     int m_updatetime_sendall;
+    bool m_metrics_batch;               // publish metric batches on <prefix>metrics
+    bool m_metrics_retained;            // publish metrics on retained per metric topics
+    std::string m_batch_topic;
+    OvmsServerV3TxStats m_txstats;      // totals
+    OvmsServerV3TxStats m_txstats_sync; // last full sync
 
     bool m_notify_info_pending;
     bool m_notify_error_pending;
@@ -140,9 +156,13 @@ class OvmsServerV3 : public OvmsServer
     void CountClients();
 
   private:
-    void TransmitMetric(OvmsMetric* metric);
+    void TransmitMetric(OvmsMetric* metric, extram::string* batch);
+    void TransmitMetricBatch(extram::string& batch, bool all);
+    const extram::string& GetMetricTopic(OvmsMetric* metric);
 
     IdIncludeExcludeFilter m_metrics_filter;
+    OvmsServerV3TopicMap m_metric_topics;
+    uint32_t m_metric_topics_generation;
   };
 
 class OvmsServerV3Init
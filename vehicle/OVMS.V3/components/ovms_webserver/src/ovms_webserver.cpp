@@ -648,8 +648,14 @@ void PageEntry::Serve(PageContext_t& c)
   }
 #endif //MG_ENABLE_FILESYSTEM
 
-  // call page handler:
-  handler(*this, c);
+  // call page handler, coalescing config changes of forms
+  // (not for the shell, which may run commands of any duration):
+  if (c.method == "POST" && handler != OvmsWebServer::HandleShell) {
+    OvmsConfigTransaction transaction;
+    handler(*this, c);
+  } else {
+    handler(*this, c);
+  }
 }
 
 
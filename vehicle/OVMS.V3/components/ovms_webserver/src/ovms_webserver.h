@@ -435,6 +435,7 @@ class WebSocketHandler : public MgHandler, public OvmsWriter
     int                       m_sent = 0;
     int                       m_ack = 0;
     int                       m_last = 0;             // last entry sent up
+    OvmsMetricCursor          m_cursor;               // metrics list position
     std::set<std::string>     m_subscriptions;
     bool                      m_units_subscribed;
     bool                      m_units_prefs_subscribed;
@@ -118,34 +118,75 @@ void WebSocketHandler::ProcessTxJob()
       break;
     }
     
-    case WSTX_MetricsAll:
     case WSTX_MetricsUpdate:
     {
-      // Note: this loops over the metrics by index, keeping the last checked position
-      //  in m_last. It will not detect new metrics added between polls if they are
-      //  inserted before m_last, so new metrics may not be sent until first changed.
-      //  The Metrics set normally is static, so this should be no problem.
+      // Note: this drains the metrics journal of our modifier, so only changed metrics
+      //  are visited. m_last counts the metrics taken from the journal, it's limited to
+      //  the metrics count so the job finishes on continuous updates. Changes remaining
+      //  in the journal will be sent by the next update job.
       
-      // find start:
-      int i;
-      OvmsMetric* m;
-      for (i=0, m=MyMetrics.m_first; i < m_last && m != NULL; m=m->m_next, i++);
+      int count = MyMetrics.GetCount();
+      if (m_last < count) {
+        // build msg:
+        int i;
+        std::string msg;
+        msg.reserve(2*XFER_CHUNK_SIZE+128);
+        msg = "{\"metrics\":{";
+        for (i=0; m_last < count && msg.size() < XFER_CHUNK_SIZE; i++) {
+          OvmsMetric* m = MyMetrics.NextModified(m_modifier);
+          if (!m) {
+            m_last = count;
+            break;
+          }
+          ++m_last;
+          if (i) msg += ',';
+          msg += '\"';
+          msg += m->m_name;
+          msg += "\":";
+          m->AppendJSON(msg);
+        }
+        
+        // send msg:
+        if (i) {
+          msg += "}}";
+          ESP_EARLY_LOGV(TAG, "WebSocket msg: %s", msg.c_str());
+          mg_send_websocket_frame(m_nc, WEBSOCKET_OP_TEXT, msg.data(), msg.size());
+          m_sent += i;
+        }
+      }
+      
+      // done?
+      if (m_last >= count && m_ack == m_sent) {
+        if (m_sent)
+          ESP_EARLY_LOGV(TAG, "WebSocketHandler[%p]: ProcessTxJob type=%d done, sent=%d metrics", m_nc, m_job.type, m_sent);
+        ClearTxJob(m_job);
+      }
+      
+      break;
+    }
+    
+    case WSTX_MetricsAll:
+    {
+      // Note: this loops over the metrics using the cursor, so each chunk continues
+      //  where the last one ended. New metrics inserted before the cursor position
+      //  will not be sent until first changed.
+      
+      OvmsMetric* m = m_cursor.Resume();
       
       // build msg:
       if (m) {
+        int i;
         std::string msg;
         msg.reserve(2*XFER_CHUNK_SIZE+128);
         msg = "{\"metrics\":{";
-        for (i=0; m && msg.size() < XFER_CHUNK_SIZE; m=m->m_next) {
-          ++m_last;
-          if (m->IsModifiedAndClear(m_modifier) || m_job.type == WSTX_MetricsAll) {
-            if (i) msg += ',';
-            msg += '\"';
-            msg += m->m_name;
-            msg += "\":";
-            msg += m->AsJSON();
-            i++;
-          }
+        for (i=0; m && msg.size() < XFER_CHUNK_SIZE; m=m_cursor.Advance()) {
+          m->ClearModified(m_modifier);
+          if (i) msg += ',';
+          msg += '\"';
+          msg += m->m_name;
+          msg += "\":";
+          m->AppendJSON(msg);
+          i++;
         }
 
         // send msg:
@@ -169,17 +210,13 @@ void WebSocketHandler::ProcessTxJob()
 
     case WSTX_UnitMetricUpdate:
     {
-      // Note: this loops over the metrics by index, keeping the last checked position
-      //  in m_last. It will not detect new metrics added between polls if they are
-      //  inserted before m_last, so new metrics may not be sent until first changed.
-      //  The Metrics set normally is static, so this should be no problem.
+      // Note: this loops over the metrics using the cursor, so each chunk continues
+      //  where the last one ended. New metrics inserted before the cursor position
+      //  will not be sent until first changed.
 
-      ESP_EARLY_LOGD(TAG, "WebSocketHandler[%p/%d]: ProcessTxJob MetricsUnitUpdate, last=%d sent=%d ack=%d", m_nc, m_modifier, m_last, m_sent, m_ack);
-      // find start:
+      ESP_EARLY_LOGD(TAG, "WebSocketHandler[%p/%d]: ProcessTxJob MetricsUnitUpdate, sent=%d ack=%d", m_nc, m_modifier, m_sent, m_ack);
       int i;
-      OvmsMetric* m;
-      for (i=0, m=MyMetrics.m_first; i < m_last && m != NULL; m=m->m_next, i++);
-      ESP_EARLY_LOGD(TAG, "WebSocketHandler[%p/%d]: ProcessTxJob MetricsUnitUpdate, i=%d", m_nc, m_modifier, i);
+      OvmsMetric* m = m_cursor.Resume();
       if (m) { // Bypass this if we are on the 'just sent' leg.
         // build msg:
         std::string msg;
@@ -187,8 +224,7 @@ void WebSocketHandler::ProcessTxJob()
         msg = "{\"units\":{\"metrics\":{";
 
         // Cache the user mappings for each group.
-        for (i=0; m && msg.size() < XFER_CHUNK_SIZE; m=m->m_next) {
-          ++m_last;
+        for (i=0; m && msg.size() < XFER_CHUNK_SIZE; m=m_cursor.Advance()) {
           bool send = m->IsUnitSendAndClear(m_modifier);
           if (send) {
             if (i)
@@ -437,6 +473,7 @@ bool WebSocketHandler::GetNextTxJob()
   if (xQueueReceive(m_jobqueue, &m_job, 0) == pdTRUE) {
     // init new job state:
     m_sent = m_ack = m_last = 0;
+    m_cursor.Reset();
     return true;
   } else {
     return false;
@@ -579,7 +616,7 @@ WebSocketHandler* OvmsWebServer::CreateWebSocketHandler(mg_connection* nc)
     // create new client slot:
     WebSocketSlot slot;
     slot.handler = NULL;
-    slot.modifier = MyMetrics.RegisterModifier();
+    slot.modifier = MyMetrics.RegisterModifier(true);
     slot.reader = MyNotify.RegisterReader("ovmsweb", COMMAND_RESULT_VERBOSE,
                                           std::bind(&OvmsWebServer::IncomingNotification, i, _1, _2), true,
                                           std::bind(&OvmsWebServer::NotificationFilter, i, _1, _2));
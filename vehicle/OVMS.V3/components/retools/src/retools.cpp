@@ -32,6 +32,8 @@
 static const char *TAG = "re";
 
 #include <string.h>
+#include <algorithm>
+#include <esp_timer.h>
 #include "retools.h"
 #include "dbc_app.h"
 #include "ovms.h"
@@ -114,7 +116,7 @@ void re::Task()
 
   while(1)
     {
-    if (xQueueReceive(m_rxqueue, &message.frame, (portTickType)portMAX_DELAY)==pdTRUE)
+    if (m_rxreader->Read(&message.frame, portMAX_DELAY))
       {
       if (MyRE != NULL) // Protect against MyRE not set (during init)
         {
@@ -143,18 +145,18 @@ void re::DoAnalyse(CAN_frame_t* frame)
   char vbuf[256];
 
   OvmsRecMutexLock lock(&m_mutex);
-  std::string key = GetKey(frame);
+  int64_t time_start_us = esp_timer_get_time();
+  uint64_t key = GetKey(frame);
   auto k = m_rmap.find(key);
   re_record_t* r;
   if (m_rmap.size() == 0) m_started = monotonictime;
   if (k == m_rmap.end())
     {
-    r = k->second;
     r = new re_record_t;
     memset(r,0,sizeof(re_record_t));
     r->attr.b.Changed = 1; // Mark the whole ID as changed
     r->attr.dc = 0xff;
-    switch (MyRE->m_mode)
+    switch (m_mode)
       {
       case Analyse:
         break;
@@ -163,7 +165,7 @@ void re::DoAnalyse(CAN_frame_t* frame)
         r->attr.dd = 0xff;
         HighlightDump(vbuf, (const char*)frame->data.u8, frame->FIR.B.DLC, r->attr.dc, r->attr.dd);
         ESP_LOGV(TAG, "Discovered new %s%s%s %s",
-          re_green[0][0], key.c_str(), re_green[0][1], vbuf);
+          re_green[0][0], GetKeyName(key).c_str(), re_green[0][1], vbuf);
         break;
       }
     m_rmap[key] = r;
@@ -171,7 +173,7 @@ void re::DoAnalyse(CAN_frame_t* frame)
   else
     {
     r = k->second;
-    switch (MyRE->m_mode)
+    switch (m_mode)
       {
       case Analyse:
         for (int k=0;k<r->last.FIR.B.DLC;k++)
@@ -197,7 +199,7 @@ void re::DoAnalyse(CAN_frame_t* frame)
         if (found)
           {
           HighlightDump(vbuf, (const char*)frame->data.u8, frame->FIR.B.DLC, r->attr.dc, r->attr.dd);
-          ESP_LOGV(TAG, "Discovered change %s %s", k->first.c_str(), vbuf);
+          ESP_LOGV(TAG, "Discovered change %s %s", GetKeyName(k->first).c_str(), vbuf);
           }
         break;
         }
@@ -205,23 +207,17 @@ void re::DoAnalyse(CAN_frame_t* frame)
     }
   memcpy(&r->last,frame,sizeof(CAN_frame_t));
   r->rxcount++;
+  m_analysed++;
+  m_analysetime += esp_timer_get_time() - time_start_us;
   }
 
-std::string re::GetKey(CAN_frame_t* frame)
+uint64_t re::GetKey(CAN_frame_t* frame)
   {
-  std::string key;
-  if (frame->origin != NULL)
-    key = std::string(frame->origin->GetName());
-  else
-    key = std::string("can?");
-  key.append("/");
-
-  char id[9];
-  if (frame->FIR.B.FF == CAN_frame_std)
-    sprintf(id,"%03" PRIx32,frame->MsgID);
-  else
-    sprintf(id,"%08" PRIx32,frame->MsgID);
-  key.append(id);
+  uint64_t bus = (frame->origin != NULL) ? frame->origin->m_busnumber : RE_KEY_BUS_UNKNOWN;
+  uint64_t key = (bus << RE_KEY_BUS_SHIFT) |
+                 ((uint64_t)(frame->MsgID & RE_KEY_ID_MASK) << RE_KEY_ID_SHIFT);
+  if (frame->FIR.B.FF == CAN_frame_ext)
+    key |= RE_KEY_EXT;
 
   if (((m_obdii_std_min>0) &&
        (frame->FIR.B.FF == CAN_frame_std) &&
@@ -239,26 +235,19 @@ std::string re::GetKey(CAN_frame_t* frame)
       // Probably just a continuation frame. Ignore it.
       return key;
       }
-    uint8_t mode = frame->data.u8[1];
-    char req[16];
-    if (mode > 0x4a)
+    uint64_t mode = frame->data.u8[1];
+    uint64_t kind = RE_KEY_OBD_REQUEST;
+    uint64_t pid;
+    if (mode > 0x40)
       {
-      sprintf(req,":O2Pm%d:%d",mode-0x40,((int)frame->data.u8[2]<<8)+frame->data.u8[3]);
-      }
-    else if (mode > 0x40)
-      {
-      sprintf(req,":O2Pm%d:%d",mode-0x40,(int)frame->data.u8[2]);
-      }
-    else if (mode > 0x0a)
-      {
-      sprintf(req,":O2Qm%d:%d",mode,((int)frame->data.u8[2]<<8)+frame->data.u8[3]);
+      kind = RE_KEY_OBD_RESPONSE;
+      mode -= 0x40;
       }
+    if (mode > 0x0a)
+      pid = ((uint32_t)frame->data.u8[2]<<8) + frame->data.u8[3];
     else
-      {
-      sprintf(req,":O2Qm%d:%d",mode,(int)frame->data.u8[2]);
-      }
-    key.append(req);
-    return key;
+      pid = frame->data.u8[2];
+    return key | (kind << RE_KEY_KIND_SHIFT) | (mode << 16) | pid;
     }
 
   // Check for, and process, multiplexed signal
@@ -274,9 +263,7 @@ std::string re::GetKey(CAN_frame_t* frame)
         dbcSignal* s = m->GetMultiplexorSignal();
         dbcNumber muxn = s->Decode(frame);
         uint32_t mux = muxn.GetUnsignedInteger();
-        char b[8];
-        sprintf(b,":%04" PRIx32,mux);
-        key.append(b);
+        key |= ((uint64_t)RE_KEY_MUX << RE_KEY_KIND_SHIFT) | (mux & RE_KEY_AUX_MASK);
         }
       }
     }
@@ -284,7 +271,61 @@ std::string re::GetKey(CAN_frame_t* frame)
   return key;
   }
 
-re::re(const char* name, canfilter* filter)
+std::string re::GetKeyName(uint64_t key)
+  {
+  char buf[48];
+  char* p = buf;
+  int bus = key >> RE_KEY_BUS_SHIFT;
+  uint32_t id = (key >> RE_KEY_ID_SHIFT) & RE_KEY_ID_MASK;
+  uint32_t aux = key & RE_KEY_AUX_MASK;
+
+  if (bus == RE_KEY_BUS_UNKNOWN)
+    p += sprintf(p, "can?/");
+  else
+    p += sprintf(p, "can%d/", bus+1);
+  if (key & RE_KEY_EXT)
+    p += sprintf(p, "%08" PRIx32, id);
+  else
+    p += sprintf(p, "%03" PRIx32, id);
+
+  switch ((key >> RE_KEY_KIND_SHIFT) & 3)
+    {
+    case RE_KEY_OBD_REQUEST:
+      sprintf(p, ":O2Qm%d:%d", (int)(aux >> 16), (int)(aux & 0xffff));
+      break;
+    case RE_KEY_OBD_RESPONSE:
+      sprintf(p, ":O2Pm%d:%d", (int)(aux >> 16), (int)(aux & 0xffff));
+      break;
+    case RE_KEY_MUX:
+      sprintf(p, ":%04" PRIx32, aux);
+      break;
+    default:
+      break;
+    }
+
+  return std::string(buf);
+  }
+
+uint32_t re::GetLostFrames()
+  {
+  return m_rxreader ? m_rxreader->m_overflows : 0;
+  }
+
+void re::GetSortedRecords(re_record_list_t& list)
+  {
+  OvmsRecMutexLock lock(&m_mutex);
+  list.assign(m_rmap.begin(), m_rmap.end());
+  std::sort(list.begin(), list.end(),
+    [](const std::pair<uint64_t, re_record_t*>& a, const std::pair<uint64_t, re_record_t*>& b)
+      { return a.first < b.first; });
+  }
+
+/**
+ * re: create a reverse engineering session
+ *  - live: attach to the CAN frame ring & start the analysis task; instances
+ *    created with live=false only analyse frames passed to DoAnalyse()
+ */
+re::re(const char* name, canfilter* filter, bool live)
   : pcp(name)
   {
   m_filter = filter;
@@ -294,20 +335,31 @@ re::re(const char* name, canfilter* filter)
   m_obdii_ext_max = 0;
   m_started = monotonictime;
   m_finished = monotonictime;
+  m_analysed = 0;
+  m_analysetime = 0;
   m_mode = Analyse;
-  m_rxqueue = xQueueCreate(20,sizeof(CAN_frame_t));
-  xTaskCreatePinnedToCore(RE_task, "OVMS RE", 4096, (void*)this, 5, &m_task, CORE(1));
-  MyCan.RegisterListener(m_rxqueue, true);
+  m_rmap.reserve(512);
+  m_task = NULL;
+  m_rxreader = NULL;
+  if (live)
+    {
+    m_rxreader = MyCan.m_ring.AddReader("retools", CAN_RING_RXTX);
+    xTaskCreatePinnedToCore(RE_task, "OVMS RE", 4096, (void*)this, 5, &m_task, CORE(1));
+    }
   }
 
 re::~re()
   {
   OvmsRecMutexLock lock(&m_mutex);
-  MyCan.DeregisterListener(m_rxqueue);
+  if (m_rxreader)
+    {
+    MyCan.m_ring.DetachReader(m_rxreader);
+    vTaskDelete(m_task);
+    MyCan.m_ring.RemoveReader(m_rxreader);
+    m_rxreader = NULL;
+    }
 
   Clear();
-  vQueueDelete(m_rxqueue);
-  vTaskDelete(m_task);
   if (m_filter)
     {
     delete m_filter;
@@ -342,6 +394,8 @@ void re::Clear()
   m_rmap.clear();
   m_started = monotonictime;
   m_finished = monotonictime;
+  m_analysed = 0;
+  m_analysetime = 0;
   }
 
 void re_start(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
@@ -411,15 +465,18 @@ void re_list(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, cons
 
   OvmsRecMutexLock lock(&MyRE->m_mutex);
   writer->printf("%-20.20s %10s %6s %s\n","key","records","ms","last");
-  for (re_record_map_t::iterator it=MyRE->m_rmap.begin(); it!=MyRE->m_rmap.end(); ++it)
+  re_record_list_t records;
+  MyRE->GetSortedRecords(records);
+  for (auto it=records.begin(); it!=records.end(); ++it)
     {
-    if ((argc==0)||(strstr(it->first.c_str(),argv[0])))
+    std::string key = re::GetKeyName(it->first);
+    if ((argc==0)||(strstr(key.c_str(),argv[0])))
       {
       char vbuf[48];
       char *s = vbuf;
       FormatHexDump(&s, (const char*)it->second->last.data.u8, it->second->last.FIR.B.DLC, 8);
       writer->printf("%-20s %10" PRId32 " %6" PRId32 " %s\n",
-        it->first.c_str(),it->second->rxcount,(tdiff/it->second->rxcount),vbuf);
+        key.c_str(),it->second->rxcount,(tdiff/it->second->rxcount),vbuf);
       }
     }
   }
@@ -440,15 +497,18 @@ void re_stream_list(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int arg
   writer->printf("[");
   int cnt = 0;
   char *ascii = NULL;
-  for (re_record_map_t::iterator it=MyRE->m_rmap.begin(); it!=MyRE->m_rmap.end(); ++it)
+  re_record_list_t records;
+  MyRE->GetSortedRecords(records);
+  for (auto it=records.begin(); it!=records.end(); ++it)
     {
-    if (argc == 0 || strstr(it->first.c_str(),argv[0]) != NULL)
+    std::string key = re::GetKeyName(it->first);
+    if (argc == 0 || strstr(key.c_str(),argv[0]) != NULL)
       {
       HighlightDump(vbuf, (const char*)it->second->last.data.u8,
         it->second->last.FIR.B.DLC, it->second->attr.dc, it->second->attr.dd, 1, &ascii);
       writer->printf("%s[\"%s\",%" PRId32 ",%" PRId32 ",\"%s\",\"%s\"]\n",
         cnt ? "," : "",
-        json_encode(it->first).c_str(), it->second->rxcount, (tdiff/it->second->rxcount),
+        json_encode(key).c_str(), it->second->rxcount, (tdiff/it->second->rxcount),
         json_encode(std::string(vbuf)).c_str(),
         json_encode(std::string(ascii)).c_str());
       cnt++;
@@ -470,15 +530,18 @@ void re_dbc_list(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc,
 
   OvmsRecMutexLock lock(&MyRE->m_mutex);
   writer->printf("%-20.20s %10s %6s %s\n","key","records","ms","last");
-  for (re_record_map_t::iterator it=MyRE->m_rmap.begin(); it!=MyRE->m_rmap.end(); ++it)
+  re_record_list_t records;
+  MyRE->GetSortedRecords(records);
+  for (auto it=records.begin(); it!=records.end(); ++it)
     {
-    if ((argc==0)||(strstr(it->first.c_str(),argv[0])))
+    std::string key = re::GetKeyName(it->first);
+    if ((argc==0)||(strstr(key.c_str(),argv[0])))
       {
       char vbuf[48];
       char *s = vbuf;
       FormatHexDump(&s, (const char*)it->second->last.data.u8, it->second->last.FIR.B.DLC, 8);
       writer->printf("%-20s %10" PRId32 " %6" PRId32 " %s\n",
-        it->first.c_str(),it->second->rxcount,(tdiff/it->second->rxcount),vbuf);
+        key.c_str(),it->second->rxcount,(tdiff/it->second->rxcount),vbuf);
       if (it->second->last.origin)
         {
         dbcfile* dbc = it->second->last.origin->GetDBC();
@@ -550,6 +613,16 @@ void re_status(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, co
     }
 
   OvmsRecMutexLock lock(&MyRE->m_mutex);
+  uint32_t elapsed = MyRE->m_finished - MyRE->m_started;
+  writer->printf("Frames:  %" PRIu32 " analysed, %" PRIu32 " per second\n",
+    MyRE->m_analysed, (elapsed > 0) ? MyRE->m_analysed / elapsed : MyRE->m_analysed);
+  if (MyRE->m_analysed > 0 && MyRE->m_analysetime > 0)
+    {
+    writer->printf("         %.1f us per frame, capacity %" PRIu32 " frames per second\n",
+      (float)MyRE->m_analysetime / MyRE->m_analysed,
+      (uint32_t)((int64_t)MyRE->m_analysed * 1000000 / MyRE->m_analysetime));
+    }
+  writer->printf("         %" PRIu32 " frames lost\n", MyRE->GetLostFrames());
   writer->printf("Key Map: %d entries\n",MyRE->m_rmap.size());
   if (MyRE->m_rmap.size() > 0)
     {
@@ -706,16 +779,19 @@ void re_list_changed(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int ar
 
   OvmsRecMutexLock lock(&MyRE->m_mutex);
   writer->printf("%-20.20s %10s %6s %s\n","key","records","ms","last");
-  for (re_record_map_t::iterator it=MyRE->m_rmap.begin(); it!=MyRE->m_rmap.end(); ++it)
+  re_record_list_t records;
+  MyRE->GetSortedRecords(records);
+  for (auto it=records.begin(); it!=records.end(); ++it)
     {
+    std::string key = re::GetKeyName(it->first);
     if ((it->second->attr.b.Changed)||(it->second->attr.dc))
       {
       HighlightDump(vbuf, (const char*)it->second->last.data.u8,
         it->second->last.FIR.B.DLC, it->second->attr.dc, it->second->attr.dd);
-      if ((argc==0)||(strstr(it->first.c_str(),argv[0])))
+      if ((argc==0)||(strstr(key.c_str(),argv[0])))
         {
         writer->printf("%-20s %10" PRId32 " %6" PRId32 " %s\n",
-          it->first.c_str(),it->second->rxcount,(tdiff/it->second->rxcount),vbuf);
+          key.c_str(),it->second->rxcount,(tdiff/it->second->rxcount),vbuf);
         }
       }
     }
@@ -737,16 +813,19 @@ void re_stream_changed(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int
   writer->printf("[");
   int cnt = 0;
   char *ascii = NULL;
-  for (re_record_map_t::iterator it=MyRE->m_rmap.begin(); it!=MyRE->m_rmap.end(); ++it)
+  re_record_list_t records;
+  MyRE->GetSortedRecords(records);
+  for (auto it=records.begin(); it!=records.end(); ++it)
     {
+    std::string key = re::GetKeyName(it->first);
     if ((it->second->attr.b.Changed || it->second->attr.dc) &&
-        (argc == 0 || strstr(it->first.c_str(),argv[0]) != NULL))
+        (argc == 0 || strstr(key.c_str(),argv[0]) != NULL))
       {
       HighlightDump(vbuf, (const char*)it->second->last.data.u8,
         it->second->last.FIR.B.DLC, it->second->attr.dc, it->second->attr.dd, 1, &ascii);
       writer->printf("%s[\"%s\",%" PRId32 ",%" PRId32 ",\"%s\",\"%s\"]\n",
         cnt ? "," : "",
-        json_encode(it->first).c_str(), it->second->rxcount, (tdiff/it->second->rxcount),
+        json_encode(key).c_str(), it->second->rxcount, (tdiff/it->second->rxcount),
         json_encode(std::string(vbuf)).c_str(),
         json_encode(std::string(ascii)).c_str());
       cnt++;
@@ -769,16 +848,19 @@ void re_list_discovered(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int
 
   OvmsRecMutexLock lock(&MyRE->m_mutex);
   writer->printf("%-20.20s %10s %6s %s\n","key","records","ms","last");
-  for (re_record_map_t::iterator it=MyRE->m_rmap.begin(); it!=MyRE->m_rmap.end(); ++it)
+  re_record_list_t records;
+  MyRE->GetSortedRecords(records);
+  for (auto it=records.begin(); it!=records.end(); ++it)
     {
+    std::string key = re::GetKeyName(it->first);
     if ((it->second->attr.b.Discovered)||(it->second->attr.dd))
       {
       HighlightDump(vbuf, (const char*)it->second->last.data.u8,
         it->second->last.FIR.B.DLC, it->second->attr.dc, it->second->attr.dd);
-      if ((argc==0)||(strstr(it->first.c_str(),argv[0])))
+      if ((argc==0)||(strstr(key.c_str(),argv[0])))
         {
         writer->printf("%-20s %10" PRId32 " %6" PRId32 " %s\n",
-          it->first.c_str(),it->second->rxcount,(tdiff/it->second->rxcount),vbuf);
+          key.c_str(),it->second->rxcount,(tdiff/it->second->rxcount),vbuf);
         }
       }
     }
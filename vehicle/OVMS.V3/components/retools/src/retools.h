@@ -36,6 +36,8 @@
 #include "freertos/queue.h"
 #include <string>
 #include <map>
+#include <unordered_map>
+#include <vector>
 #include "can.h"
 #include "canformat.h"
 #include "dbc.h"
@@ -66,14 +68,36 @@ typedef struct
     } attr;
   } re_record_t;
 
-typedef std::map<std::string, re_record_t*> re_record_map_t;
+/**
+ * Record keys are packed into 64 bits:
+ *  bits 61-63: bus number (7 = unknown origin)
+ *  bit  60   : extended frame format
+ *  bits 31-59: CAN ID
+ *  bits 29-30: key kind (plain / OBDII request / OBDII response / multiplexed)
+ *  bits  0-28: OBDII mode (bits 16-23) & PID (bits 0-15), or multiplexor value
+ * Key strings are only generated for display by re::GetKeyName().
+ */
+#define RE_KEY_BUS_SHIFT          61
+#define RE_KEY_BUS_UNKNOWN        7
+#define RE_KEY_EXT                ((uint64_t)1 << 60)
+#define RE_KEY_ID_SHIFT           31
+#define RE_KEY_ID_MASK            0x1fffffff
+#define RE_KEY_KIND_SHIFT         29
+#define RE_KEY_PLAIN              0
+#define RE_KEY_OBD_REQUEST        1
+#define RE_KEY_OBD_RESPONSE       2
+#define RE_KEY_MUX                3
+#define RE_KEY_AUX_MASK           0x1fffffff
+
+typedef std::unordered_map<uint64_t, re_record_t*> re_record_map_t;
+typedef std::vector< std::pair<uint64_t, re_record_t*> > re_record_list_t;
 
 enum REMode { Analyse, Discover };
 
 class re : public pcp, public ExternalRamAllocated
   {
   public:
-    re(const char* name, canfilter* filter = NULL);
+    re(const char* name, canfilter* filter = NULL, bool live = true);
     ~re();
 
   public:
@@ -82,14 +106,15 @@ class re : public pcp, public ExternalRamAllocated
   public:
     void Task();
     void Clear();
-    std::string GetKey(CAN_frame_t* frame);
-
-  protected:
+    uint64_t GetKey(CAN_frame_t* frame);
+    static std::string GetKeyName(uint64_t key);
+    void GetSortedRecords(re_record_list_t& list);
+    uint32_t GetLostFrames();
     void DoAnalyse(CAN_frame_t* frame);
 
   protected:
     TaskHandle_t m_task;
-    QueueHandle_t m_rxqueue;
+    canring_reader* m_rxreader;
 
   public:
     OvmsRecMutex m_mutex;
@@ -102,6 +127,8 @@ class re : public pcp, public ExternalRamAllocated
     uint32_t m_obdii_ext_max;
     uint32_t m_started;
     uint32_t m_finished;
+    uint32_t m_analysed;          // Frames analysed since start/clear
+    int64_t m_analysetime;        // Time spent analysing [us]
   };
 
 #endif //#ifndef __RETOOLS_H__
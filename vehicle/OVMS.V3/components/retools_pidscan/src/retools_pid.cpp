@@ -311,7 +311,9 @@ OvmsReToolsPidScanner::OvmsReToolsPidScanner(
     xTaskCreatePinnedToCore(
         &OvmsReToolsPidScanner::Task, "OVMS RE PID", 4096, this, 5, &m_task, CORE(1)
     );
-    MyCan.RegisterListener(m_rxqueue, true);
+    canfilter* filter = new canfilter();
+    filter->AddFilter('1' + m_bus->m_busnumber, m_rxid_low, m_rxid_high);
+    MyCan.RegisterListener(m_rxqueue, true, "retools-pidscan", filter);
     m_currentPid = m_startPid - m_pidStep;
     MyEvents.RegisterEvent(
         TAG, "ticker.1",
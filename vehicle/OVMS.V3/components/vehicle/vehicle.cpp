@@ -239,6 +239,15 @@ static void OvmsVehicleRxTask(void *pvParameters)
   }
 
 OvmsVehicle::OvmsVehicle()
+  : m_bms_cfg_vmaxgrad("vehicle", "bms.dev.voltage.maxgrad"),
+    m_bms_cfg_vmaxsddev("vehicle", "bms.dev.voltage.maxsddev"),
+    m_bms_cfg_vwarn("vehicle", "bms.dev.voltage.warn"),
+    m_bms_cfg_valert("vehicle", "bms.dev.voltage.alert"),
+    m_bms_cfg_twarn("vehicle", "bms.dev.temp.warn"),
+    m_bms_cfg_talert("vehicle", "bms.dev.temp.alert"),
+    m_bms_cfg_alerts("vehicle", "bms.alerts.enabled"),
+    m_bms_cfg_vlog_interval("vehicle", "bms.log.voltage.interval"),
+    m_bms_cfg_tlog_interval("vehicle", "bms.log.temp.interval")
   {
   using std::placeholders::_1;
   using std::placeholders::_2;
@@ -271,7 +280,6 @@ OvmsVehicle::OvmsVehicle()
   m_vehicleon_ticker = 0;
   m_vehicleoff_ticker = 0;
   m_idle_ticker = 0;
-  m_registeredlistener = false;
   m_autonotifications = true;
   m_ready = false;
 
@@ -279,28 +287,33 @@ OvmsVehicle::OvmsVehicle()
   m_poll_bus_default = NULL;
   m_poll_txcallback = std::bind(&OvmsVehicle::PollerTxCallback, this, _1, _2);
   m_poll_plist = NULL;
-  m_poll_plcur = NULL;
   m_poll_paused = false;
 
   m_poll_vwtp = {};
 
-  m_poll.bus = NULL;
-  m_poll.entry = {};
-  m_poll.ticker = 0;
+  m_poll_timebase = 0;
+  m_poll_sched_changed = false;
+  m_poll_buschannels = false;
+  for (int i = 0; i < VEHICLE_POLL_NCHANNELS; i++)
+    {
+    OvmsPoller::poll_channel_t& ch = m_poll_channel[i];
+    ch.job = {};
+    ch.plcur = NULL;
+    ch.sequence_cnt = 0;
+    ch.wait = 0;
+    ch.tx_data = NULL;
+    ch.tx_remain = 0;
+    ch.tx_offset = 0;
+    ch.tx_frame = 0;
+    ch.txmsgid = 0;
+    ch.sched_tick = 0;
+    ch.sched_idle = false;
+    ch.active = (i == 0);
+    }
   m_poll_single_rxbuf = NULL;
   m_poll_single_rxerr = 0;
-  m_poll.moduleid_sent = 0;
-  m_poll.moduleid_low = 0;
-  m_poll.moduleid_high = 0;
-  m_poll.type = 0;
-  m_poll.pid = 0;
-  m_poll.mlremain = 0;
-  m_poll.mloffset = 0;
-  m_poll.mlframe = 0;
-
-  m_poll_wait = 0;
+
   m_poll_sequence_max = 1;
-  m_poll_sequence_cnt = 0;
   m_poll_fc_septime = 25;       // response default timing: 25 milliseconds
   m_poll_ch_keepalive = 60;     // channel keepalive default: 60 seconds
 
@@ -368,7 +381,7 @@ OvmsVehicle::OvmsVehicle()
   m_inv_energyused = 0;
   m_inv_energyrecd = 0;
 
-  m_rxqueue = xQueueCreate(CONFIG_OVMS_VEHICLE_CAN_RX_QUEUE_SIZE,sizeof(CAN_frame_t));
+  m_rxreader = MyCan.m_ring.AddReader("vehicle", CAN_RING_RX, 0);
   xTaskCreatePinnedToCore(OvmsVehicleRxTask, "OVMS Vehicle",
     CONFIG_OVMS_VEHICLE_RXTASK_STACK, (void*)this, 10, &m_rxtask, CORE(1));
 
@@ -441,14 +454,10 @@ OvmsVehicle::~OvmsVehicle()
     m_bms_talerts = NULL;
     }
 
-  if (m_registeredlistener)
-    {
-    MyCan.DeregisterListener(m_rxqueue);
-    m_registeredlistener = false;
-    }
-
-  vQueueDelete(m_rxqueue);
+  MyCan.m_ring.DetachReader(m_rxreader);
   vTaskDelete(m_rxtask);
+  MyCan.m_ring.RemoveReader(m_rxreader);
+  m_rxreader = NULL;
 
   MyEvents.DeregisterEvent(TAG);
   MyMetrics.DeregisterListener(TAG);
@@ -471,6 +480,7 @@ const char *OvmsVehicle::PollerSource(OvmsVehicle::poller_source_t src)
     case poller_source_t::Primary: return "PRI";
     case poller_source_t::Successful: return "SRX";
     case poller_source_t::OnceOff: return "ONE";
+    case poller_source_t::Scheduled: return "SCH";
     }
     return "XXX";
   }
@@ -478,29 +488,59 @@ const char *OvmsVehicle::PollerSource(OvmsVehicle::poller_source_t src)
 void OvmsVehicle::RxTask()
   {
   CAN_frame_t frame;
+  uint32_t due = 0;             // Deadline scheduler: cached next due time [ms]
+  bool recalc = true;           // Deadline scheduler: due time needs to be recalculated
 
   while(1)
     {
-    if (xQueueReceive(m_rxqueue, &frame, (portTickType)portMAX_DELAY)==pdTRUE)
+    TickType_t wait = portMAX_DELAY;
+    if (m_ready && m_poll_timebase)
+      {
+      // Deadline scheduler: frames must not delay due polls, so check the cached due
+      // time on every loop. The poller state is only consulted (locked) when a poll is
+      // due or the schedule has changed, and at least once per time base unit.
+      uint32_t now = PollerTimeMs();
+      if (!recalc && (int32_t)(now - due) >= 0)
+        {
+        PollerSend(poller_source_t::Scheduled);
+        recalc = true;
+        }
+      if (recalc || m_poll_sched_changed)
+        {
+        int32_t remain = PollerWaitTime();
+        now = PollerTimeMs();
+        if (remain < 0) remain = 0;
+        if (remain > m_poll_timebase) remain = m_poll_timebase;
+        due = now + remain;
+        recalc = false;
+        }
+      int32_t remain = (int32_t)(due - now);
+      wait = (remain > 0) ? (remain + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS : 0;
+      }
+
+    if (m_rxreader->Read(&frame, wait))
       {
       if (!m_ready)
         continue;
 
       // Pass frame to poller protocol handlers:
+      OvmsPoller::poll_channel_t& ch = PollerChannel(frame.origin);
       if (frame.origin == m_poll_vwtp.bus && frame.MsgID == m_poll_vwtp.rxid)
         {
-        PollerVWTPReceive(&frame, frame.MsgID);
+        PollerVWTPReceive(ch, &frame, frame.MsgID);
+        recalc = true;
         }
-      else if (m_poll_wait && frame.origin == m_poll.bus && HasPollList())
+      else if (ch.wait && frame.origin == ch.job.bus && HasPollList())
         {
         uint32_t msgid;
-        if (m_poll.protocol == ISOTP_EXTADR)
+        if (ch.job.protocol == ISOTP_EXTADR)
           msgid = frame.MsgID << 8 | frame.data.u8[0];
         else
           msgid = frame.MsgID;
-        if (msgid >= m_poll.moduleid_low && msgid <= m_poll.moduleid_high)
+        if (msgid >= ch.job.moduleid_low && msgid <= ch.job.moduleid_high)
           {
-          PollerISOTPReceive(&frame, msgid);
+          PollerISOTPReceive(ch, &frame, msgid);
+          recalc = true;
           }
         }
 
@@ -562,11 +602,19 @@ void OvmsVehicle::RegisterCanBus(int bus, CAN_mode_t mode, CAN_speed_t speed, db
       break;
     }
 
-  if (!m_registeredlistener)
-    {
-    m_registeredlistener = true;
-    MyCan.RegisterListener(m_rxqueue);
-    }
+  RegisterCanListener(MyCan.GetBus(bus-1));
+  }
+
+/**
+ * RegisterCanListener: make sure the vehicle receives frames from a CAN bus
+ *  - the vehicle reader only passes frames from buses registered here,
+ *    so other bus traffic does not wake up the vehicle task
+ */
+void OvmsVehicle::RegisterCanListener(canbus* bus)
+  {
+  if (bus == NULL || m_rxreader == NULL)
+    return;
+  m_rxreader->m_busmask |= 1 << bus->m_busnumber;
   }
 
 bool OvmsVehicle::PinCheck(const char* pin)
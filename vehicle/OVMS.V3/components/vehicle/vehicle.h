@@ -42,6 +42,7 @@
 #include "metrics_standard.h"
 #include "ovms_mutex.h"
 #include "ovms_semaphore.h"
+#include "vehicle_poller_sched.h"
 
 using namespace std;
 struct DashboardConfig;
@@ -191,6 +192,9 @@ struct DashboardConfig;
 // Number of polling states supported
 #define VEHICLE_POLL_NSTATES            4
 
+// Number of poll channels (one per CAN bus, see PollSetBusChannels())
+#define VEHICLE_POLL_NCHANNELS          4
+
 // Macro for poll_pid_t termination
 #define POLL_LIST_END                   { 0, 0, 0x00, 0x00, { 0, 0, 0 }, 0, 0 }
 
@@ -308,7 +312,7 @@ namespace OvmsPoller
         const uint8_t* data;                  // pointer to payload data (single/multi frame request)
         } xargs;
       };
-    uint16_t polltime[VEHICLE_POLL_NSTATES];  // poll intervals in seconds for used poll states
+    uint16_t polltime[VEHICLE_POLL_NSTATES];  // poll intervals in seconds (see PollSetTimeBase()) for used poll states
     uint8_t  pollbus;                         // 0 = default CAN bus from PollSetPidList(), 1…4 = specific
     uint8_t  protocol;                        // ISOTP_STD / ISOTP_EXTADR / ISOTP_EXTFRAME / VWTP_20
     } poll_pid_t;
@@ -329,6 +333,31 @@ namespace OvmsPoller
     OvmsPoller::poll_pid_t entry; ///< Currently processed entry of poll list (copy)
     uint32_t ticker;        ///< Polling tick count
     } poll_job_t;
+
+  typedef struct
+    {
+    poll_job_t job;                   // Request state, passed to the Incoming… handlers
+    const poll_pid_t* plcur;          // Poll list loop cursor
+    uint8_t sequence_cnt;             // Polls already sent in the current time tick
+    uint8_t wait;                     // Wait counter for a reply from a sent poll or bytes remaining.
+                                      // Gets set = 2 when a poll is sent OR when bytes are remaining after receiving.
+                                      // Gets set = 0 when a poll is received.
+                                      // Gets decremented with every second/tick in PollerSend().
+                                      // PollerSend() aborts when > 0.
+                                      // Why set = 2: When a poll gets send just before the next ticker occurs
+                                      //              PollerSend() decrements to 1 and doesn't send the next poll.
+                                      //              Only when the reply doesn't get in until the next ticker occurs
+                                      //              PollserSend() decrements to 0 and abandons the outstanding reply (=timeout)
+    const uint8_t* tx_data;           // Payload data for multi frame request
+    uint16_t tx_remain;               // Payload bytes remaining for multi frame request
+    uint16_t tx_offset;               // Payload offset of multi frame request
+    uint16_t tx_frame;                // Frame number for multi frame request
+    uint32_t txmsgid;                 // Last TX CAN ID (frame MsgID)
+    OvmsPollScheduler sched;          // Deadline scheduler: channel entries by next due time
+    uint32_t sched_tick;              // Deadline scheduler: current time base tick (throttling)
+    bool sched_idle;                  // Deadline scheduler: no entry due (PollRunFinished() called)
+    bool active;                      // Channel has entries in the current list & state
+    } poll_channel_t;
   }
 
 class OvmsVehicle : public InternalRamAllocated
@@ -342,9 +371,8 @@ class OvmsVehicle : public InternalRamAllocated
     virtual const char* VehicleType();
 
   protected:
-    QueueHandle_t m_rxqueue;
+    canring_reader* m_rxreader;             // CAN frames for the buses registered
     TaskHandle_t m_rxtask;
-    bool m_registeredlistener;
     bool m_autonotifications;
     bool m_ready;
 
@@ -359,8 +387,9 @@ class OvmsVehicle : public InternalRamAllocated
     void VehicleConfigChanged(std::string event, void* data);
     void PollerResetThrottle();
 
-    typedef enum { Primary, Successful, OnceOff } poller_source_t;
+    typedef enum { Primary, Successful, OnceOff, Scheduled } poller_source_t;
     void PollerSend(poller_source_t source);
+    void PollerSend(OvmsPoller::poll_channel_t& ch, poller_source_t source);
     static const char *PollerSource(OvmsVehicle::poller_source_t src);
 
   protected:
@@ -520,6 +549,7 @@ class OvmsVehicle : public InternalRamAllocated
 
   protected:
     void RegisterCanBus(int bus, CAN_mode_t mode, CAN_speed_t speed, dbcfile* dbcfile = NULL);
+    void RegisterCanListener(canbus* bus);
     bool PinCheck(const char* pin);
 
   public:
@@ -604,23 +634,11 @@ class OvmsVehicle : public InternalRamAllocated
     bool              m_poll_paused;          // Processing the poll list is paused
 
     const OvmsPoller::poll_pid_t* m_poll_plist;           // Head of poll list
-    const OvmsPoller::poll_pid_t* m_poll_plcur;           // Poll list loop cursor
-    // Poll state for received data.
-    OvmsPoller::poll_job_t m_poll;
-
-    const uint8_t*    m_poll_tx_data;         // Payload data for multi frame request
-    uint16_t          m_poll_tx_remain;       // Payload bytes remaining for multi frame request
-    uint16_t          m_poll_tx_offset;       // Payload offset of multi frame request
-    uint16_t          m_poll_tx_frame;        // Frame number for multi frame request
-    uint8_t           m_poll_wait;            // Wait counter for a reply from a sent poll or bytes remaining.
-                                              // Gets set = 2 when a poll is sent OR when bytes are remaining after receiving.
-                                              // Gets set = 0 when a poll is received.
-                                              // Gets decremented with every second/tick in PollerSend().
-                                              // PollerSend() aborts when > 0.
-                                              // Why set = 2: When a poll gets send just before the next ticker occurs
-                                              //              PollerSend() decrements to 1 and doesn't send the next poll.
-                                              //              Only when the reply doesn't get in until the next ticker occurs
-                                              //              PollserSend() decrements to 0 and abandons the outstanding reply (=timeout)
+    uint16_t          m_poll_timebase;        // Deadline scheduler: milliseconds per polltime unit, 0 = per second list scan
+    volatile bool     m_poll_sched_changed;   // Deadline scheduler: schedule changed, vehicle task needs to recalculate its wait time
+    bool              m_poll_buschannels;     // true = one poll channel per bus, false = channel 0 only
+    // Poll channels (request state):
+    OvmsPoller::poll_channel_t m_poll_channel[VEHICLE_POLL_NCHANNELS];
 
 
   protected:
@@ -628,11 +646,19 @@ class OvmsVehicle : public InternalRamAllocated
     void ResetPollEntry();
     bool HasPollList();
 
-    OvmsNextPollResult NextPollEntry(OvmsPoller::poll_pid_t *entry);
-    void PollerNextTick(poller_source_t source);
+    OvmsNextPollResult NextPollEntry(OvmsPoller::poll_channel_t& ch, OvmsPoller::poll_pid_t *entry);
+    void PollerNextTick(OvmsPoller::poll_channel_t& ch, poller_source_t source);
+    void PollerScheduleReset();
+    static uint32_t PollerTimeMs();
+    int32_t PollerWaitTime();
+    canbus* PollerEntryBus(const OvmsPoller::poll_pid_t* entry);
+    OvmsPoller::poll_channel_t& PollerChannel(canbus* bus);
+    bool PollerEntryOnChannel(const OvmsPoller::poll_pid_t* entry, const OvmsPoller::poll_channel_t& ch);
+    int PollerChannelCount() { return m_poll_buschannels ? VEHICLE_POLL_NCHANNELS : 1; }
 
     // Check for throttling.
     bool CanPoll();
+    bool CanPoll(const OvmsPoller::poll_channel_t& ch);
 
     void PausePolling();
     void ResumePolling();
@@ -643,8 +669,7 @@ class OvmsVehicle : public InternalRamAllocated
     virtual void IncomingPollTxCallback(const OvmsPoller::poll_job_t &job, bool success);
 
   private:
-    uint8_t           m_poll_sequence_max;    // Polls allowed to be sent in sequence per time tick (second), default 1, 0 = no limit
-    uint8_t           m_poll_sequence_cnt;    // Polls already sent in the current time tick (second)
+    uint8_t           m_poll_sequence_max;    // Polls allowed to be sent in sequence per time tick (second) & channel, default 1, 0 = no limit
     uint8_t           m_poll_fc_septime;      // Flow control separation time for multi frame responses
     uint16_t          m_poll_ch_keepalive;    // Seconds to keep an inactive channel (e.g. VWTP) alive (default: 60)
 
@@ -661,10 +686,12 @@ class OvmsVehicle : public InternalRamAllocated
     void PollSetPidList(canbus* bus, const OvmsPoller::poll_pid_t* plist);
     void PollSetPidList( const OvmsPoller::poll_pid_t* plist)
       {
-      PollSetPidList(m_poll.bus, plist);
+      PollSetPidList(m_poll_bus_default, plist);
       }
     void PollSetState(uint8_t state);
     void PollSetThrottling(uint8_t sequence_max);
+    void PollSetTimeBase(uint16_t timebase_ms);
+    void PollSetBusChannels(bool enable);
     void PollSetResponseSeparationTime(uint8_t septime);
     void PollSetChannelKeepalive(uint16_t keepalive_seconds);
     int PollSingleRequest(canbus* bus, uint32_t txid, uint32_t rxid,
@@ -676,19 +703,18 @@ class OvmsVehicle : public InternalRamAllocated
     const char* PollResultCodeName(int code);
 
   private:
-    void PollerISOTPStart(bool fromTicker);
-    bool PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid);
+    void PollerISOTPStart(OvmsPoller::poll_channel_t& ch, bool fromTicker);
+    bool PollerISOTPReceive(OvmsPoller::poll_channel_t& ch, CAN_frame_t* frame, uint32_t msgid);
 
   private:
-    void PollerVWTPStart(bool fromTicker);
-    bool PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid);
-    void PollerVWTPEnter(vwtp_channelstate_t state);
-    void PollerVWTPTicker();
-    void PollerVWTPTxCallback(const CAN_frame_t* frame, bool success);
+    void PollerVWTPStart(OvmsPoller::poll_channel_t& ch, bool fromTicker);
+    bool PollerVWTPReceive(OvmsPoller::poll_channel_t& ch, CAN_frame_t* frame, uint32_t msgid);
+    void PollerVWTPEnter(OvmsPoller::poll_channel_t& ch, vwtp_channelstate_t state);
+    void PollerVWTPTicker(OvmsPoller::poll_channel_t& ch);
+    void PollerVWTPTxCallback(OvmsPoller::poll_channel_t& ch, const CAN_frame_t* frame, bool success);
 
   private:
     CanFrameCallback  m_poll_txcallback;      // Poller CAN TxCallback
-    uint32_t          m_poll_txmsgid;         // Poller last TX CAN ID (frame MsgID)
 
   private:
     void PollerTxCallback(const CAN_frame_t* frame, bool success);
@@ -730,6 +756,15 @@ class OvmsVehicle : public InternalRamAllocated
     float m_bms_defthr_valert;                // Default voltage deviation alert threshold [V]
     float m_bms_defthr_twarn;                 // Default temperature deviation warn threshold [°C]
     float m_bms_defthr_talert;                // Default temperature deviation alert threshold [°C]
+    OvmsConfigValue<float> m_bms_cfg_vmaxgrad;    // Config: voltage deviation max valid gradient [V]
+    OvmsConfigValue<float> m_bms_cfg_vmaxsddev;   // Config: voltage deviation max valid stddev deviation [V]
+    OvmsConfigValue<float> m_bms_cfg_vwarn;       // Config: voltage deviation warn threshold [V]
+    OvmsConfigValue<float> m_bms_cfg_valert;      // Config: voltage deviation alert threshold [V]
+    OvmsConfigValue<float> m_bms_cfg_twarn;       // Config: temperature deviation warn threshold [°C]
+    OvmsConfigValue<float> m_bms_cfg_talert;      // Config: temperature deviation alert threshold [°C]
+    OvmsConfigValue<bool> m_bms_cfg_alerts;       // Config: BMS alert notifications enabled
+    OvmsConfigValue<int> m_bms_cfg_vlog_interval; // Config: cell voltage log interval [s]
+    OvmsConfigValue<int> m_bms_cfg_tlog_interval; // Config: cell temperature log interval [s]
     uint32_t m_bms_vlog_last;                 // Last log time for voltages
     uint32_t m_bms_tlog_last;                 // Last log time for temperatures
 
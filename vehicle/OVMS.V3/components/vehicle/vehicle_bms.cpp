@@ -69,7 +69,19 @@ void OvmsVehicle::BmsSetCellArrangementVoltage(int readings, int readingspermodu
   m_bms_readings_v = readings;
   m_bms_readingspermodule_v = readingspermodule;
 
+  // Cell min/max voltages are persistent, keep them if they match the arrangement:
+  std::vector<float> vmins = StandardMetrics.ms_v_bat_cell_vmin->AsVector();
+  std::vector<float> vmaxs = StandardMetrics.ms_v_bat_cell_vmax->AsVector();
+
   BmsResetCellVoltages(true);
+
+  if (vmins.size() == (size_t)readings && vmaxs.size() == (size_t)readings)
+    {
+    std::copy(vmins.begin(), vmins.end(), m_bms_vmins);
+    std::copy(vmaxs.begin(), vmaxs.end(), m_bms_vmaxs);
+    StandardMetrics.ms_v_bat_cell_vmin->SetElemValues(0, readings, m_bms_vmins);
+    StandardMetrics.ms_v_bat_cell_vmax->SetElemValues(0, readings, m_bms_vmaxs);
+    }
   }
 
 // Internal entry for changing cell arrangements.
@@ -281,24 +293,20 @@ void OvmsVehicle::BmsSetCellVoltage(int index, float value)
   if ((value<m_bms_limit_vmin)||(value>m_bms_limit_vmax)) return;
   m_bms_voltages[index] = value;
 
-  if (! m_bms_has_voltages)
-    {
-    m_bms_vmins[index] = value;
-    m_bms_vmaxs[index] = value;
-    }
-  else if (m_bms_vmins[index] > value)
+  // min/max 0 = unset (after a reset, unless restored from persistence):
+  if (m_bms_vmins[index] == 0 || m_bms_vmins[index] > value)
     m_bms_vmins[index] = value;
-  else if (m_bms_vmaxs[index] < value)
+  if (m_bms_vmaxs[index] == 0 || m_bms_vmaxs[index] < value)
     m_bms_vmaxs[index] = value;
 
   if (m_bms_bitset_v[index] == false) m_bms_bitset_cv++;
   if (m_bms_bitset_cv == m_bms_readings_v)
     {
     // Series complete, all cell voltages acquired
-    float thr_maxgrad  = MyConfig.GetParamValueFloat("vehicle", "bms.dev.voltage.maxgrad",  m_bms_defthr_vmaxgrad);
-    float thr_maxsddev = MyConfig.GetParamValueFloat("vehicle", "bms.dev.voltage.maxsddev", m_bms_defthr_vmaxsddev);
-    float thr_warn     = MyConfig.GetParamValueFloat("vehicle", "bms.dev.voltage.warn",     m_bms_defthr_vwarn);
-    float thr_alert    = MyConfig.GetParamValueFloat("vehicle", "bms.dev.voltage.alert",    m_bms_defthr_valert);
+    float thr_maxgrad  = m_bms_cfg_vmaxgrad.Get(m_bms_defthr_vmaxgrad);
+    float thr_maxsddev = m_bms_cfg_vmaxsddev.Get(m_bms_defthr_vmaxsddev);
+    float thr_warn     = m_bms_cfg_vwarn.Get(m_bms_defthr_vwarn);
+    float thr_alert    = m_bms_cfg_valert.Get(m_bms_defthr_valert);
 
     // Get min, max, avg & standard deviation:
     double sum=0, sqrsum=0, avg, stddev=0;
@@ -417,8 +425,8 @@ void OvmsVehicle::BmsSetCellTemperature(int index, float value)
   if (m_bms_bitset_ct == m_bms_readings_t)
     {
     // Series complete, all cell temperatures acquired
-    float thr_warn  = MyConfig.GetParamValueFloat("vehicle", "bms.dev.temp.warn", m_bms_defthr_twarn);
-    float thr_alert = MyConfig.GetParamValueFloat("vehicle", "bms.dev.temp.alert", m_bms_defthr_talert);
+    float thr_warn  = m_bms_cfg_twarn.Get(m_bms_defthr_twarn);
+    float thr_alert = m_bms_cfg_talert.Get(m_bms_defthr_talert);
 
     // get min, max, avg & standard deviation:
     double sum=0, sqrsum=0, avg, stddev=0;
@@ -846,14 +854,14 @@ void OvmsVehicle::BmsTicker()
     {
     ESP_LOGW(TAG, "BMS new alerts: %d voltages, %d temperatures", m_bms_valerts_new, m_bms_talerts_new);
     MyEvents.SignalEvent("vehicle.alert.bms", NULL);
-    if (m_autonotifications && MyConfig.GetParamValueBool("vehicle", "bms.alerts.enabled", true))
+    if (m_autonotifications && m_bms_cfg_alerts.Get(true))
       NotifyBmsAlerts();
     m_bms_valerts_new = 0;
     m_bms_talerts_new = 0;
     }
 
   // Log cell voltages:
-  int vlog_interval = MyConfig.GetParamValueInt("vehicle", "bms.log.voltage.interval", 0);
+  int vlog_interval = m_bms_cfg_vlog_interval.Get(0);
   if (vlog_interval > 0 && m_bms_vlog_last + vlog_interval < monotonictime &&
       StdMetrics.ms_v_bat_cell_voltage->LastModified() > m_bms_vlog_last)
     {
@@ -870,7 +878,7 @@ void OvmsVehicle::BmsTicker()
     }
 
   // Log cell temperatures:
-  int tlog_interval = MyConfig.GetParamValueInt("vehicle", "bms.log.temp.interval", 0);
+  int tlog_interval = m_bms_cfg_tlog_interval.Get(0);
   if (tlog_interval > 0 && m_bms_tlog_last + tlog_interval < monotonictime &&
       StdMetrics.ms_v_bat_cell_temp->LastModified() > m_bms_tlog_last)
     {
@@ -43,6 +43,7 @@ static const char *TAG = "vehicle-poll";
 #endif // #ifdef CONFIG_OVMS_COMP_WEBSERVER
 #include <ovms_peripherals.h>
 #include <string_writer.h>
+#include "esp_timer.h"
 #include "vehicle.h"
 
 
@@ -122,13 +123,19 @@ void OvmsVehicle::PollSetPidList(canbus* bus, const OvmsPoller::poll_pid_t* plis
   {
   OvmsRecMutexLock slock(&m_poll_single_mutex);
   OvmsRecMutexLock lock(&m_poll_mutex);
-  m_poll.bus = bus;
   m_poll_bus_default = bus;
+  RegisterCanListener(bus);
   m_poll_plist = plist;
-  m_poll.ticker = 0;
-  m_poll_sequence_cnt = 0;
-  m_poll_wait = 0;
+  for (int i = 0; i < VEHICLE_POLL_NCHANNELS; i++)
+    {
+    OvmsPoller::poll_channel_t& ch = m_poll_channel[i];
+    ch.job.bus = bus;
+    ch.job.ticker = 0;
+    ch.sequence_cnt = 0;
+    ch.wait = 0;
+    }
   ResetPollEntry();
+  PollerScheduleReset();
   }
 
 
@@ -148,12 +155,15 @@ void OvmsVehicle::PollSetState(uint8_t state)
     OvmsRecMutexLock slock(&m_poll_single_mutex);
     OvmsRecMutexLock lock(&m_poll_mutex);
     m_poll_state = state;
-    m_poll.ticker = 0;
-    m_poll_sequence_cnt = 0;
-    m_poll_wait = 0;
-    m_poll_plcur = NULL;
-    m_poll.entry = {};
-    m_poll_txmsgid = 0;
+    for (int i = 0; i < VEHICLE_POLL_NCHANNELS; i++)
+      {
+      OvmsPoller::poll_channel_t& ch = m_poll_channel[i];
+      ch.job.ticker = 0;
+      ch.sequence_cnt = 0;
+      ch.wait = 0;
+      }
+    ResetPollEntry();
+    PollerScheduleReset();
     }
   }
 
@@ -162,7 +172,8 @@ void OvmsVehicle::PollSetState(uint8_t state)
  * PollSetThrottling: configure polling speed / niceness
  *  If multiple requests are due at the same poll tick (second), this controls how many of
  *  them will be sent in series without a delay, i.e. as soon as the response/timeout for
- *  the previous request occurred.
+ *  the previous request occurred. With bus channels (see PollSetBusChannels()), the limit
+ *  applies per channel.
  *  
  *  @param sequence_max
  *    Polls allowed to be sent in sequence per time tick (second), default 1, 0 = no limit.
@@ -176,6 +187,79 @@ void OvmsVehicle::PollSetThrottling(uint8_t sequence_max)
   }
 
 
+/**
+ * PollSetTimeBase: configure the deadline scheduler
+ *  By default, the poller advances once per second and scans the poll list for the
+ *  entries due in that second (polltime in seconds, ticker modulo polltime).
+ *  Setting a time base switches to the deadline scheduler: the entries of the current
+ *  state are kept ordered by their next due time and sent by the vehicle task as soon
+ *  as they are due, with the polltime values interpreted in units of the time base.
+ *  This allows intervals below one second. The first round after PollSetPidList() or
+ *  PollSetState() polls all entries in list order; after that, entries of equal
+ *  interval are spread over the interval to avoid bursts.
+ *  
+ *  With the deadline scheduler, PollSetThrottling() limits the polls sent per time base
+ *  unit, PollRunFinished() is called each time all due entries have been sent, and
+ *  job.ticker counts seconds. The response timeout stays at 1-2 seconds.
+ *  
+ *  @param timebase_ms
+ *    Milliseconds per polltime unit (e.g. 100 = polltime in tenths of seconds),
+ *    0 = once per second list scan (default)
+ *  
+ *  The configuration is kept unchanged over calls to PollSetPidList() or PollSetState().
+ */
+void OvmsVehicle::PollSetTimeBase(uint16_t timebase_ms)
+  {
+  OvmsRecMutexLock lock(&m_poll_mutex);
+  m_poll_timebase = timebase_ms;
+  for (int i = 0; i < VEHICLE_POLL_NCHANNELS; i++)
+    {
+    m_poll_channel[i].job.ticker = 0;
+    m_poll_channel[i].sequence_cnt = 0;
+    }
+  ResetPollEntry();
+  PollerScheduleReset();
+  }
+
+
+/**
+ * PollSetBusChannels: poll the CAN buses in parallel
+ *  By default, the poller processes one request at a time, so a slow or unresponsive
+ *  ECU on one bus delays the polls on all other buses. Enabling bus channels gives
+ *  each CAN bus its own poll channel with its own list cursor, schedule, throttling
+ *  and response timeout, so one request per bus can be pending at the same time.
+ *  Poll entries are assigned to the channel of their bus (pollbus, or the default
+ *  bus for pollbus 0); entries for a bus not registered are skipped.
+ *  
+ *  Responses are still delivered via IncomingPollReply() & IncomingPollError() from the
+ *  vehicle task, but replies from different buses may now interleave. Vehicles enabling
+ *  this must keep their multi frame reassembly state per job.bus, and should expect
+ *  PollRunFinished() and job.ticker to be per channel.
+ *  
+ *  There is only one VW-TP 2.0 connection, so VW-TP entries should all use the same bus.
+ *  
+ *  @param enable
+ *    true = one poll channel per CAN bus, false = single channel for all buses (default)
+ *  
+ *  The configuration is kept unchanged over calls to PollSetPidList() or PollSetState().
+ */
+void OvmsVehicle::PollSetBusChannels(bool enable)
+  {
+  OvmsRecMutexLock slock(&m_poll_single_mutex);
+  OvmsRecMutexLock lock(&m_poll_mutex);
+  m_poll_buschannels = enable;
+  for (int i = 0; i < VEHICLE_POLL_NCHANNELS; i++)
+    {
+    OvmsPoller::poll_channel_t& ch = m_poll_channel[i];
+    ch.job.ticker = 0;
+    ch.sequence_cnt = 0;
+    ch.wait = 0;
+    }
+  ResetPollEntry();
+  PollerScheduleReset();
+  }
+
+
 /**
  * PollSetResponseSeparationTime: configure ISO TP multi frame response timing
  *  See: https://en.wikipedia.org/wiki/ISO_15765-2
@@ -218,14 +302,19 @@ void OvmsVehicle::PollSetChannelKeepalive(uint16_t keepalive_seconds)
 void OvmsVehicle::PollerResetThrottle()
   {
   // Main Timer reset throttling counter,
-  m_poll_sequence_cnt = 0;
+  for (int i = 0; i < VEHICLE_POLL_NCHANNELS; i++)
+    m_poll_channel[i].sequence_cnt = 0;
   }
 
 void OvmsVehicle::ResetPollEntry()
   {
-  m_poll_plcur = NULL;
-  m_poll.entry = {};
-  m_poll_txmsgid = 0;
+  for (int i = 0; i < VEHICLE_POLL_NCHANNELS; i++)
+    {
+    OvmsPoller::poll_channel_t& ch = m_poll_channel[i];
+    ch.plcur = NULL;
+    ch.job.entry = {};
+    ch.txmsgid = 0;
+    }
   }
 
 bool OvmsVehicle::HasPollList()
@@ -236,9 +325,50 @@ bool OvmsVehicle::HasPollList()
   }
 
 bool OvmsVehicle::CanPoll()
+  {
+  return CanPoll(m_poll_channel[0]);
+  }
+
+bool OvmsVehicle::CanPoll(const OvmsPoller::poll_channel_t& ch)
   {
   // Check Throttle
-  return (!m_poll_sequence_max || m_poll_sequence_cnt < m_poll_sequence_max);
+  return (!m_poll_sequence_max || ch.sequence_cnt < m_poll_sequence_max);
+  }
+
+/**
+ * PollerEntryBus: internal: get the CAN bus of a poll list entry (NULL = not registered)
+ */
+canbus* OvmsVehicle::PollerEntryBus(const OvmsPoller::poll_pid_t* entry)
+  {
+  switch (entry->pollbus)
+    {
+    case 1:   return m_can1;
+    case 2:   return m_can2;
+    case 3:   return m_can3;
+    case 4:   return m_can4;
+    default:  return m_poll_bus_default;
+    }
+  }
+
+/**
+ * PollerChannel: internal: get the poll channel serving a CAN bus
+ */
+OvmsPoller::poll_channel_t& OvmsVehicle::PollerChannel(canbus* bus)
+  {
+  if (m_poll_buschannels && bus && bus->m_busnumber >= 0 && bus->m_busnumber < VEHICLE_POLL_NCHANNELS)
+    return m_poll_channel[bus->m_busnumber];
+  return m_poll_channel[0];
+  }
+
+/**
+ * PollerEntryOnChannel: internal: check if a poll list entry is served by a channel
+ */
+bool OvmsVehicle::PollerEntryOnChannel(const OvmsPoller::poll_pid_t* entry, const OvmsPoller::poll_channel_t& ch)
+  {
+  if (!m_poll_buschannels)
+    return true;
+  canbus* bus = PollerEntryBus(entry);
+  return (bus != NULL) && (&PollerChannel(bus) == &ch);
   }
 /** Pause polling - don't progress through the poll list.
  */
@@ -256,41 +386,132 @@ void OvmsVehicle::ResumePolling()
   m_poll_paused = false;
   }
 
-OvmsVehicle::OvmsNextPollResult OvmsVehicle::NextPollEntry(OvmsPoller::poll_pid_t *entry)
+/**
+ * PollerScheduleReset: internal: (re)assign the entries of the current list & state
+ *  to the poll channels, and (re)build the deadline schedules
+ */
+void OvmsVehicle::PollerScheduleReset()
+  {
+  m_poll_sched_changed = true;
+  for (int i = 0; i < VEHICLE_POLL_NCHANNELS; i++)
+    {
+    OvmsPoller::poll_channel_t& ch = m_poll_channel[i];
+    ch.sched.Clear();
+    ch.sched_idle = false;
+    ch.active = (i == 0 && !m_poll_buschannels);
+    }
+  if (!m_poll_plist)
+    return;
+  uint32_t now = PollerTimeMs();
+  uint16_t index = 0;
+  for (const OvmsPoller::poll_pid_t* p = m_poll_plist; p->txmoduleid != 0; p++, index++)
+    {
+    if (p->polltime[m_poll_state] == 0)
+      continue;
+    if (m_poll_buschannels && !PollerEntryBus(p))
+      continue;
+    OvmsPoller::poll_channel_t& ch = PollerChannel(PollerEntryBus(p));
+    ch.active = true;
+    if (m_poll_timebase)
+      ch.sched.Add(index, (uint32_t)p->polltime[m_poll_state] * m_poll_timebase, now);
+    }
+  }
+
+/**
+ * PollerTimeMs: internal: deadline scheduler time base (free running milliseconds)
+ */
+uint32_t OvmsVehicle::PollerTimeMs()
+  {
+  return (uint32_t)(esp_timer_get_time() / 1000);
+  }
+
+/**
+ * PollerWaitTime: internal: milliseconds until the next scheduled poll is due
+ *  Returns INT32_MAX if no poll is due (no schedule, or all channels are waiting
+ *  for a response). Called by the vehicle task only on schedule changes and due
+ *  times, the result is cached there.
+ */
+int32_t OvmsVehicle::PollerWaitTime()
+  {
+  if (!m_poll_timebase || !m_ready)
+    return INT32_MAX;
+  OvmsRecMutexLock lock(&m_poll_mutex);
+  m_poll_sched_changed = false;
+  if (m_poll_paused || !HasPollList())
+    return INT32_MAX;
+  uint32_t now = PollerTimeMs();
+  int32_t wait = INT32_MAX;
+  for (int i = 0; i < PollerChannelCount(); i++)
+    {
+    const OvmsPoller::poll_channel_t& ch = m_poll_channel[i];
+    if (ch.wait > 0 || ch.sched.Empty())
+      continue;
+    int32_t chwait;
+    if (!CanPoll(ch) && (now / m_poll_timebase) == ch.sched_tick)
+      chwait = m_poll_timebase - (now % m_poll_timebase); // throttled: wait for the next time base tick
+    else
+      chwait = ch.sched.TimeToDue(now);
+    if (chwait < wait)
+      wait = chwait;
+    }
+  return wait;
+  }
+
+OvmsVehicle::OvmsNextPollResult OvmsVehicle::NextPollEntry(OvmsPoller::poll_channel_t& ch, OvmsPoller::poll_pid_t *entry)
   {
   *entry = {};
+
+  if (m_poll_timebase)
+    {
+    // Deadline scheduler: get the next due entry
+    int index = ch.sched.Pop(PollerTimeMs());
+    if (index < 0)
+      {
+      if (ch.sched_idle)
+        return OvmsNextPollResult::StillAtEnd;
+      ch.sched_idle = true;
+      return OvmsNextPollResult::ReachedEnd;
+      }
+    ch.sched_idle = false;
+    ch.plcur = m_poll_plist + index;
+    *entry = *ch.plcur;
+    return OvmsNextPollResult::FoundEntry;
+    }
+
   // Restart poll list cursor:
-  if (m_poll_plcur == NULL)
-    m_poll_plcur = m_poll_plist;
-  else if (m_poll_plcur->txmoduleid == 0)
+  if (ch.plcur == NULL)
+    ch.plcur = m_poll_plist;
+  else if (ch.plcur->txmoduleid == 0)
     return OvmsNextPollResult::StillAtEnd;
   else
-    ++m_poll_plcur;
+    ++ch.plcur;
 
-  while (m_poll_plcur->txmoduleid != 0)
+  while (ch.plcur->txmoduleid != 0)
     {
-    if ((m_poll_plcur->polltime[m_poll_state] > 0) &&
-        ((m_poll.ticker % m_poll_plcur->polltime[m_poll_state]) == 0))
+    if ((ch.plcur->polltime[m_poll_state] > 0) &&
+        ((ch.job.ticker % ch.plcur->polltime[m_poll_state]) == 0) &&
+        PollerEntryOnChannel(ch.plcur, ch))
       {
-      *entry = *m_poll_plcur;
+      *entry = *ch.plcur;
       return OvmsNextPollResult::FoundEntry;
       }
     // Poll entry is not due, check next
-    ++m_poll_plcur;
+    ++ch.plcur;
     }
   return OvmsNextPollResult::ReachedEnd;
   }
 
-void OvmsVehicle::PollerNextTick(poller_source_t source)
+void OvmsVehicle::PollerNextTick(OvmsPoller::poll_channel_t& ch, poller_source_t source)
   {
-  // Completed checking all poll entries for the current m_poll_ticker
-  ESP_LOGD(TAG, "PollerSend(%s): cycle complete for ticker=%u", PollerSource(source), m_poll.ticker);
+  // Completed checking all poll entries for the current ticker
+  ESP_LOGD(TAG, "PollerSend(%s)[%d]: cycle complete for ticker=%u",
+    PollerSource(source), (int)(&ch - m_poll_channel), ch.job.ticker);
 
   // Allow POLL to restart.
-  m_poll_plcur = NULL;
+  ch.plcur = NULL;
 
-  m_poll.ticker++;
-  if (m_poll.ticker > 3600) m_poll.ticker -= 3600;
+  ch.job.ticker++;
+  if (ch.job.ticker > 3600) ch.job.ticker -= 3600;
   }
 
 /** Called after reaching the end of available POLL entries.
@@ -300,15 +521,23 @@ void OvmsVehicle::PollRunFinished()
   }
 
 /**
- * PollerSend: internal: start next due request
+ * PollerSend: internal: start next due requests on all poll channels
  */
 void OvmsVehicle::PollerSend(poller_source_t source)
   {
   OvmsRecMutexLock lock(&m_poll_mutex);
+  for (int i = 0; i < PollerChannelCount(); i++)
+    PollerSend(m_poll_channel[i], source);
+  if (source != poller_source_t::Scheduled)
+    m_poll_sched_changed = true;
+  }
 
-  // ESP_LOGD(TAG, "PollerSend(%d): entry at[type=%02X, pid=%X], ticker=%u, wait=%u, cnt=%u/%u",
-  //          fromTicker, m_poll_plcur->type, m_poll_plcur->pid,
-  //          m_poll_ticker, m_poll_wait, m_poll_sequence_cnt, m_poll_sequence_max);
+/**
+ * PollerSend: internal: start next due request on a poll channel
+ */
+void OvmsVehicle::PollerSend(OvmsPoller::poll_channel_t& ch, poller_source_t source)
+  {
+  OvmsRecMutexLock lock(&m_poll_mutex);
 
   bool fromPrimaryTicker = false, fromOnceOffTicker = false;
   switch (source)
@@ -325,74 +554,77 @@ void OvmsVehicle::PollerSend(poller_source_t source)
   if (fromPrimaryTicker)
     {
     // Timer ticker call: reset throttling counter
-    PollerResetThrottle();
+    ch.sequence_cnt = 0;
 
+    if (m_poll_timebase)
+      {
+      // Deadline scheduler: the ticker counts seconds
+      ch.job.ticker++;
+      if (ch.job.ticker > 3600) ch.job.ticker -= 3600;
+      }
     // Only reset the list when 'from Ticker' and it's at the end.
-    if (m_poll_plcur && m_poll_plcur->txmoduleid == 0)
+    else if (ch.plcur && ch.plcur->txmoduleid == 0)
+      {
+      PollerNextTick(ch, source);
+      }
+    }
+  if (m_poll_timebase)
+    {
+    // Deadline scheduler: throttling applies per time base tick
+    uint32_t tick = PollerTimeMs() / m_poll_timebase;
+    if (tick != ch.sched_tick)
       {
-      PollerNextTick(source);
+      ch.sched_tick = tick;
+      ch.sequence_cnt = 0;
       }
+    if (source == poller_source_t::Scheduled && !CanPoll(ch)) return;
     }
   if (fromPrimaryTicker || fromOnceOffTicker)
     {
     // Timer ticker call: check response timeout
-    if (m_poll_wait > 0) m_poll_wait--;
+    if (ch.wait > 0) ch.wait--;
 
     // Protocol specific ticker calls:
-    PollerVWTPTicker();
+    if (&ch == &PollerChannel(m_poll_vwtp.bus))
+      PollerVWTPTicker(ch);
     }
-  if (m_poll_wait > 0) return;
+  if (ch.wait > 0) return;
 
   // Check poll bus & list:
-  if (!HasPollList()) return;
+  if (!HasPollList() || !ch.active) return;
 
   if (m_poll_paused) return;
 
-  switch (NextPollEntry(&m_poll.entry))
+  switch (NextPollEntry(ch, &ch.job.entry))
     {
     case OvmsNextPollResult::ReachedEnd:
       PollRunFinished();
       // fall through
     case OvmsNextPollResult::StillAtEnd:
       {
-      PollerNextTick(source);
+      if (!m_poll_timebase)
+        PollerNextTick(ch, source);
       break;
       }
     case OvmsNextPollResult::FoundEntry:
       {
-      ESP_LOGD(TAG, "PollerSend(%s)[%d]: entry at[type=%02X, pid=%X], ticker=%u, wait=%u, cnt=%u/%u",
-             PollerSource(source), m_poll_state, m_poll.entry.type, m_poll.entry.pid,
-             m_poll.ticker, m_poll_wait, m_poll_sequence_cnt, m_poll_sequence_max);
+      ESP_LOGD(TAG, "PollerSend(%s)[%d/%d]: entry at[type=%02X, pid=%X], ticker=%u, wait=%u, cnt=%u/%u",
+             PollerSource(source), m_poll_state, (int)(&ch - m_poll_channel),
+             ch.job.entry.type, ch.job.entry.pid,
+             ch.job.ticker, ch.wait, ch.sequence_cnt, m_poll_sequence_max);
       // We need to poll this one...
-      m_poll.protocol = m_poll.entry.protocol;
-      m_poll.type = m_poll.entry.type;
-      m_poll.pid = m_poll.entry.pid;
-
-      switch (m_poll.entry.pollbus)
-        {
-        case 1:
-          m_poll.bus = m_can1;
-          break;
-        case 2:
-          m_poll.bus = m_can2;
-          break;
-        case 3:
-          m_poll.bus = m_can3;
-          break;
-        case 4:
-          m_poll.bus = m_can4;
-          break;
-        default:
-          m_poll.bus = m_poll_bus_default;
-        }
+      ch.job.protocol = ch.job.entry.protocol;
+      ch.job.type = ch.job.entry.type;
+      ch.job.pid = ch.job.entry.pid;
+      ch.job.bus = PollerEntryBus(&ch.job.entry);
 
       // Dispatch transmission start to protocol handler:
-      if (m_poll.protocol == VWTP_20)
-        PollerVWTPStart(fromPrimaryTicker);
+      if (ch.job.protocol == VWTP_20)
+        PollerVWTPStart(ch, fromPrimaryTicker);
       else
-        PollerISOTPStart(fromPrimaryTicker);
+        PollerISOTPStart(ch, fromPrimaryTicker);
 
-      m_poll_sequence_cnt++;
+      ch.sequence_cnt++;
       break;
       }
     }
@@ -405,19 +637,21 @@ void OvmsVehicle::PollerSend(poller_source_t source)
 void OvmsVehicle::PollerTxCallback(const CAN_frame_t* frame, bool success)
   {
   OvmsRecMutexLock lock(&m_poll_mutex);
+  OvmsPoller::poll_channel_t& ch = PollerChannel(frame->origin);
 
   // Check for a late callback:
-  if (!m_poll_wait || !HasPollList() || frame->origin != m_poll.bus || frame->MsgID != m_poll_txmsgid)
+  if (!ch.wait || !HasPollList() || frame->origin != ch.job.bus || frame->MsgID != ch.txmsgid)
     return;
 
   // Forward to protocol handler:
-  if (m_poll.protocol == VWTP_20)
-    PollerVWTPTxCallback(frame, success);
+  if (ch.job.protocol == VWTP_20)
+    PollerVWTPTxCallback(ch, frame, success);
 
   // On failure, try to speed up the current poll timeout:
   if (!success)
     {
-    m_poll_wait = 0;
+    ch.wait = 0;
+    m_poll_sched_changed = true;
     if (m_poll_single_rxbuf)
       {
       m_poll_single_rxerr = POLLSINGLE_TXFAILURE;
@@ -427,8 +661,8 @@ void OvmsVehicle::PollerTxCallback(const CAN_frame_t* frame, bool success)
     }
 
   // Forward to application:
-  m_poll.moduleid_rec = 0; // Not yet received
-  IncomingPollTxCallback(m_poll, success);
+  ch.job.moduleid_rec = 0; // Not yet received
+  IncomingPollTxCallback(ch.job, success);
   }
 
 /**
@@ -464,11 +698,7 @@ int OvmsVehicle::PollSingleRequest(canbus* bus, uint32_t txid, uint32_t rxid,
   if (!m_ready)
     return -1;
 
-  if (!m_registeredlistener)
-    {
-    m_registeredlistener = true;
-    MyCan.RegisterListener(m_rxqueue);
-    }
+  RegisterCanListener(bus);
 
   OvmsRecMutexLock slock(&m_poll_single_mutex, pdMS_TO_TICKS(timeout_ms));
   if (!slock.IsLocked())
@@ -513,8 +743,15 @@ int OvmsVehicle::PollSingleRequest(canbus* bus, uint32_t txid, uint32_t rxid,
   // save poller state:
   canbus*           p_bus    = m_poll_bus_default;
   const OvmsPoller::poll_pid_t* p_list   = m_poll_plist;
-  const OvmsPoller::poll_pid_t* p_plcur  = m_poll_plcur;
-  uint32_t          p_ticker = m_poll.ticker;
+  const OvmsPoller::poll_pid_t* p_plcur[VEHICLE_POLL_NCHANNELS];
+  uint32_t          p_ticker[VEHICLE_POLL_NCHANNELS];
+  OvmsPollScheduler p_sched[VEHICLE_POLL_NCHANNELS];
+  for (int i = 0; i < VEHICLE_POLL_NCHANNELS; i++)
+    {
+    p_plcur[i]  = m_poll_channel[i].plcur;
+    p_ticker[i] = m_poll_channel[i].job.ticker;
+    p_sched[i]  = m_poll_channel[i].sched;
+    }
 
   // start single poll:
   PollSetPidList(bus, poll);
@@ -529,8 +766,12 @@ int OvmsVehicle::PollSingleRequest(canbus* bus, uint32_t txid, uint32_t rxid,
   // restore poller state:
   m_poll_mutex.Lock();
   PollSetPidList(p_bus, p_list);
-  m_poll_plcur = p_plcur;
-  m_poll.ticker = p_ticker;
+  for (int i = 0; i < VEHICLE_POLL_NCHANNELS; i++)
+    {
+    m_poll_channel[i].plcur      = p_plcur[i];
+    m_poll_channel[i].job.ticker = p_ticker[i];
+    m_poll_channel[i].sched      = p_sched[i];
+    }
   m_poll_single_rxbuf = NULL;
   m_poll_mutex.Unlock();
 
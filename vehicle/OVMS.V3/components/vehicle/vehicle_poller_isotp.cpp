@@ -40,26 +40,26 @@ static const char *TAG = "vehicle-isotp";
 /**
  * PollerISOTPStart: start ISO-TP request
  */
-void OvmsVehicle::PollerISOTPStart(bool fromTicker)
+void OvmsVehicle::PollerISOTPStart(OvmsPoller::poll_channel_t& ch, bool fromTicker)
   {
-  if (m_poll.entry.rxmoduleid != 0)
+  if (ch.job.entry.rxmoduleid != 0)
     {
     // send to <moduleid>, listen to response from <rmoduleid>:
-    m_poll.moduleid_sent = m_poll.entry.txmoduleid;
-    m_poll.moduleid_low = m_poll.entry.rxmoduleid;
-    m_poll.moduleid_high = m_poll.entry.rxmoduleid;
+    ch.job.moduleid_sent = ch.job.entry.txmoduleid;
+    ch.job.moduleid_low = ch.job.entry.rxmoduleid;
+    ch.job.moduleid_high = ch.job.entry.rxmoduleid;
     }
   else
     {
     // broadcast: send to 0x7df, listen to all responses:
-    m_poll.moduleid_sent = 0x7df;
-    m_poll.moduleid_low = 0x7e8;
-    m_poll.moduleid_high = 0x7ef;
+    ch.job.moduleid_sent = 0x7df;
+    ch.job.moduleid_low = 0x7e8;
+    ch.job.moduleid_high = 0x7ef;
     }
 
   ESP_LOGD(TAG, "PollerISOTPStart(%d): send [bus=%d, type=%02X, pid=%X], expecting %03" PRIx32 "/%03" PRIx32 "-%03" PRIx32,
-           fromTicker, m_poll.entry.pollbus, m_poll.type, m_poll.pid, m_poll.moduleid_sent,
-           m_poll.moduleid_low, m_poll.moduleid_high);
+           fromTicker, ch.job.entry.pollbus, ch.job.type, ch.job.pid, ch.job.moduleid_sent,
+           ch.job.moduleid_low, ch.job.moduleid_high);
 
   //
   // Assemble ISO-TP single/first frame
@@ -75,46 +75,46 @@ void OvmsVehicle::PollerISOTPStart(bool fromTicker)
   uint16_t tx_datalen;            // Payload data length
   uint16_t tx_datasent;           // Payload data length sent with this frame
 
-  if (m_poll.entry.xargs.tag == POLL_TXDATA)
+  if (ch.job.entry.xargs.tag == POLL_TXDATA)
     {
-    tx_data = m_poll.entry.xargs.data;
-    tx_datalen = m_poll.entry.xargs.datalen;
+    tx_data = ch.job.entry.xargs.data;
+    tx_datalen = ch.job.entry.xargs.datalen;
     }
   else
     {
-    tx_data = m_poll.entry.args.data;
-    tx_datalen = m_poll.entry.args.datalen;
+    tx_data = ch.job.entry.args.data;
+    tx_datalen = ch.job.entry.args.datalen;
     }
 
   CAN_frame_t txframe = {};
-  txframe.origin = m_poll.bus;
+  txframe.origin = ch.job.bus;
   txframe.callback = &m_poll_txcallback;
   txframe.FIR.B.DLC = 8;
   std::fill_n(txframe.data.u8, sizeof_array(txframe.data.u8), 0x55);
 
-  if (m_poll.protocol == ISOTP_EXTFRAME)
+  if (ch.job.protocol == ISOTP_EXTFRAME)
     txframe.FIR.B.FF = CAN_frame_ext;
   else
     txframe.FIR.B.FF = CAN_frame_std;
 
-  if (m_poll.protocol == ISOTP_EXTADR)
+  if (ch.job.protocol == ISOTP_EXTADR)
     {
-    txframe.MsgID = m_poll.moduleid_sent >> 8;
-    txframe.data.u8[0] = m_poll.moduleid_sent & 0xff;
+    txframe.MsgID = ch.job.moduleid_sent >> 8;
+    txframe.data.u8[0] = ch.job.moduleid_sent & 0xff;
     fr_data = &txframe.data.u8[1];
     fr_maxlen = 7;
     }
   else
     {
-    txframe.MsgID = m_poll.moduleid_sent;
+    txframe.MsgID = ch.job.moduleid_sent;
     fr_data = &txframe.data.u8[0];
     fr_maxlen = 8;
     }
 
   // Do we need to split this request into multiple frames?
-  if (POLL_TYPE_HAS_16BIT_PID(m_poll.entry.type))
+  if (POLL_TYPE_HAS_16BIT_PID(ch.job.entry.type))
     tp_len = 3 + tx_datalen;
-  else if (POLL_TYPE_HAS_8BIT_PID(m_poll.entry.type))
+  else if (POLL_TYPE_HAS_8BIT_PID(ch.job.entry.type))
     tp_len = 2 + tx_datalen;
   else
     tp_len = 1 + tx_datalen;
@@ -134,53 +134,53 @@ void OvmsVehicle::PollerISOTPStart(bool fromTicker)
     }
 
   // Add TP data:
-  if (POLL_TYPE_HAS_16BIT_PID(m_poll.entry.type))
+  if (POLL_TYPE_HAS_16BIT_PID(ch.job.entry.type))
     {
-    tp_data[0] = m_poll.type;
-    tp_data[1] = m_poll.pid >> 8;
-    tp_data[2] = m_poll.pid & 0xff;
+    tp_data[0] = ch.job.type;
+    tp_data[1] = ch.job.pid >> 8;
+    tp_data[2] = ch.job.pid & 0xff;
     tx_datasent = LIMIT_MAX(tx_datalen, tp_datalen - 3);
     memcpy(&tp_data[3], tx_data, tx_datasent);
     }
-  else if (POLL_TYPE_HAS_8BIT_PID(m_poll.entry.type))
+  else if (POLL_TYPE_HAS_8BIT_PID(ch.job.entry.type))
     {
-    tp_data[0] = m_poll.type;
-    tp_data[1] = m_poll.pid;
+    tp_data[0] = ch.job.type;
+    tp_data[1] = ch.job.pid;
     tx_datasent = LIMIT_MAX(tx_datalen, tp_datalen - 2);
     memcpy(&tp_data[2], tx_data, tx_datasent);
     }
   else
     {
-    tp_data[0] = m_poll.type;
+    tp_data[0] = ch.job.type;
     tx_datasent = LIMIT_MAX(tx_datalen, tp_datalen - 1);
     memcpy(&tp_data[1], tx_data, tx_datasent);
     }
 
-  m_poll_txmsgid = txframe.MsgID;
-  m_poll_tx_frame = 0;
-  m_poll_tx_data = tx_data;
-  m_poll_tx_offset = tx_datasent;
-  m_poll_tx_remain = tx_datalen - tx_datasent;
-  m_poll.mlframe = 0;
-  m_poll.mloffset = 0;
-  m_poll.mlremain = 0;
-  m_poll_wait = 2;
-
-  m_poll.bus->Write(&txframe);
+  ch.txmsgid = txframe.MsgID;
+  ch.tx_frame = 0;
+  ch.tx_data = tx_data;
+  ch.tx_offset = tx_datasent;
+  ch.tx_remain = tx_datalen - tx_datasent;
+  ch.job.mlframe = 0;
+  ch.job.mloffset = 0;
+  ch.job.mlremain = 0;
+  ch.wait = 2;
+
+  ch.job.bus->Write(&txframe);
   }
 
 
 /**
  * PollerISOTPReceive: process ISO-TP poll response frame
  */
-bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
+bool OvmsVehicle::PollerISOTPReceive(OvmsPoller::poll_channel_t& ch, CAN_frame_t* frame, uint32_t msgid)
   {
   OvmsRecMutexLock lock(&m_poll_mutex);
   char *hexdump = NULL;
 
   // After locking the mutex, check again for poll expectance match:
-  if (!m_poll_wait || !m_poll_plist || frame->origin != m_poll.bus ||
-      msgid < m_poll.moduleid_low || msgid > m_poll.moduleid_high)
+  if (!ch.wait || !m_poll_plist || frame->origin != ch.job.bus ||
+      msgid < ch.job.moduleid_low || msgid > ch.job.moduleid_high)
     {
     ESP_LOGD(TAG, "PollerISOTPReceive[%03" PRIX32 "]: dropping expired poll response", msgid);
     return false;
@@ -202,7 +202,7 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
   uint8_t  tp_fc_framecnt;        // Flow control max frame count (0 = unlimited)
   uint8_t  tp_fc_septime = 0;     // Flow control frame separation time
 
-  if (m_poll.protocol == ISOTP_EXTADR)
+  if (ch.job.protocol == ISOTP_EXTADR)
     {
     fr_data = &frame->data.u8[1];
     fr_maxlen = 7;
@@ -231,7 +231,7 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
       break;
     case ISOTP_FT_CONSECUTIVE:
       tp_frameindex = fr_data[0] & 0x0f;
-      tp_len = m_poll.mlremain;
+      tp_len = ch.job.mlremain;
       tp_data = &fr_data[1];
       tp_datalen = (tp_len > fr_maxlen-1) ? fr_maxlen-1 : tp_len;
       break;
@@ -255,7 +255,7 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
   // Handle TX flow control:
   if (tp_frametype == ISOTP_FT_FLOWCTRL)
     {
-    if (tp_fc_command > 2 || m_poll_tx_remain == 0)
+    if (tp_fc_command > 2 || ch.tx_remain == 0)
       {
       FormatHexDump(&hexdump, (const char*)frame->data.u8, 8, 8);
       ESP_LOGW(TAG, "PollerISOTPReceive[%03" PRIX32 "]: ignoring unexpected/invalid ISO TP flow control frame: %s",
@@ -267,12 +267,12 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
     if (tp_fc_command == 1)
       {
       // add some wait time:
-      m_poll_wait++;
+      ch.wait++;
       }
     else if (tp_fc_command == 2)
       {
       // abort TX:
-      m_poll_tx_remain = 0;
+      ch.tx_remain = 0;
       // (but still wait for response)
       }
     else
@@ -286,12 +286,12 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
       tx_frame.origin = frame->origin;
       tx_frame.FIR.B.DLC = 8;
 
-      if (m_poll.protocol == ISOTP_EXTFRAME)
+      if (ch.job.protocol == ISOTP_EXTFRAME)
         tx_frame.FIR.B.FF = CAN_frame_ext;
       else
         tx_frame.FIR.B.FF = CAN_frame_std;
 
-      if (m_poll.moduleid_sent == 0x7df)
+      if (ch.job.moduleid_sent == 0x7df)
         {
         // broadcast request: derive module ID from response ID:
         // (Note: this only works for the SAE standard ID scheme)
@@ -300,10 +300,10 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
       else
         {
         // use known module ID:
-        txid = m_poll.moduleid_sent;
+        txid = ch.job.moduleid_sent;
         }
 
-      if (m_poll.protocol == ISOTP_EXTADR)
+      if (ch.job.protocol == ISOTP_EXTADR)
         {
         tx_frame.MsgID = txid >> 8;
         tx_frame.data.u8[0] = txid & 0xff;
@@ -318,19 +318,19 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
         }
 
       // Send next chunk of frames:
-      while (m_poll_tx_remain > 0)
+      while (ch.tx_remain > 0)
         {
-        ++m_poll_tx_frame;
-        tx_data[0] = (ISOTP_FT_CONSECUTIVE << 4) + (m_poll_tx_frame & 0x0f);
-        tx_datasent = LIMIT_MAX(m_poll_tx_remain, tx_datalen);
-        memcpy(&tx_data[1], m_poll_tx_data+m_poll_tx_offset, tx_datasent);
+        ++ch.tx_frame;
+        tx_data[0] = (ISOTP_FT_CONSECUTIVE << 4) + (ch.tx_frame & 0x0f);
+        tx_datasent = LIMIT_MAX(ch.tx_remain, tx_datalen);
+        memcpy(&tx_data[1], ch.tx_data+ch.tx_offset, tx_datasent);
         if (tx_datasent < tx_datalen)
           memset(&tx_data[1+tx_datasent], 0x55, tx_datalen-tx_datasent);
         tx_frame.Write();
-        m_poll_tx_offset += tx_datasent;
-        m_poll_tx_remain -= tx_datasent;
+        ch.tx_offset += tx_datasent;
+        ch.tx_remain -= tx_datasent;
 
-        if (m_poll_tx_remain == 0)
+        if (ch.tx_remain == 0)
           break;
         if (tp_fc_framecnt > 0 && --tp_fc_framecnt == 0)
           break;
@@ -344,8 +344,8 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
           }
         }
 
-      if (m_poll_tx_remain > 0)
-        m_poll_wait = 2;
+      if (ch.tx_remain > 0)
+        ch.wait = 2;
       }
 
     return true;
@@ -357,15 +357,15 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
     {
     // Note: we tolerate an index less than the expected one, as some devices
     //  begin counting at the first consecutive frame
-    if (m_poll.mlremain == 0 || tp_frameindex > (m_poll.mlframe & 0x0f))
+    if (ch.job.mlremain == 0 || tp_frameindex > (ch.job.mlframe & 0x0f))
       {
       FormatHexDump(&hexdump, (const char*)frame->data.u8, 8, 8);
       ESP_LOGW(TAG, "PollerISOTPReceive[%03" PRIX32 "]: unexpected/out of sequence ISO TP frame (%d vs %d), aborting poll %02X(%X): %s",
-              msgid, tp_frameindex, m_poll.mlframe & 0x0f, m_poll.type, m_poll.pid,
+              msgid, tp_frameindex, ch.job.mlframe & 0x0f, ch.job.type, ch.job.pid,
               hexdump ? hexdump : "-");
       if (hexdump) free(hexdump);
-      m_poll.moduleid_low = m_poll.moduleid_high = 0; // ignore further frames
-      m_poll_wait = 2; // give the bus time to let remaining frames pass
+      ch.job.moduleid_low = ch.job.moduleid_high = 0; // ignore further frames
+      ch.wait = 2; // give the bus time to let remaining frames pass
       return true;
       }
     }
@@ -384,8 +384,8 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
 
   if (tp_frametype == ISOTP_FT_CONSECUTIVE)
     {
-    response_type = 0x40+m_poll.type;
-    response_pid = m_poll.pid;
+    response_type = 0x40+ch.job.type;
+    response_pid = ch.job.pid;
     response_data = tp_data;
     response_datalen = tp_datalen;
     }
@@ -411,7 +411,7 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
       }
     else
       {
-      response_pid = m_poll.pid;
+      response_pid = ch.job.pid;
       response_data = &tp_data[1];
       response_datalen = tp_datalen - 1;
       }
@@ -422,23 +422,23 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
   // Process OBD/UDS payload
   // 
 
-  if (response_type == UDS_RESP_TYPE_NRC && error_type == m_poll.type)
+  if (response_type == UDS_RESP_TYPE_NRC && error_type == ch.job.type)
     {
     // Negative Response Code:
     if (error_code == UDS_RESP_NRC_RCRRP)
       {
       // Info: requestCorrectlyReceived-ResponsePending (server busy processing the request)
       ESP_LOGD(TAG, "PollerISOTPReceive[%03" PRIX32 "]: got OBD/UDS info %02X(%X) code=%02X (pending)",
-               msgid, m_poll.type, m_poll.pid, error_code);
+               msgid, ch.job.type, ch.job.pid, error_code);
       // add some wait time:
-      m_poll_wait++;
+      ch.wait++;
       return true;
       }
     else
       {
       // Error: forward to application:
       ESP_LOGD(TAG, "PollerISOTPReceive[%03" PRIX32 "]: process OBD/UDS error %02X(%X) code=%02X",
-               msgid, m_poll.type, m_poll.pid, error_code);
+               msgid, ch.job.type, ch.job.pid, error_code);
       // Running single poll?
       if (m_poll_single_rxbuf)
         {
@@ -448,33 +448,33 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
         }
       else
         {
-        m_poll.moduleid_rec = msgid;
-        m_poll.mlframe = 0;
-        m_poll.mloffset = 0;
-        m_poll.mlremain = 0;
-        IncomingPollError(m_poll, error_code);
+        ch.job.moduleid_rec = msgid;
+        ch.job.mlframe = 0;
+        ch.job.mloffset = 0;
+        ch.job.mlremain = 0;
+        IncomingPollError(ch.job, error_code);
         }
       // abort:
-      m_poll.mlremain = 0;
+      ch.job.mlremain = 0;
       }
     }
-  else if (response_type == 0x40+m_poll.type && response_pid == m_poll.pid)
+  else if (response_type == 0x40+ch.job.type && response_pid == ch.job.pid)
     {
     // Normal matching poll response, forward to application:
-    m_poll.mlremain = tp_len - tp_datalen;
+    ch.job.mlremain = tp_len - tp_datalen;
     ESP_LOGD(TAG, "PollerISOTPReceive[%03" PRIX32 "]: process OBD/UDS response %02X(%X) frm=%u len=%u off=%u rem=%u",
-             msgid, m_poll.type, m_poll.pid,
-             m_poll.mlframe, response_datalen, m_poll.mloffset, m_poll.mlremain);
+             msgid, ch.job.type, ch.job.pid,
+             ch.job.mlframe, response_datalen, ch.job.mloffset, ch.job.mlremain);
     // Running single poll?
     if (m_poll_single_rxbuf)
       {
-      if (m_poll.mlframe == 0)
+      if (ch.job.mlframe == 0)
         {
         m_poll_single_rxbuf->clear();
-        m_poll_single_rxbuf->reserve(response_datalen + m_poll.mlremain);
+        m_poll_single_rxbuf->reserve(response_datalen + ch.job.mlremain);
         }
       m_poll_single_rxbuf->append((char*)response_data, response_datalen);
-      if (m_poll.mlremain == 0)
+      if (ch.job.mlremain == 0)
         {
         m_poll_single_rxerr = 0;
         m_poll_single_rxbuf = NULL;
@@ -483,8 +483,8 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
       }
     else
       {
-      m_poll.moduleid_rec = msgid;
-      IncomingPollReply(m_poll, response_data, response_datalen);
+      ch.job.moduleid_rec = msgid;
+      IncomingPollReply(ch.job, response_data, response_datalen);
       }
     }
   else
@@ -492,14 +492,14 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
     // This is most likely a late response to a previous poll, log & skip:
     FormatHexDump(&hexdump, (const char*)frame->data.u8, 8, 8);
     ESP_LOGW(TAG, "PollerISOTPReceive[%03" PRIX32 "]: OBD/UDS response type/PID mismatch, got %02X(%X) vs %02X(%X) => ignoring: %s",
-             msgid, response_type, response_pid, 0x40+m_poll.type, m_poll.pid, hexdump ? hexdump : "-");
+             msgid, response_type, response_pid, 0x40+ch.job.type, ch.job.pid, hexdump ? hexdump : "-");
     if (hexdump) free(hexdump);
     return false;
     }
 
 
   // Do we expect more data?
-  if (m_poll.mlremain)
+  if (ch.job.mlremain)
     {
     if (tp_frametype == ISOTP_FT_FIRST)
       {
@@ -511,12 +511,12 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
       txframe.origin = frame->origin;
       txframe.FIR.B.DLC = 8;
 
-      if (m_poll.protocol == ISOTP_EXTFRAME)
+      if (ch.job.protocol == ISOTP_EXTFRAME)
         txframe.FIR.B.FF = CAN_frame_ext;
       else
         txframe.FIR.B.FF = CAN_frame_std;
 
-      if (m_poll.moduleid_sent == 0x7df)
+      if (ch.job.moduleid_sent == 0x7df)
         {
         // broadcast request: derive module ID from response ID:
         // (Note: this only works for the SAE standard ID scheme)
@@ -525,10 +525,10 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
       else
         {
         // use known module ID:
-        txid = m_poll.moduleid_sent;
+        txid = ch.job.moduleid_sent;
         }
 
-      if (m_poll.protocol == ISOTP_EXTADR)
+      if (ch.job.protocol == ISOTP_EXTADR)
         {
         txframe.MsgID = txid >> 8;
         txframe.data.u8[0] = txid & 0xff;
@@ -544,20 +544,20 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
       txdata[1] = 0x00;                // request all frames available
       txdata[2] = m_poll_fc_septime;   // with configured separation timing (default 25 ms)
       txframe.Write();
-      m_poll.mlframe = 1;
+      ch.job.mlframe = 1;
       }
     else
       {
-      m_poll.mlframe++;
+      ch.job.mlframe++;
       }
 
-    m_poll.mloffset += response_datalen; // next frame application payload offset
-    m_poll_wait = 2;
+    ch.job.mloffset += response_datalen; // next frame application payload offset
+    ch.wait = 2;
     }
   else
     {
     // Request response complete:
-    m_poll_wait = 0;
+    ch.wait = 0;
     }
 
 
@@ -565,11 +565,11 @@ bool OvmsVehicle::PollerISOTPReceive(CAN_frame_t* frame, uint32_t msgid)
   // - we are not waiting for another frame
   // - the poll was no broadcast (with potential further responses from other devices)
   // - poll throttling is unlimited or limit isn't reached yet
-  if (m_poll_wait == 0 &&
-      m_poll.moduleid_sent != 0x7df &&
-      CanPoll() )
+  if (ch.wait == 0 &&
+      ch.job.moduleid_sent != 0x7df &&
+      CanPoll(ch) )
     {
-    PollerSend(poller_source_t::Successful);
+    PollerSend(ch, poller_source_t::Successful);
     }
 
   return true;
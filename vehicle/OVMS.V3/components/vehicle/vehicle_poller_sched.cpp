@@ -0,0 +1,152 @@
+/*
+;    Project:       Open Vehicle Monitor System
+;    Date:          16th October 2026
+;
+;    Changes:
+;    1.0  Initial release
+;
+;    (C) 2011       Michael Stegen / Stegen Electronics
+;    (C) 2011-2017  Mark Webb-Johnson
+;    (C) 2011        Sonny Chen @ EPRO/DX
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in
+; all copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+; THE SOFTWARE.
+*/
+
+#include "vehicle_poller_sched.h"
+
+OvmsPollScheduler::OvmsPollScheduler()
+  {
+  ResetStats();
+  }
+
+void OvmsPollScheduler::Clear()
+  {
+  m_heap.clear();
+  }
+
+void OvmsPollScheduler::ResetStats()
+  {
+  m_polls = 0;
+  m_skipped = 0;
+  m_late_sum = 0;
+  m_late_max = 0;
+  }
+
+/**
+ * Add: schedule a poll list entry, due immediately
+ */
+void OvmsPollScheduler::Add(uint16_t index, uint32_t interval, uint32_t now)
+  {
+  entry_t e;
+  e.due = now;
+  e.interval = (interval > 0) ? interval : 1;
+  e.index = index;
+  e.started = false;
+  m_heap.push_back(e);
+  SiftUp(m_heap.size()-1);
+  }
+
+/**
+ * TimeToDue: milliseconds until the next entry is due
+ *  <= 0 = an entry is due now, INT32_MAX = no entries
+ */
+int32_t OvmsPollScheduler::TimeToDue(uint32_t now) const
+  {
+  if (m_heap.empty())
+    return INT32_MAX;
+  return (int32_t)(m_heap[0].due - now);
+  }
+
+/**
+ * Pop: get the next due entry and reschedule it
+ *  Returns the poll list index of the entry or -1 if no entry is due.
+ */
+int OvmsPollScheduler::Pop(uint32_t now)
+  {
+  if (m_heap.empty())
+    return -1;
+  entry_t& e = m_heap[0];
+  int32_t late = (int32_t)(now - e.due);
+  if (late < 0)
+    return -1;
+
+  m_polls++;
+  m_late_sum += late;
+  if ((uint32_t)late > m_late_max)
+    m_late_max = late;
+
+  int index = e.index;
+  e.due += e.interval;
+  if (!e.started)
+    {
+    // Spread: golden ratio phase per list index, evenly distributing
+    // entries of equal interval over the interval:
+    uint32_t frac = ((uint32_t)e.index * 2654435769u) >> 16;
+    e.due += (uint32_t)(((uint64_t)e.interval * frac) >> 16);
+    e.started = true;
+    }
+  if ((int32_t)(e.due - now) <= 0)
+    {
+    // Overload: skip missed rounds, keep the phase
+    uint32_t missed = (now - e.due) / e.interval + 1;
+    e.due += missed * e.interval;
+    m_skipped += missed;
+    }
+  SiftDown(0);
+  return index;
+  }
+
+bool OvmsPollScheduler::Before(const entry_t& a, const entry_t& b)
+  {
+  int32_t diff = (int32_t)(a.due - b.due);
+  return (diff < 0) || (diff == 0 && a.index < b.index);
+  }
+
+void OvmsPollScheduler::SiftUp(size_t pos)
+  {
+  entry_t e = m_heap[pos];
+  while (pos > 0)
+    {
+    size_t parent = (pos-1) / 2;
+    if (!Before(e, m_heap[parent]))
+      break;
+    m_heap[pos] = m_heap[parent];
+    pos = parent;
+    }
+  m_heap[pos] = e;
+  }
+
+void OvmsPollScheduler::SiftDown(size_t pos)
+  {
+  size_t size = m_heap.size();
+  entry_t e = m_heap[pos];
+  while (true)
+    {
+    size_t child = 2*pos + 1;
+    if (child >= size)
+      break;
+    if (child+1 < size && Before(m_heap[child+1], m_heap[child]))
+      child++;
+    if (!Before(m_heap[child], e))
+      break;
+    m_heap[pos] = m_heap[child];
+    pos = child;
+    }
+  m_heap[pos] = e;
+  }
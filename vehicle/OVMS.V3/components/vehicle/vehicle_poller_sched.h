@@ -0,0 +1,91 @@
+/*
+;    Project:       Open Vehicle Monitor System
+;    Date:          16th October 2026
+;
+;    Changes:
+;    1.0  Initial release
+;
+;    (C) 2011       Michael Stegen / Stegen Electronics
+;    (C) 2011-2017  Mark Webb-Johnson
+;    (C) 2011        Sonny Chen @ EPRO/DX
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in
+; all copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+; THE SOFTWARE.
+*/
+
+#ifndef __VEHICLE_POLLER_SCHED_H__
+#define __VEHICLE_POLLER_SCHED_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+// Deadline driven poll list scheduler
+//
+// Keeps the poll list entries active in the current poll state in a binary
+// min-heap keyed by their next due time in milliseconds, so finding the next
+// request is O(1) and rescheduling is O(log n), independent of the number of
+// entries not due. All entries are due on start, so the first round polls the
+// complete list in list order. From the second round on, each entry is shifted
+// by a fixed phase within its interval to spread entries with equal intervals
+// and avoid request bursts. Late entries keep their phase; missed rounds are
+// skipped instead of being caught up.
+//
+// Times are free running uint32_t milliseconds, comparisons are wrap safe.
+// The class has no framework dependencies, so it can be simulated on the host
+// (see support/pollsched-sim.cpp).
+
+class OvmsPollScheduler
+  {
+  public:
+    typedef struct
+      {
+      uint32_t due;                   // next due time [ms]
+      uint32_t interval;              // poll interval [ms]
+      uint16_t index;                 // poll list index
+      bool     started;               // first poll done, phase spread applied
+      } entry_t;
+
+  public:
+    OvmsPollScheduler();
+
+  public:
+    void Clear();
+    void Add(uint16_t index, uint32_t interval, uint32_t now);
+    bool Empty() const { return m_heap.empty(); }
+    size_t Size() const { return m_heap.size(); }
+    int32_t TimeToDue(uint32_t now) const;
+    int Pop(uint32_t now);
+    void ResetStats();
+
+  public:
+    uint32_t m_polls;                 // entries served
+    uint32_t m_skipped;               // rounds skipped due to overload
+    uint64_t m_late_sum;              // sum of serving delays [ms]
+    uint32_t m_late_max;              // max serving delay [ms]
+
+  protected:
+    static bool Before(const entry_t& a, const entry_t& b);
+    void SiftUp(size_t pos);
+    void SiftDown(size_t pos);
+
+  protected:
+    std::vector<entry_t> m_heap;
+  };
+
+#endif //#ifndef __VEHICLE_POLLER_SCHED_H__
@@ -40,20 +40,20 @@ static const char *TAG = "vehicle-vwtp";
 /**
  * PollerVWTPStart: start next VW-TP request (internal method)
  */
-void OvmsVehicle::PollerVWTPStart(bool fromTicker)
+void OvmsVehicle::PollerVWTPStart(OvmsPoller::poll_channel_t& ch, bool fromTicker)
   {
   m_poll_vwtp.lastused = monotonictime;
 
   // Check connection state:
-  if (m_poll_vwtp.bus != m_poll.bus ||
-      m_poll_vwtp.baseid != m_poll.entry.txmoduleid ||
-      m_poll_vwtp.moduleid != m_poll.entry.rxmoduleid)
+  if (m_poll_vwtp.bus != ch.job.bus ||
+      m_poll_vwtp.baseid != ch.job.entry.txmoduleid ||
+      m_poll_vwtp.moduleid != ch.job.entry.rxmoduleid)
     {
     // close or reconnect channel:
     if (m_poll_vwtp.state != VWTP_Closed)
-      PollerVWTPEnter(VWTP_ChannelClose);
-    else if (m_poll.entry.rxmoduleid != 0)
-      PollerVWTPEnter(VWTP_ChannelSetup);
+      PollerVWTPEnter(ch, VWTP_ChannelClose);
+    else if (ch.job.entry.rxmoduleid != 0)
+      PollerVWTPEnter(ch, VWTP_ChannelSetup);
     else if (m_poll_single_rxbuf)
       {
       m_poll_single_rxbuf->clear();
@@ -68,22 +68,22 @@ void OvmsVehicle::PollerVWTPStart(bool fromTicker)
   if (m_poll_vwtp.state < VWTP_Idle)
     {
     // previous channel setup/shutdown hasn't finished, start over:
-    PollerVWTPEnter(VWTP_ChannelSetup);
+    PollerVWTPEnter(ch, VWTP_ChannelSetup);
     }
   else
     {
     // abort transfer in progress if any:
     if (m_poll_vwtp.state == VWTP_Transmit)
       {
-      PollerVWTPEnter(VWTP_AbortXfer);
+      PollerVWTPEnter(ch, VWTP_AbortXfer);
       }
     else if (m_poll_vwtp.state == VWTP_Receive)
       {
-      PollerVWTPEnter(VWTP_AbortXfer);
+      PollerVWTPEnter(ch, VWTP_AbortXfer);
       usleep(m_poll_vwtp.septime * m_poll_vwtp.blocksize);
       }
     // start new poll:
-    PollerVWTPEnter(VWTP_StartPoll);
+    PollerVWTPEnter(ch, VWTP_StartPoll);
     }
   }
 
@@ -91,7 +91,7 @@ void OvmsVehicle::PollerVWTPStart(bool fromTicker)
 /**
  * PollerVWTPEnter: channel state transition (internal method)
  */
-void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
+void OvmsVehicle::PollerVWTPEnter(OvmsPoller::poll_channel_t& ch, vwtp_channelstate_t state)
   {
   CAN_frame_t txframe = {};
   txframe.callback = &m_poll_txcallback;
@@ -104,15 +104,15 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
     case VWTP_ChannelSetup:
       {
       // Open TP20 channel for current polling entry:
-      if (m_poll.protocol != VWTP_20)
+      if (ch.job.protocol != VWTP_20)
         {
-        ESP_LOGD(TAG, "PollerVWTPEnter/ChannelSetup: m_poll.protocol mismatch, abort");
+        ESP_LOGD(TAG, "PollerVWTPEnter/ChannelSetup: job protocol mismatch, abort");
         }
       else
         {
-        m_poll_vwtp.bus = m_poll.bus;
-        m_poll_vwtp.baseid = m_poll.entry.txmoduleid;
-        m_poll_vwtp.moduleid = m_poll.entry.rxmoduleid;
+        m_poll_vwtp.bus = ch.job.bus;
+        m_poll_vwtp.baseid = ch.job.entry.txmoduleid;
+        m_poll_vwtp.moduleid = ch.job.entry.rxmoduleid;
         m_poll_vwtp.txid = m_poll_vwtp.baseid;
         m_poll_vwtp.rxid = m_poll_vwtp.baseid + m_poll_vwtp.moduleid;
         
@@ -121,7 +121,7 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
         uint16_t offer_rxid = m_poll_vwtp.baseid + 0x100;
         
         ESP_LOGD(TAG, "PollerVWTPEnter[%02X]: channel setup request bus=%d txid=%03X rxid=%03X",
-          m_poll_vwtp.moduleid, m_poll.entry.pollbus, m_poll_vwtp.txid, m_poll_vwtp.rxid);
+          m_poll_vwtp.moduleid, ch.job.entry.pollbus, m_poll_vwtp.txid, m_poll_vwtp.rxid);
         
         txframe.MsgID = m_poll_vwtp.txid;
         txframe.FIR.B.DLC = 7;
@@ -133,12 +133,12 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
         txframe.data.u8[5] = offer_rxid >> 8;
         txframe.data.u8[6] = 0x01;
         
-        m_poll_txmsgid = m_poll_vwtp.txid;
-        m_poll.moduleid_sent = m_poll_vwtp.txid;
-        m_poll.moduleid_low = m_poll_vwtp.rxid;
-        m_poll.moduleid_high = m_poll_vwtp.rxid;
+        ch.txmsgid = m_poll_vwtp.txid;
+        ch.job.moduleid_sent = m_poll_vwtp.txid;
+        ch.job.moduleid_low = m_poll_vwtp.rxid;
+        ch.job.moduleid_high = m_poll_vwtp.rxid;
 
-        m_poll_wait = 2;
+        ch.wait = 2;
         m_poll_vwtp.state = VWTP_ChannelSetup;
         m_poll_vwtp.lastused = monotonictime;
         m_poll_vwtp.bus->Write(&txframe);
@@ -149,7 +149,7 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
     case VWTP_ChannelParams:
       {
       ESP_LOGD(TAG, "PollerVWTPEnter[%02X]: channel params request bus=%d txid=%03X rxid=%03X",
-        m_poll_vwtp.moduleid, m_poll.entry.pollbus, m_poll_vwtp.txid, m_poll_vwtp.rxid);
+        m_poll_vwtp.moduleid, ch.job.entry.pollbus, m_poll_vwtp.txid, m_poll_vwtp.rxid);
       
       txframe.MsgID = m_poll_vwtp.txid;
       txframe.FIR.B.DLC = 6;
@@ -160,11 +160,11 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
       txframe.data.u8[4] = 0x0A;  // interval between two packets:  0.1ms x 10 = 1 ms
       txframe.data.u8[5] = 0xFF;  // always ff
       
-      m_poll_txmsgid = m_poll_vwtp.txid;
-      m_poll.moduleid_sent = m_poll_vwtp.txid;
-      m_poll.moduleid_low = m_poll_vwtp.rxid;
-      m_poll.moduleid_high = m_poll_vwtp.rxid;
-      m_poll_wait = 2;
+      ch.txmsgid = m_poll_vwtp.txid;
+      ch.job.moduleid_sent = m_poll_vwtp.txid;
+      ch.job.moduleid_low = m_poll_vwtp.rxid;
+      ch.job.moduleid_high = m_poll_vwtp.rxid;
+      ch.wait = 2;
 
       m_poll_vwtp.state = VWTP_ChannelParams;
       m_poll_vwtp.bus->Write(&txframe);
@@ -174,17 +174,17 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
     case VWTP_ChannelClose:
       {
       ESP_LOGD(TAG, "PollerVWTPEnter[%02X]: close channel bus=%d txid=%03X rxid=%03X",
-        m_poll_vwtp.moduleid, m_poll.entry.pollbus, m_poll_vwtp.txid, m_poll_vwtp.rxid);
+        m_poll_vwtp.moduleid, ch.job.entry.pollbus, m_poll_vwtp.txid, m_poll_vwtp.rxid);
       
       txframe.MsgID = m_poll_vwtp.txid;
       txframe.FIR.B.DLC = 1;
       txframe.data.u8[0] = 0xA8;  // close request
       
-      m_poll_txmsgid = m_poll_vwtp.txid;
-      m_poll.moduleid_sent = m_poll_vwtp.txid;
-      m_poll.moduleid_low = m_poll_vwtp.rxid;
-      m_poll.moduleid_high = m_poll_vwtp.rxid;
-      m_poll_wait = 2;
+      ch.txmsgid = m_poll_vwtp.txid;
+      ch.job.moduleid_sent = m_poll_vwtp.txid;
+      ch.job.moduleid_low = m_poll_vwtp.rxid;
+      ch.job.moduleid_high = m_poll_vwtp.rxid;
+      ch.wait = 2;
 
       m_poll_vwtp.state = VWTP_ChannelClose;
       m_poll_vwtp.bus->Write(&txframe);
@@ -194,44 +194,44 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
     case VWTP_Closed:
       {
       ESP_LOGD(TAG, "PollerVWTPEnter[%02X]: channel closed bus=%d txid=%03X rxid=%03X",
-        m_poll_vwtp.moduleid, m_poll.entry.pollbus, m_poll_vwtp.txid, m_poll_vwtp.rxid);
+        m_poll_vwtp.moduleid, ch.job.entry.pollbus, m_poll_vwtp.txid, m_poll_vwtp.rxid);
       m_poll_vwtp = {};
       m_poll_vwtp.state = VWTP_Closed;
-      m_poll_wait = 0;
+      ch.wait = 0;
       break;
       }
 
     case VWTP_Idle:
       {
       ESP_LOGD(TAG, "PollerVWTPEnter[%02X]: idle bus=%d txid=%03X rxid=%03X",
-        m_poll_vwtp.moduleid, m_poll.entry.pollbus, m_poll_vwtp.txid, m_poll_vwtp.rxid);
+        m_poll_vwtp.moduleid, ch.job.entry.pollbus, m_poll_vwtp.txid, m_poll_vwtp.rxid);
       m_poll_vwtp.state = VWTP_Idle;
       m_poll_vwtp.lastused = monotonictime;
-      m_poll_wait = 0;
+      ch.wait = 0;
       break;
       }
 
     case VWTP_StartPoll:
       {
       ESP_LOGD(TAG, "PollerVWTPEnter[%02X]: start poll type=%02X pid=%X",
-        m_poll_vwtp.moduleid, m_poll.entry.type, m_poll.entry.pid);
+        m_poll_vwtp.moduleid, ch.job.entry.type, ch.job.entry.pid);
 
-      if (m_poll.entry.xargs.tag == POLL_TXDATA)
+      if (ch.job.entry.xargs.tag == POLL_TXDATA)
         {
-        m_poll_tx_data = m_poll.entry.xargs.data;
-        m_poll_tx_remain = m_poll.entry.xargs.datalen;
+        ch.tx_data = ch.job.entry.xargs.data;
+        ch.tx_remain = ch.job.entry.xargs.datalen;
         }
       else
         {
-        m_poll_tx_data = m_poll.entry.args.data;
-        m_poll_tx_remain = m_poll.entry.args.datalen;
+        ch.tx_data = ch.job.entry.args.data;
+        ch.tx_remain = ch.job.entry.args.datalen;
         }
-      m_poll_tx_frame = 0;
-      m_poll_tx_offset = 0;
+      ch.tx_frame = 0;
+      ch.tx_offset = 0;
 
-      m_poll.mlframe = 0;
-      m_poll.mloffset = 0;
-      m_poll.mlremain = 0;
+      ch.job.mlframe = 0;
+      ch.job.mloffset = 0;
+      ch.job.mlremain = 0;
 
       // fall through to VWTP_Transmit
       }
@@ -239,7 +239,7 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
     case VWTP_Transmit:
       {
       ESP_LOGD(TAG, "PollerVWTPEnter[%02X]: transmit frame=%u remain=%u",
-        m_poll_vwtp.moduleid, m_poll_tx_frame, m_poll_tx_remain);
+        m_poll_vwtp.moduleid, ch.tx_frame, ch.tx_remain);
       
       // Transmit next block of frames:
       txframe.MsgID = m_poll_vwtp.txid;
@@ -248,21 +248,21 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
       for (int block = 1; block <= m_poll_vwtp.blocksize; block++)
         {
         i = 1;
-        if (m_poll_tx_frame == 0)
+        if (ch.tx_frame == 0)
           {
           // First frame:
-          uint16_t txlen = m_poll_tx_remain + 1;
-          txframe.data.u8[3] = m_poll.entry.type;
-          if (POLL_TYPE_HAS_16BIT_PID(m_poll.entry.type))
+          uint16_t txlen = ch.tx_remain + 1;
+          txframe.data.u8[3] = ch.job.entry.type;
+          if (POLL_TYPE_HAS_16BIT_PID(ch.job.entry.type))
             {
-            txframe.data.u8[4] = m_poll.entry.pid >> 8;
-            txframe.data.u8[5] = m_poll.entry.pid & 0xff;
+            txframe.data.u8[4] = ch.job.entry.pid >> 8;
+            txframe.data.u8[5] = ch.job.entry.pid & 0xff;
             txlen += 2;
             i = 6;
             }
-          else if (POLL_TYPE_HAS_8BIT_PID(m_poll.entry.type))
+          else if (POLL_TYPE_HAS_8BIT_PID(ch.job.entry.type))
             {
-            txframe.data.u8[4] = m_poll.entry.pid & 0xff;
+            txframe.data.u8[4] = ch.job.entry.pid & 0xff;
             txlen += 1;
             i = 5;
             }
@@ -274,14 +274,14 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
           txframe.data.u8[2] = txlen & 0xff;
           }
 
-        while (i < 8 && m_poll_tx_remain > 0)
+        while (i < 8 && ch.tx_remain > 0)
           {
-          txframe.data.u8[i++] = m_poll_tx_data[m_poll_tx_offset++];
-          m_poll_tx_remain--;
+          txframe.data.u8[i++] = ch.tx_data[ch.tx_offset++];
+          ch.tx_remain--;
           }
         txframe.FIR.B.DLC = i;
 
-        if (m_poll_tx_remain == 0)
+        if (ch.tx_remain == 0)
           opcode = 0x10;    // last packet, waiting for ACK
         else if (block < m_poll_vwtp.blocksize)
           opcode = 0x20;    // more packets following in this block
@@ -293,18 +293,18 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
           usleep(m_poll_vwtp.septime);
 
         m_poll_vwtp.txseqnr++;
-        m_poll_tx_frame++;
+        ch.tx_frame++;
         m_poll_vwtp.bus->Write(&txframe);
 
-        if (m_poll_tx_remain == 0)
+        if (ch.tx_remain == 0)
           break;
         }
       
-      m_poll_txmsgid = m_poll_vwtp.txid;
-      m_poll.moduleid_sent = m_poll_vwtp.txid;
-      m_poll.moduleid_low = m_poll_vwtp.rxid;
-      m_poll.moduleid_high = m_poll_vwtp.rxid;
-      m_poll_wait = 2;
+      ch.txmsgid = m_poll_vwtp.txid;
+      ch.job.moduleid_sent = m_poll_vwtp.txid;
+      ch.job.moduleid_low = m_poll_vwtp.rxid;
+      ch.job.moduleid_high = m_poll_vwtp.rxid;
+      ch.wait = 2;
       m_poll_vwtp.state = VWTP_Transmit;
       m_poll_vwtp.lastused = monotonictime;
       break;
@@ -313,10 +313,10 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
     case VWTP_Receive:
       {
       ESP_LOGD(TAG, "PollerVWTPEnter[%02X]: receive frame=%u remain=%u",
-        m_poll_vwtp.moduleid, m_poll.mlframe, m_poll.mlremain);
+        m_poll_vwtp.moduleid, ch.job.mlframe, ch.job.mlremain);
       m_poll_vwtp.state = VWTP_Receive;
       m_poll_vwtp.lastused = monotonictime;
-      m_poll_wait = 2;
+      ch.wait = 2;
       break;
       }
 
@@ -337,25 +337,25 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
         m_poll_vwtp.txseqnr++;
         }
       
-      m_poll_txmsgid = m_poll_vwtp.txid;
-      m_poll.moduleid_sent = m_poll_vwtp.txid;
-      m_poll.moduleid_low = m_poll_vwtp.rxid;
-      m_poll.moduleid_high = m_poll_vwtp.rxid;
+      ch.txmsgid = m_poll_vwtp.txid;
+      ch.job.moduleid_sent = m_poll_vwtp.txid;
+      ch.job.moduleid_low = m_poll_vwtp.rxid;
+      ch.job.moduleid_high = m_poll_vwtp.rxid;
 
-      m_poll_tx_remain = 0;
-      m_poll.mlremain = 0;
+      ch.tx_remain = 0;
+      ch.job.mlremain = 0;
       m_poll_vwtp.state = VWTP_Idle;
       m_poll_vwtp.lastused = monotonictime;
-      m_poll_wait = 0;
+      ch.wait = 0;
       m_poll_vwtp.bus->Write(&txframe);
       break;
       }
 
     default:
       ESP_LOGD(TAG, "PollerVWTPEnter[%02X]: idle bus=%d txid=%03X rxid=%03X",
-        m_poll_vwtp.moduleid, m_poll.entry.pollbus, m_poll_vwtp.txid, m_poll_vwtp.rxid);
+        m_poll_vwtp.moduleid, ch.job.entry.pollbus, m_poll_vwtp.txid, m_poll_vwtp.rxid);
       m_poll_vwtp.state = VWTP_Idle;
-      m_poll_wait = 0;
+      ch.wait = 0;
       break;
     }
   }
@@ -364,14 +364,14 @@ void OvmsVehicle::PollerVWTPEnter(vwtp_channelstate_t state)
 /**
  * PollerVWTPTxCallback: CAN transmission result (internal)
  */
-void OvmsVehicle::PollerVWTPTxCallback(const CAN_frame_t* frame, bool success)
+void OvmsVehicle::PollerVWTPTxCallback(OvmsPoller::poll_channel_t& ch, const CAN_frame_t* frame, bool success)
   {
   if (!success)
     {
     // Todo: try to recover by repeating the transmission (unless CAN is offline)
     //  -- this needs a higher frequency ticker, e.g. 100 ms
     // For now assume channel is terminated:
-    PollerVWTPEnter(VWTP_Closed);
+    PollerVWTPEnter(ch, VWTP_Closed);
     }
   }
 
@@ -384,7 +384,7 @@ void OvmsVehicle::PollerVWTPTxCallback(const CAN_frame_t* frame, bool success)
 /**
  * PollerVWTPReceive: process VW-TP frame received (internal)
  */
-bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
+bool OvmsVehicle::PollerVWTPReceive(OvmsPoller::poll_channel_t& ch, CAN_frame_t* frame, uint32_t msgid)
   {
   OvmsRecMutexLock lock(&m_poll_mutex);
 
@@ -451,7 +451,7 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
         ESP_LOGD(TAG, "PollerVWTPReceive[%02X]: channel setup failed opcode=%02X", m_poll_vwtp.moduleid, opcode);
         m_poll_vwtp.bus = NULL;
         m_poll_vwtp.state = VWTP_Closed;
-        m_poll_wait = 0;
+        ch.wait = 0;
         }
       else
         {
@@ -461,7 +461,7 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
         ESP_LOGD(TAG, "PollerVWTPReceive[%02X]: channel setup OK, assigned txid=%03X rxid=%03X",
           m_poll_vwtp.moduleid, m_poll_vwtp.txid, m_poll_vwtp.rxid);
         // …and send channel parameters:
-        PollerVWTPEnter(VWTP_ChannelParams);
+        PollerVWTPEnter(ch, VWTP_ChannelParams);
         }
       break;
       }
@@ -480,13 +480,13 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
         ESP_LOGD(TAG, "PollerVWTPReceive[%02X]: channel params OK: bs=%d acktime=%" PRIu32 "us septime=%" PRIu32 "us",
           m_poll_vwtp.moduleid, m_poll_vwtp.blocksize, m_poll_vwtp.acktime, m_poll_vwtp.septime);
         // …and proceed to data transmission:
-        PollerVWTPEnter(VWTP_StartPoll);
+        PollerVWTPEnter(ch, VWTP_StartPoll);
         }
       else if (opcode == 0xA8)
         {
         // Channel abort received, send ACK & set closed state:
-        PollerVWTPEnter(VWTP_ChannelClose);
-        PollerVWTPEnter(VWTP_Closed);
+        PollerVWTPEnter(ch, VWTP_ChannelClose);
+        PollerVWTPEnter(ch, VWTP_Closed);
         // TODO: application error callback
         }
       else
@@ -504,10 +504,10 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
       if (opcode == 0xA8)
         {
         // Close ACK received:
-        PollerVWTPEnter(VWTP_Closed);
+        PollerVWTPEnter(ch, VWTP_Closed);
         // Check if we shall open another channel:
-        if (m_poll.protocol == VWTP_20 && m_poll.entry.rxmoduleid != 0)
-          PollerVWTPEnter(VWTP_ChannelSetup);
+        if (ch.job.protocol == VWTP_20 && ch.job.entry.rxmoduleid != 0)
+          PollerVWTPEnter(ch, VWTP_ChannelSetup);
         else if (m_poll_single_rxbuf)
           {
           m_poll_single_rxbuf->clear();
@@ -535,8 +535,8 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
       else if (opcode == 0xA8)
         {
         // Channel abort received, send ACK & set closed state:
-        PollerVWTPEnter(VWTP_ChannelClose);
-        PollerVWTPEnter(VWTP_Closed);
+        PollerVWTPEnter(ch, VWTP_ChannelClose);
+        PollerVWTPEnter(ch, VWTP_Closed);
         }
       else if ((opcode & 0xf0) <= 0x30)
         {
@@ -559,18 +559,18 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
       if ((opcode & 0xf0) == 0xB0)
         {
         // ACK, continue:
-        if (m_poll_tx_remain > 0)
-          PollerVWTPEnter(VWTP_Transmit);
+        if (ch.tx_remain > 0)
+          PollerVWTPEnter(ch, VWTP_Transmit);
         else
-          PollerVWTPEnter(VWTP_Receive);
+          PollerVWTPEnter(ch, VWTP_Receive);
         }
       else if ((opcode & 0xf0) == 0x90)
         {
         // ACK, abort:
         ESP_LOGD(TAG, "PollerVWTPReceive[%02X]: got abort request during transmission at frame=%u remain=%u",
-          m_poll_vwtp.moduleid, m_poll_tx_frame, m_poll_tx_remain);
-        m_poll_tx_remain = 0;
-        PollerVWTPEnter(VWTP_Idle);
+          m_poll_vwtp.moduleid, ch.tx_frame, ch.tx_remain);
+        ch.tx_remain = 0;
+        PollerVWTPEnter(ch, VWTP_Idle);
         // TODO: application error callback
         }
       else if (opcode == 0xA3)
@@ -581,8 +581,8 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
       else if (opcode == 0xA8)
         {
         // Channel abort received, send ACK & set closed state:
-        PollerVWTPEnter(VWTP_ChannelClose);
-        PollerVWTPEnter(VWTP_Closed);
+        PollerVWTPEnter(ch, VWTP_ChannelClose);
+        PollerVWTPEnter(ch, VWTP_Closed);
         // TODO: application error callback
         }
       else
@@ -604,8 +604,8 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
       else if (opcode == 0xA8)
         {
         // Channel abort received, send ACK & set closed state:
-        PollerVWTPEnter(VWTP_ChannelClose);
-        PollerVWTPEnter(VWTP_Closed);
+        PollerVWTPEnter(ch, VWTP_ChannelClose);
+        PollerVWTPEnter(ch, VWTP_Closed);
         // TODO: application error callback
         }
       else if (opcode < 0x40)
@@ -619,7 +619,7 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
         if ((opcode & 0x0f) != (rxseqnr & 0x0f))
           {
           logFrameDump("received out of sequence frame, abort");
-          PollerVWTPEnter(VWTP_AbortXfer);
+          PollerVWTPEnter(ch, VWTP_AbortXfer);
           return true;
           }
         
@@ -636,12 +636,12 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
         uint8_t  error_type = 0;            // OBD/UDS error response service type (expected: request type)
         uint8_t  error_code = 0;            // OBD/UDS error response code (see ISO 14229 Annex A.1)
 
-        if (m_poll.mlframe == 0)
+        if (ch.job.mlframe == 0)
           {
           // First frame: extract & validate meta data
           // Note: upper nibble of byte 1 masked out, length assumed to by 12 bit
           //  and we've seen 0x80 on byte 1 for response type UDS_RESP_NRC_RCRRP
-          m_poll.mlremain = (frame->data.u8[1] & 0x0f) << 8 | frame->data.u8[2];
+          ch.job.mlremain = (frame->data.u8[1] & 0x0f) << 8 | frame->data.u8[2];
           tp_data = &frame->data.u8[3];
           tp_datalen = frame->FIR.B.DLC - 3;
           response_type = tp_data[0];
@@ -664,7 +664,7 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
             }
           else
             {
-            response_pid = m_poll.pid;
+            response_pid = ch.job.pid;
             response_data = &tp_data[1];
             response_datalen = tp_datalen - 1;
             }
@@ -674,8 +674,8 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
           // Consecutive frame:
           tp_data = &frame->data.u8[1];
           tp_datalen = frame->FIR.B.DLC - 1;
-          response_type = 0x40+m_poll.type;
-          response_pid = m_poll.pid;
+          response_type = 0x40+ch.job.type;
+          response_pid = ch.job.pid;
           response_data = tp_data;
           response_datalen = tp_datalen;
           }
@@ -684,7 +684,7 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
         // Process OBD/UDS payload
         // 
 
-        if (response_type == UDS_RESP_TYPE_NRC && error_type == m_poll.type)
+        if (response_type == UDS_RESP_TYPE_NRC && error_type == ch.job.type)
           {
           // Send ACK?
           if ((opcode & 0xf0) <= 0x10)
@@ -695,16 +695,16 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
             {
             // Info: requestCorrectlyReceived-ResponsePending (server busy processing the request)
             ESP_LOGD(TAG, "PollerVWTPReceive[%02X]: got OBD/UDS info %02X(%X) code=%02X (pending)",
-                      m_poll_vwtp.moduleid, m_poll.type, m_poll.pid, error_code);
+                      m_poll_vwtp.moduleid, ch.job.type, ch.job.pid, error_code);
             // reset wait time:
-            m_poll_wait = 2;
+            ch.wait = 2;
             return true;
             }
           else
             {
             // Error: forward to application:
             ESP_LOGD(TAG, "PollerVWTPReceive[%02X]: process OBD/UDS error %02X(%X) code=%02X",
-                      m_poll_vwtp.moduleid, m_poll.type, m_poll.pid, error_code);
+                      m_poll_vwtp.moduleid, ch.job.type, ch.job.pid, error_code);
             // Running single poll?
             if (m_poll_single_rxbuf)
               {
@@ -714,38 +714,38 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
               }
             else
               {
-              m_poll.moduleid_rec = msgid;
-              m_poll.mlframe = 0;
-              m_poll.mloffset = 0;
-              m_poll.mlremain = 0;
-              IncomingPollError(m_poll, error_code);
+              ch.job.moduleid_rec = msgid;
+              ch.job.mlframe = 0;
+              ch.job.mloffset = 0;
+              ch.job.mlremain = 0;
+              IncomingPollError(ch.job, error_code);
               }
             // abort receive:
-            m_poll.mlremain = 0;
-            PollerVWTPEnter(VWTP_Idle);
+            ch.job.mlremain = 0;
+            PollerVWTPEnter(ch, VWTP_Idle);
             }
           }
-        else if (response_type == 0x40+m_poll.type && response_pid == m_poll.pid)
+        else if (response_type == 0x40+ch.job.type && response_pid == ch.job.pid)
           {
           // Send ACK?
           if ((opcode & 0xf0) <= 0x10)
             sendAck();
 
           // Normal matching poll response, forward to application:
-          m_poll.mlremain -= tp_datalen;
+          ch.job.mlremain -= tp_datalen;
           ESP_LOGD(TAG, "PollerVWTPReceive[%02X]: process OBD/UDS response %02X(%X) frm=%u len=%u off=%u rem=%u",
-                    m_poll_vwtp.moduleid, m_poll.type, m_poll.pid,
-                    m_poll.mlframe, response_datalen, m_poll.mloffset, m_poll.mlremain);
+                    m_poll_vwtp.moduleid, ch.job.type, ch.job.pid,
+                    ch.job.mlframe, response_datalen, ch.job.mloffset, ch.job.mlremain);
           // Running single poll?
           if (m_poll_single_rxbuf)
             {
-            if (m_poll.mlframe == 0)
+            if (ch.job.mlframe == 0)
               {
               m_poll_single_rxbuf->clear();
-              m_poll_single_rxbuf->reserve(response_datalen + m_poll.mlremain);
+              m_poll_single_rxbuf->reserve(response_datalen + ch.job.mlremain);
               }
             m_poll_single_rxbuf->append((char*)response_data, response_datalen);
-            if (m_poll.mlremain == 0)
+            if (ch.job.mlremain == 0)
               {
               m_poll_single_rxerr = 0;
               m_poll_single_rxbuf = NULL;
@@ -754,11 +754,11 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
             }
           else
             {
-            m_poll.moduleid_rec = msgid;
-            m_poll.mlframe = m_poll.mlframe;
-            m_poll.mloffset = m_poll.mloffset;
-            m_poll.mlremain = m_poll.mlremain;
-            IncomingPollReply(m_poll, response_data, response_datalen);
+            ch.job.moduleid_rec = msgid;
+            ch.job.mlframe = ch.job.mlframe;
+            ch.job.mloffset = ch.job.mloffset;
+            ch.job.mlremain = ch.job.mlremain;
+            IncomingPollReply(ch.job, response_data, response_datalen);
             }
           }
         else
@@ -767,23 +767,23 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
           char *hexdump = NULL;
           FormatHexDump(&hexdump, (const char*)frame->data.u8, frame->FIR.B.DLC, frame->FIR.B.DLC);
           ESP_LOGW(TAG, "PollerVWTPReceive[%02X]: OBD/UDS response type/PID mismatch, got %02X(%X) vs %02X(%X) => ignoring: %s",
-                    m_poll_vwtp.moduleid, response_type, response_pid, 0x40+m_poll.type, m_poll.pid, hexdump ? hexdump : "-");
+                    m_poll_vwtp.moduleid, response_type, response_pid, 0x40+ch.job.type, ch.job.pid, hexdump ? hexdump : "-");
           if (hexdump) free(hexdump);
-          PollerVWTPEnter(VWTP_AbortXfer);
+          PollerVWTPEnter(ch, VWTP_AbortXfer);
           return false;
           }
         
         // Do we expect more data?
-        if (m_poll.mlremain)
+        if (ch.job.mlremain)
           {
-          m_poll.mlframe++;
-          m_poll.mloffset += response_datalen;
-          m_poll_wait = 2;
+          ch.job.mlframe++;
+          ch.job.mloffset += response_datalen;
+          ch.wait = 2;
           }
         else
           {
           // Request response complete:
-          PollerVWTPEnter(VWTP_Idle);
+          PollerVWTPEnter(ch, VWTP_Idle);
           }
         }
       else
@@ -802,9 +802,9 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
   // Immediately send the next poll for this tick if…
   // - we are not waiting for another frame
   // - poll throttling is unlimited or limit isn't reached yet
-  if (m_poll_wait == 0 && CanPoll())
+  if (ch.wait == 0 && CanPoll(ch))
     {
-    PollerSend(poller_source_t::Successful);
+    PollerSend(ch, poller_source_t::Successful);
     }
 
   return true;
@@ -814,22 +814,22 @@ bool OvmsVehicle::PollerVWTPReceive(CAN_frame_t* frame, uint32_t msgid)
 /**
  * PollerVWTPTicker: per second channel maintenance (internal)
  */
-void OvmsVehicle::PollerVWTPTicker()
+void OvmsVehicle::PollerVWTPTicker(OvmsPoller::poll_channel_t& ch)
   {
-  if (m_poll_wait > 0)
+  if (ch.wait > 0)
     {
     // State timeout?
     if (m_poll_vwtp.state == VWTP_ChannelSetup || m_poll_vwtp.state == VWTP_ChannelParams)
       {
       ESP_LOGD(TAG, "PollerVWTPTicker[%02X]: setup/params timeout", m_poll_vwtp.moduleid);
-      PollerVWTPEnter(VWTP_Closed);
+      PollerVWTPEnter(ch, VWTP_Closed);
       }
     else if (m_poll_vwtp.state == VWTP_ChannelClose)
       {
       ESP_LOGD(TAG, "PollerVWTPTicker[%02X]: close timeout", m_poll_vwtp.moduleid);
-      PollerVWTPEnter(VWTP_Closed);
-      if (m_poll.protocol == VWTP_20)
-        PollerVWTPStart(true);
+      PollerVWTPEnter(ch, VWTP_Closed);
+      if (ch.job.protocol == VWTP_20)
+        PollerVWTPStart(ch, true);
       }
     }
   else
@@ -838,7 +838,7 @@ void OvmsVehicle::PollerVWTPTicker()
     if (m_poll_vwtp.state != VWTP_Closed && m_poll_vwtp.state != VWTP_Idle)
       {
       ESP_LOGD(TAG, "PollerVWTPTicker[%02X]: poll timeout", m_poll_vwtp.moduleid);
-      PollerVWTPEnter(VWTP_ChannelClose);
+      PollerVWTPEnter(ch, VWTP_ChannelClose);
       }
     }
 
@@ -847,6 +847,6 @@ void OvmsVehicle::PollerVWTPTicker()
       m_poll_vwtp.lastused + m_poll_ch_keepalive < monotonictime)
     {
     ESP_LOGD(TAG, "PollerVWTPTicker[%02X]: channel inactivity timeout", m_poll_vwtp.moduleid);
-    PollerVWTPEnter(VWTP_ChannelClose);
+    PollerVWTPEnter(ch, VWTP_ChannelClose);
     }
   }
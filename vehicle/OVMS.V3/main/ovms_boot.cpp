@@ -548,6 +548,7 @@ void Boot::Restart(bool hard)
     }
 
   ESP_LOGI(TAG,"Shutting down for %s...", m_shutdown_deepsleep ? "DeepSleep" : "Restart");
+  MyConfig.Flush();
   OvmsMutexLock lock(&m_shutdown_mutex);
   m_shutting_down = true;
   m_shutdown_pending = 0;
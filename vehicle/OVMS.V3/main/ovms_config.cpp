@@ -37,6 +37,7 @@ static const char *TAG = "config";
 #include <string.h>
 #include <sstream>
 #include <dirent.h>
+#include <list>
 #include "crypt_base64.h"
 #include "ovms_config.h"
 #include "ovms_command.h"
@@ -51,12 +52,21 @@ static const char *TAG = "config";
 #endif // CONFIG_OVMS_SC_ZIP
 
 #define OVMS_CONFIGPATH "/store/ovms_config"
+#define OVMS_CONFIGNEW  ".new"                  // suffix for param files being written
+#define OVMS_CONFIGEND  "#end\n"                // param file trailer, marks a complete write
 #define OVMS_MAXVALSIZE 2500
 //#define OVMS_PERSIST_METADATA
 
 
 OvmsConfig MyConfig __attribute__ ((init_priority (1400)));
 
+// config.changed is signalled on every param change, so signal it by ID:
+static event_id_t ConfigChangedEvent()
+  {
+  static event_id_t id = MyEvents.Intern("config.changed");
+  return id;
+  }
+
 void store_mount(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
   {
   MyConfig.mount();
@@ -393,6 +403,8 @@ OvmsConfig::OvmsConfig()
   ESP_LOGI(TAG, "Initialising CONFIG (1400)");
 
   m_mounted = false;
+  m_write_count = 0;
+  m_generation = 1;
 
   OvmsCommand* cmd_store = MyCommandApp.RegisterCommand("store","STORE framework");
   cmd_store->RegisterCommand("mount","Mount STORE",store_mount);
@@ -472,18 +484,43 @@ esp_err_t OvmsConfig::mount()
 
   DIR *dir;
   struct dirent *dp;
+  std::list<std::string> names;
   if ((dir = opendir(OVMS_CONFIGPATH)) == NULL)
     {
     ESP_LOGE(TAG, "Error: Cannot open config store directory");
     return ESP_ERR_NOT_FOUND;
     }
   while ((dp = readdir(dir)) != NULL)
+    names.push_back(dp->d_name);
+  closedir(dir);
+
+  for (std::string& name : names)
     {
+    if (endsWith(name, OVMS_CONFIGNEW))
+      {
+      // Param write has been interrupted: if the new file is complete (has the
+      // trailer), it replaces the old one, else the new file is discarded.
+      std::string path = std::string(OVMS_CONFIGPATH "/") + name;
+      name.resize(name.size() - strlen(OVMS_CONFIGNEW));
+      std::string oldpath = std::string(OVMS_CONFIGPATH "/") + name;
+      if (!ParamFileComplete(path))
+        {
+        ESP_LOGW(TAG, "Discarding incomplete param file '%s'", path.c_str());
+        unlink(path.c_str());
+        if (!path_exists(oldpath))
+          continue;
+        }
+      else
+        {
+        ESP_LOGW(TAG, "Recovering param file '%s'", path.c_str());
+        unlink(oldpath.c_str());
+        rename(path.c_str(), oldpath.c_str());
+        }
+      }
     // Register the param in case this was not already done
-    if (CachedParam(dp->d_name) == NULL)
-      RegisterParam(dp->d_name, "", true, false);
+    if (CachedParam(name) == NULL)
+      RegisterParam(name, "", true, false);
     }
-  closedir(dir);
 
   // load & upgrade params:
   for (ConfigMap::iterator it=MyConfig.m_map.begin(); it!=MyConfig.m_map.end(); ++it)
@@ -503,6 +540,9 @@ esp_err_t OvmsConfig::unmount()
 
   if (m_mounted)
     {
+    // write pending transaction changes:
+    Flush();
+
 #if ESP_IDF_VERSION_MAJOR >= 5
     esp_vfs_fat_spiflash_unmount_rw_wl("/store", m_store_wlh);
 #else
@@ -601,6 +641,94 @@ void OvmsConfig::upgrade()
   SetParamValueInt("module", "cfgversion", 2022121400);
   }
 
+/**
+ * ParamFileComplete: check a param file for the trailer written by RewriteConfig()
+ */
+bool OvmsConfig::ParamFileComplete(const std::string& path)
+  {
+  FILE* f = fopen(path.c_str(), "r");
+  if (!f)
+    return false;
+  size_t len = strlen(OVMS_CONFIGEND);
+  char buf[16];
+  bool complete = (fseek(f, -(long)len, SEEK_END) == 0)
+               && (fread(buf, 1, len, f) == len)
+               && (memcmp(buf, OVMS_CONFIGEND, len) == 0);
+  fclose(f);
+  return complete;
+  }
+
+/**
+ * BeginTransaction / Commit: defer param writes of the calling task
+ *  Transactions nest per task and don't affect other tasks. Changes are only
+ *  in memory until the commit, so keep transactions short (e.g. one form or
+ *  one batch of settings). Use OvmsConfigTransaction for a scoped transaction.
+ */
+void OvmsConfig::BeginTransaction()
+  {
+  OvmsMutexLock lock(&m_transaction_lock);
+  m_transactions[xTaskGetCurrentTaskHandle()].depth++;
+  }
+
+void OvmsConfig::Commit()
+  {
+  std::set<OvmsConfigParam*> params;
+  m_transaction_lock.Lock();
+  auto it = m_transactions.find(xTaskGetCurrentTaskHandle());
+  if (it != m_transactions.end() && --it->second.depth <= 0)
+    {
+    params.swap(it->second.params);
+    m_transactions.erase(it);
+    }
+  m_transaction_lock.Unlock();
+
+  for (OvmsConfigParam* param : params)
+    {
+    param->RewriteConfig();
+    MyEvents.SignalEvent(ConfigChangedEvent(), param);
+    }
+  }
+
+/**
+ * Flush: write the pending changes of all open transactions now
+ *  Called before backups, restarts and unmounting. The transactions stay open,
+ *  further changes are deferred again.
+ */
+void OvmsConfig::Flush()
+  {
+  std::set<OvmsConfigParam*> params;
+  m_transaction_lock.Lock();
+  for (auto& t : m_transactions)
+    {
+    params.insert(t.second.params.begin(), t.second.params.end());
+    t.second.params.clear();
+    }
+  m_transaction_lock.Unlock();
+
+  for (OvmsConfigParam* param : params)
+    {
+    param->RewriteConfig();
+    MyEvents.SignalEvent(ConfigChangedEvent(), param);
+    }
+  }
+
+bool OvmsConfig::DeferWrite(OvmsConfigParam* param)
+  {
+  OvmsMutexLock lock(&m_transaction_lock);
+  auto it = m_transactions.find(xTaskGetCurrentTaskHandle());
+  if (it == m_transactions.end())
+    return false;
+  it->second.params.insert(param);
+  return true;
+  }
+
+void OvmsConfig::DiscardWrite(OvmsConfigParam* param)
+  {
+  OvmsMutexLock lock(&m_transaction_lock);
+  for (auto& t : m_transactions)
+    t.second.params.erase(param);
+  }
+
 void OvmsConfig::RegisterParam(std::string name, std::string title, bool writable, bool readable)
   {
   auto k = m_map.find(name);
@@ -831,6 +959,7 @@ bool OvmsConfig::Backup(std::string path, std::string password, OvmsWriter* writ
   else
     ESP_LOGD(TAG, "Backup: creating '%s'...", path.c_str());
 
+  Flush();
   OvmsMutexLock store_lock(&m_store_lock);
   bool ok = true;
 
@@ -1100,6 +1229,7 @@ void OvmsConfigParam::LoadConfig()
     fclose(f);
     }
   m_loaded = true;
+  MyConfig.m_generation++;
   }
 
 void OvmsConfigParam::SetValue(std::string instance, std::string value)
@@ -1107,13 +1237,13 @@ void OvmsConfigParam::SetValue(std::string instance, std::string value)
   if (m_map.find(instance) == m_map.end() || m_map[instance] != value)
     {
     m_map[instance] = value;
-    RewriteConfig();
-    MyEvents.SignalEvent("config.changed", this);
+    Changed();
     }
   }
 
 void OvmsConfigParam::DeleteParam()
   {
+  MyConfig.DiscardWrite(this);
   OvmsMutexLock store_lock(&MyConfig.m_store_lock);
 
   std::string path(OVMS_CONFIGPATH);
@@ -1121,21 +1251,21 @@ void OvmsConfigParam::DeleteParam()
   path.append(m_name);
   unlink(path.c_str());
   m_map.clear();
-  MyEvents.SignalEvent("config.changed", this);
+  MyConfig.m_generation++;
+  MyEvents.SignalEvent(ConfigChangedEvent(), this);
   }
 
 bool OvmsConfigParam::DeleteInstance(std::string instance)
   {
-  bool ret = false;
   auto k = m_map.find(instance);
   if (k != m_map.end())
     {
     m_map.erase(k);
-    RewriteConfig();
-    ret = true;
+    Changed();
+    return true;
     }
-  MyEvents.SignalEvent("config.changed", this);
-  return ret;
+  MyEvents.SignalEvent(ConfigChangedEvent(), this);
+  return false;
   }
 
 std::string OvmsConfigParam::GetValue(std::string instance)
@@ -1179,6 +1309,25 @@ std::string OvmsConfigParam::GetName()
   return m_name;
   }
 
+/**
+ * Changed: write the param file & signal config.changed,
+ *  deferred until commit while a transaction is open
+ */
+void OvmsConfigParam::Changed()
+  {
+  MyConfig.m_generation++;
+  if (MyConfig.DeferWrite(this))
+    return;
+  RewriteConfig();
+  MyEvents.SignalEvent(ConfigChangedEvent(), this);
+  }
+
+/**
+ * RewriteConfig: write the param file
+ *  The file is written to a temporary name first, ending with a trailer line that
+ *  marks it complete (ignored on loading), and then replaces the previous version,
+ *  so the param cannot get lost or truncated by a crash (see mount()).
+ */
 void OvmsConfigParam::RewriteConfig()
   {
   OvmsMutexLock store_lock(&MyConfig.m_store_lock);
@@ -1186,24 +1335,36 @@ void OvmsConfigParam::RewriteConfig()
   std::string path(OVMS_CONFIGPATH);
   path.append("/");
   path.append(m_name);
-  FILE* f = fopen(path.c_str(), "w");
+  std::string newpath(path);
+  newpath.append(OVMS_CONFIGNEW);
+  FILE* f = fopen(newpath.c_str(), "w");
   if (!f)
-    ESP_LOGE(TAG, "RewriteConfig: can't open '%s': %s", path.c_str(), strerror(errno));
-  else
     {
+    ESP_LOGE(TAG, "RewriteConfig: can't open '%s': %s", newpath.c_str(), strerror(errno));
+    return;
+    }
 #ifdef OVMS_PERSIST_METADATA
-    // write meta data:
-    fprintf(f, "#access=%s%s\n", m_readable ? "r" : "", m_writable ? "w" : "");
-    fprintf(f, "#title=%s\n", m_title.c_str());
+  // write meta data:
+  fprintf(f, "#access=%s%s\n", m_readable ? "r" : "", m_writable ? "w" : "");
+  fprintf(f, "#title=%s\n", m_title.c_str());
 #endif
-    // write instances:
-    for (ConfigParamMap::iterator it=m_map.begin(); it!=m_map.end(); ++it)
-      {
-      fprintf(f,"%s\t%s\n",it->first.c_str(),it->second.c_str());
-      }
-    if (fclose(f))
-      ESP_LOGE(TAG, "RewriteConfig: error writing '%s': %s", path.c_str(), strerror(errno));
+  // write instances:
+  for (ConfigParamMap::iterator it=m_map.begin(); it!=m_map.end(); ++it)
+    {
+    fprintf(f,"%s\t%s\n",it->first.c_str(),it->second.c_str());
     }
+  fputs(OVMS_CONFIGEND, f);
+  MyConfig.m_write_count++;
+  if (fclose(f))
+    {
+    ESP_LOGE(TAG, "RewriteConfig: error writing '%s': %s", newpath.c_str(), strerror(errno));
+    unlink(newpath.c_str());
+    return;
+    }
+  // replace the old file:
+  unlink(path.c_str());
+  if (rename(newpath.c_str(), path.c_str()))
+    ESP_LOGE(TAG, "RewriteConfig: error renaming '%s': %s", newpath.c_str(), strerror(errno));
   }
 
 void OvmsConfigParam::Load()
@@ -1215,8 +1376,7 @@ void OvmsConfigParam::Save()
   {
   if (m_name != "")
     {
-    RewriteConfig();
-    MyEvents.SignalEvent("config.changed", this);
+    Changed();
     }
   }
 
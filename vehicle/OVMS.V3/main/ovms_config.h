@@ -33,11 +33,15 @@
 
 #include "string"
 #include "map"
+#include "set"
 #include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp_vfs_fat.h"
 #include "wear_levelling.h"
 #include "ovms_mutex.h"
 #include "ovms_command.h"
+#include "ovms_utils.h"
 
 typedef NameMap<std::string> ConfigParamMap;
 
@@ -65,6 +69,8 @@ class OvmsConfigParam
     void SetMap(ConfigParamMap& map);
 
   protected:
+    friend class OvmsConfig;
+    void Changed();
     void RewriteConfig();
     void LoadConfig();
 
@@ -121,6 +127,28 @@ class OvmsConfig
     bool Restore(std::string path, std::string password, OvmsWriter* writer=NULL, int verbosity=1024);
 #endif // CONFIG_OVMS_SC_ZIP
 
+  public:
+    void BeginTransaction();
+    void Commit();
+    void Flush();
+    uint32_t GetWriteCount() { return m_write_count; }
+    uint32_t GetGeneration() { return m_generation; }
+  protected:
+    friend class OvmsConfigParam;
+    bool DeferWrite(OvmsConfigParam* param);
+    static bool ParamFileComplete(const std::string& path);
+    void DiscardWrite(OvmsConfigParam* param);
+  protected:
+    typedef struct
+      {
+      int depth;                              // Nesting level
+      std::set<OvmsConfigParam*> params;      // Params changed
+      } transaction_t;
+    OvmsMutex m_transaction_lock;
+    std::map<TaskHandle_t, transaction_t> m_transactions;   // Open transactions by task
+    uint32_t m_write_count;
+    volatile uint32_t m_generation;         // incremented on every param change
+
   public:
     esp_err_t mount();
     esp_err_t unmount();
@@ -144,4 +172,69 @@ class OvmsConfig
 
 extern OvmsConfig MyConfig;
 
+/**
+ * OvmsConfigTransaction: scoped config write transaction
+ *  Param file writes and config.changed events of the calling task are deferred until
+ *  its outermost transaction ends, so multiple changes to a param result in a single
+ *  file write. Changes by other tasks are written immediately.
+ */
+class OvmsConfigTransaction
+  {
+  public:
+    OvmsConfigTransaction() { MyConfig.BeginTransaction(); }
+    ~OvmsConfigTransaction() { MyConfig.Commit(); }
+  };
+
+/**
+ * OvmsConfigValue<T>: cached typed config value
+ *  Looks up & parses the value on first use and after config changes only,
+ *  so reading the value is cheap enough for hot paths. Types supported:
+ *  int, float, bool & std::string. Not thread safe for std::string values.
+ *  Example:
+ *    OvmsConfigValue<float> maxgrad("vehicle", "bms.dev.voltage.maxgrad");
+ *    float thr = maxgrad.Get(0.01);
+ */
+template <typename T>
+class OvmsConfigValue
+  {
+  public:
+    OvmsConfigValue(const char* param, const char* instance)
+      : m_param(param), m_instance(instance), m_generation(0), m_defined(false), m_value() {}
+
+  public:
+    T Get(T defvalue)
+      {
+      if (m_generation != MyConfig.GetGeneration())
+        Load();
+      return m_defined ? m_value : defvalue;
+      }
+    bool IsDefined()
+      {
+      if (m_generation != MyConfig.GetGeneration())
+        Load();
+      return m_defined;
+      }
+
+  protected:
+    void Load()
+      {
+      m_generation = MyConfig.GetGeneration();
+      std::string value = MyConfig.GetParamValue(m_param, m_instance);
+      m_defined = !value.empty();
+      if (m_defined)
+        Parse(value, m_value);
+      }
+    static void Parse(const std::string& value, int& result) { result = atoi(value.c_str()); }
+    static void Parse(const std::string& value, float& result) { result = atof(value.c_str()); }
+    static void Parse(const std::string& value, bool& result) { result = strtobool(value); }
+    static void Parse(const std::string& value, std::string& result) { result = value; }
+
+  protected:
+    const char* m_param;
+    const char* m_instance;
+    uint32_t m_generation;
+    bool m_defined;
+    T m_value;
+  };
+
 #endif //#ifndef __CONFIG_H__
@@ -105,6 +105,12 @@ void event_status(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc,
     MyEvents.Map().size(),
     uxQueueMessagesWaiting(MyEvents.m_taskqueue),
     CONFIG_OVMS_HW_EVENT_QUEUE_SIZE);
+  writer->printf("Event names interned: %d/%d\n",
+    MyEvents.GetInternedCount(),
+    EVENT_ID_CHUNKS * EVENT_ID_CHUNKSIZE);
+  writer->printf("Event scripts for %u events, %" PRIu32 " filesystem probes avoided\n",
+    MyScripts.GetEventScriptsCount(),
+    MyScripts.GetProbesAvoided());
 
   EventCallbackEntry* cbe = MyEvents.m_current_callback;
   if (cbe != NULL)
@@ -201,6 +207,9 @@ OvmsEvents::OvmsEvents()
   ESP_LOGI(TAG, "Initialising EVENTS (1200)");
 
   m_current_callback = NULL;
+  m_wildcard = NULL;
+  m_event_count = 0;
+  memset(m_events, 0, sizeof(m_events));
 
 #ifdef CONFIG_OVMS_DEV_DEBUGEVENTS
   m_trace = true;
@@ -258,7 +267,10 @@ void OvmsEvents::EventTask()
         case EVENT_none:
           break;
         case EVENT_signal:
-          m_current_event = msg.body.signal.event;
+          if (msg.body.signal.event)
+            m_current_event = msg.body.signal.event;
+          else
+            m_current_event = GetEventName(msg.body.signal.id);
           HandleQueueSignalEvent(&msg);
           esp_task_wdt_reset(); // Reset WATCHDOG timer for this task
           m_current_event.clear();
@@ -288,8 +300,25 @@ void OvmsEvents::EventTask()
 
 void OvmsEvents::HandleQueueSignalEvent(event_queue_t* msg)
   {
+  event_entry_t* entry = GetEntry(msg->body.signal.id);
+  EventCallbackList* el = NULL;
+  bool quiet;
+  if (entry)
+    {
+    el = entry->listeners;
+    quiet = entry->quiet;
+    }
+  else
+    {
+    // Not interned, look up by name:
+    auto k = m_map.find(m_current_event);
+    if (k != m_map.end())
+      el = k->second;
+    quiet = startsWith(m_current_event, "ticker.") || startsWith(m_current_event, "clock.");
+    }
+
   // Log everything but the ticker & clock signals
-  if (!startsWith(m_current_event, "ticker.") && !startsWith(m_current_event, "clock."))
+  if (!quiet)
     {
     if (m_trace)
       ESP_LOGI(TAG, "Signal(%s)",m_current_event.c_str());
@@ -297,35 +326,26 @@ void OvmsEvents::HandleQueueSignalEvent(event_queue_t* msg)
       ESP_LOGD(TAG, "Signal(%s)",m_current_event.c_str());
     }
 
-  auto k = m_map.find(m_current_event);
-  if (k != m_map.end())
+  if (el)
     {
-    EventCallbackList* el = k->second;
-    if (el)
+    for (EventCallbackList::iterator itc=el->begin(); itc!=el->end(); ++itc)
       {
-      for (EventCallbackList::iterator itc=el->begin(); itc!=el->end(); ++itc)
-        {
-        m_current_started = monotonictime;
-        m_current_callback = *itc;
-        m_current_callback->m_callback(m_current_event, msg->body.signal.data);
-        m_current_callback = NULL;
-        }
+      m_current_started = monotonictime;
+      m_current_callback = *itc;
+      m_current_callback->m_callback(m_current_event, msg->body.signal.data);
+      m_current_callback = NULL;
       }
     }
 
-  k = m_map.find("*");
-  if (k != m_map.end())
+  el = m_wildcard;
+  if (el)
     {
-    EventCallbackList* el = k->second;
-    if (el)
+    for (EventCallbackList::iterator itc=el->begin(); itc!=el->end(); ++itc)
       {
-      for (EventCallbackList::iterator itc=el->begin(); itc!=el->end(); ++itc)
-        {
-        m_current_started = monotonictime;
-        m_current_callback = *itc;
-        m_current_callback->m_callback(m_current_event, msg->body.signal.data);
-        m_current_callback = NULL;
-        }
+      m_current_started = monotonictime;
+      m_current_callback = *itc;
+      m_current_callback->m_callback(m_current_event, msg->body.signal.data);
+      m_current_callback = NULL;
       }
     }
 
@@ -339,9 +359,73 @@ void OvmsEvents::FreeQueueSignalEvent(event_queue_t* msg)
   {
   if (msg->body.signal.donefn != NULL)
     {
-    msg->body.signal.donefn(msg->body.signal.event, msg->body.signal.data);
+    const char* event = msg->body.signal.event;
+    if (!event)
+      event = GetEventName(msg->body.signal.id);
+    msg->body.signal.donefn(event, msg->body.signal.data);
+    }
+  if (msg->body.signal.event)
+    free(msg->body.signal.event);
+  }
+
+event_id_t OvmsEvents::Intern(const std::string& event)
+  {
+  OvmsMutexLock lock(&m_event_mutex);
+  auto it = m_event_ids.find(event);
+  if (it != m_event_ids.end())
+    return it->second;
+
+  int id = m_event_count;
+  if (id >= EVENT_ID_CHUNKS * EVENT_ID_CHUNKSIZE)
+    {
+    if (id == EVENT_ID_CHUNKS * EVENT_ID_CHUNKSIZE)
+      {
+      ESP_LOGW(TAG, "Intern: event table full, further events will be passed by name");
+      m_event_count = id + 1;
+      }
+    return EVENT_ID_NONE;
+    }
+
+  event_entry_t* chunk = m_events[id / EVENT_ID_CHUNKSIZE];
+  if (!chunk)
+    {
+    chunk = (event_entry_t*) ExternalRamCalloc(EVENT_ID_CHUNKSIZE, sizeof(event_entry_t));
+    if (!chunk)
+      return EVENT_ID_NONE;
+    m_events[id / EVENT_ID_CHUNKSIZE] = chunk;
     }
-  free(msg->body.signal.event);
+  char* name = (char*) ExternalRamMalloc(event.size()+1);
+  if (!name)
+    return EVENT_ID_NONE;
+  strcpy(name, event.c_str());
+
+  event_entry_t* entry = &chunk[id % EVENT_ID_CHUNKSIZE];
+  entry->name = name;
+  entry->listeners = NULL;
+  entry->quiet = startsWith(event, "ticker.") || startsWith(event, "clock.");
+  m_event_ids[event] = id;
+
+  // publish the entry:
+  m_event_count = id + 1;
+  return id;
+  }
+
+/**
+ * Lookup: get the ID of an interned event name, EVENT_ID_NONE if not interned
+ *  Signalling doesn't intern names, so dynamic events (e.g. clock.HHMM, usr.*)
+ *  without listeners don't fill the table.
+ */
+event_id_t OvmsEvents::Lookup(const std::string& event)
+  {
+  OvmsMutexLock lock(&m_event_mutex);
+  auto it = m_event_ids.find(event);
+  return (it != m_event_ids.end()) ? it->second : EVENT_ID_NONE;
+  }
+
+const char* OvmsEvents::GetEventName(event_id_t id)
+  {
+  event_entry_t* entry = GetEntry(id);
+  return entry ? entry->name : "";
   }
 
 void OvmsEvents::RegisterEvent(std::string caller, std::string event, EventCallback callback)
@@ -360,6 +444,12 @@ void OvmsEvents::RegisterEvent(std::string caller, std::string event, EventCallb
 
   EventCallbackList *el = k->second;
   el->push_back(new EventCallbackEntry(caller,callback));
+
+  // Link the list to the dispatcher:
+  if (event == "*")
+    m_wildcard = el;
+  else if (event_entry_t* entry = GetEntry(Intern(event)))
+    entry->listeners = el;
   }
 
 void OvmsEvents::DeregisterEvent(std::string caller)
@@ -384,6 +474,10 @@ void OvmsEvents::DeregisterEvent(std::string caller)
       }
     if (el->empty())
       {
+      if (itm->first == "*")
+        m_wildcard = NULL;
+      else if (event_entry_t* entry = GetEntry(Intern(itm->first)))
+        entry->listeners = NULL;
       itm = m_map.erase(itm);
       delete el;
       }
@@ -394,7 +488,7 @@ void OvmsEvents::DeregisterEvent(std::string caller)
     }
   }
 
-static void CheckQueueOverflow(const char* from, char* event)
+static void CheckQueueOverflow(const char* from, const char* event)
   {
   EventCallbackEntry* cbe = MyEvents.m_current_callback;
   if (cbe != NULL)
@@ -444,7 +538,8 @@ void OvmsEvents::SignalScheduledEvent(TimerHandle_t timer)
   // … and pass on to event task:
   if (xQueueSend(MyEvents.m_taskqueue, msg, 0) != pdTRUE)
     {
-    CheckQueueOverflow("SignalScheduledEvent", msg->body.signal.event);
+    CheckQueueOverflow("SignalScheduledEvent", msg->body.signal.event
+      ? msg->body.signal.event : MyEvents.GetEventName(msg->body.signal.id));
     MyEvents.FreeQueueSignalEvent(msg);
     }
 
@@ -508,34 +603,63 @@ bool OvmsEvents::ScheduleEvent(event_queue_t* msg, uint32_t delay_ms)
   return true;
   }
 
-void OvmsEvents::SignalEvent(std::string event, void* data, event_signal_done_fn callback /*=NULL*/,
-                             uint32_t delay_ms /*=0*/)
+bool OvmsEvents::QueueSignalEvent(event_queue_t* msg, uint32_t delay_ms)
   {
-  event_queue_t msg;
-  memset(&msg, 0, sizeof(msg));
-
-  msg.type = EVENT_signal;
-  msg.body.signal.event = (char*)ExternalRamMalloc(event.size()+1);
-  strcpy(msg.body.signal.event, event.c_str());
-  msg.body.signal.data = data;
-  msg.body.signal.donefn = callback;
-
+  const char* event = msg->body.signal.event
+    ? msg->body.signal.event : GetEventName(msg->body.signal.id);
   if (delay_ms == 0)
     {
-    if (xQueueSend(m_taskqueue, &msg, 0) != pdTRUE)
+    if (xQueueSend(m_taskqueue, msg, 0) != pdTRUE)
       {
-      CheckQueueOverflow("SignalEvent", msg.body.signal.event);
-      FreeQueueSignalEvent(&msg);
+      CheckQueueOverflow("SignalEvent", event);
+      FreeQueueSignalEvent(msg);
+      return false;
       }
     }
   else
     {
-    if (ScheduleEvent(&msg, delay_ms) != true)
+    if (ScheduleEvent(msg, delay_ms) != true)
       {
-      ESP_LOGE(TAG, "SignalEvent: no timer available, event '%s' dropped", msg.body.signal.event);
-      FreeQueueSignalEvent(&msg);
+      ESP_LOGE(TAG, "SignalEvent: no timer available, event '%s' dropped", event);
+      FreeQueueSignalEvent(msg);
+      return false;
       }
     }
+  return true;
+  }
+
+void OvmsEvents::SignalEvent(event_id_t id, void* data, event_signal_done_fn callback /*=NULL*/,
+                             uint32_t delay_ms /*=0*/)
+  {
+  event_queue_t msg;
+  memset(&msg, 0, sizeof(msg));
+
+  msg.type = EVENT_signal;
+  msg.body.signal.id = id;
+  msg.body.signal.event = NULL;
+  msg.body.signal.data = data;
+  msg.body.signal.donefn = callback;
+
+  QueueSignalEvent(&msg, delay_ms);
+  }
+
+void OvmsEvents::SignalEvent(std::string event, void* data, event_signal_done_fn callback /*=NULL*/,
+                             uint32_t delay_ms /*=0*/)
+  {
+  event_queue_t msg;
+  memset(&msg, 0, sizeof(msg));
+
+  msg.type = EVENT_signal;
+  msg.body.signal.id = Lookup(event);
+  if (msg.body.signal.id == EVENT_ID_NONE)
+    {
+    msg.body.signal.event = (char*)ExternalRamMalloc(event.size()+1);
+    strcpy(msg.body.signal.event, event.c_str());
+    }
+  msg.body.signal.data = data;
+  msg.body.signal.donefn = callback;
+
+  QueueSignalEvent(&msg, delay_ms);
   }
 
 void OvmsEvents::SignalEvent(std::string event, void* data, size_t length,
@@ -545,8 +669,12 @@ void OvmsEvents::SignalEvent(std::string event, void* data, size_t length,
   memset(&msg, 0, sizeof(msg));
 
   msg.type = EVENT_signal;
-  msg.body.signal.event = (char*)ExternalRamMalloc(event.size()+1);
-  strcpy(msg.body.signal.event, event.c_str());
+  msg.body.signal.id = Lookup(event);
+  if (msg.body.signal.id == EVENT_ID_NONE)
+    {
+    msg.body.signal.event = (char*)ExternalRamMalloc(event.size()+1);
+    strcpy(msg.body.signal.event, event.c_str());
+    }
   if (data != NULL)
     {
     msg.body.signal.data = ExternalRamMalloc(length);
@@ -559,22 +687,7 @@ void OvmsEvents::SignalEvent(std::string event, void* data, size_t length,
     msg.body.signal.donefn = NULL;
     }
 
-  if (delay_ms == 0)
-    {
-    if (xQueueSend(m_taskqueue, &msg, 0) != pdTRUE)
-      {
-      CheckQueueOverflow("SignalEvent", msg.body.signal.event);
-      FreeQueueSignalEvent(&msg);
-      }
-    }
-  else
-    {
-    if (ScheduleEvent(&msg, delay_ms) != true)
-      {
-      ESP_LOGE(TAG, "SignalEvent: no timer available, event '%s' dropped", msg.body.signal.event);
-      FreeQueueSignalEvent(&msg);
-      }
-    }
+  QueueSignalEvent(&msg, delay_ms);
   }
 
 #if ESP_IDF_VERSION_MAJOR >= 4
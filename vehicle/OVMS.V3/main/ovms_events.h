@@ -79,13 +79,34 @@ typedef enum
   EVENT_signal                // Raise a signal
   } event_msg_t;
 
+/**
+ * Event names are interned into integer IDs on listener registration or by an
+ *  explicit Intern(), so signals can be queued without copying the name, and
+ *  dispatched without looking up the listeners. Interned names are never freed.
+ *  Events not interned (or if the table is full) are passed by name (heap copy)
+ *  instead, with id EVENT_ID_NONE. Signalling by name needs a locked lookup, so
+ *  frequent signals of fixed names should keep and use the interned ID.
+ */
+typedef uint16_t event_id_t;
+#define EVENT_ID_NONE           0xffff
+#define EVENT_ID_CHUNKSIZE      64
+#define EVENT_ID_CHUNKS         64      // = max 4096 interned event names
+
+typedef struct
+  {
+  const char* name;                     // interned event name
+  EventCallbackList* listeners;         // NULL if no listeners
+  bool quiet;                           // ticker & clock events: no logging
+  } event_entry_t;
+
 typedef struct
   {
   union
     {
     struct
       {
-      char* event;
+      event_id_t id;
+      char* event;                      // only used for non-interned events
       void* data;
       event_signal_done_fn donefn;
       } signal;
@@ -107,6 +128,13 @@ class OvmsEvents
     void DeregisterEvent(std::string caller);
     void SignalEvent(std::string event, void* data, event_signal_done_fn callback = NULL, uint32_t delay_ms = 0);
     void SignalEvent(std::string event, void* data, size_t length, uint32_t delay_ms = 0);
+    void SignalEvent(event_id_t id, void* data, event_signal_done_fn callback = NULL, uint32_t delay_ms = 0);
+
+  public:
+    event_id_t Intern(const std::string& event);
+    event_id_t Lookup(const std::string& event);
+    const char* GetEventName(event_id_t id);
+    int GetInternedCount() { return m_event_count; }
 
   public:
     void EventTask();
@@ -123,6 +151,19 @@ class OvmsEvents
   protected:
     bool ScheduleEvent(event_queue_t* msg, uint32_t delay_ms);
     static void SignalScheduledEvent(TimerHandle_t timer);
+    bool QueueSignalEvent(event_queue_t* msg, uint32_t delay_ms);
+    event_entry_t* GetEntry(event_id_t id)
+      {
+      if (id >= m_event_count) return NULL;
+      return &m_events[id / EVENT_ID_CHUNKSIZE][id % EVENT_ID_CHUNKSIZE];
+      }
+
+  protected:
+    event_entry_t* m_events[EVENT_ID_CHUNKS];
+    std::map<std::string, event_id_t> m_event_ids;
+    volatile int m_event_count;
+    OvmsMutex m_event_mutex;
+    EventCallbackList* m_wildcard;
 
   protected:
     EventMap m_map;
@@ -107,18 +107,26 @@ void HousekeepingTicker1( TimerHandle_t timer )
   StandardMetrics.ms_m_monotonic->SetValue((int)monotonictime);
   StandardMetrics.ms_m_timeutc->SetValue(time(NULL));
 
+  // Ticker event IDs:
+  static event_id_t ev_ticker1 = MyEvents.Intern("ticker.1");
+  static event_id_t ev_ticker10 = MyEvents.Intern("ticker.10");
+  static event_id_t ev_ticker60 = MyEvents.Intern("ticker.60");
+  static event_id_t ev_ticker300 = MyEvents.Intern("ticker.300");
+  static event_id_t ev_ticker600 = MyEvents.Intern("ticker.600");
+  static event_id_t ev_ticker3600 = MyEvents.Intern("ticker.3600");
+
   HousekeepingUpdate12V();
-  MyEvents.SignalEvent("ticker.1", NULL);
+  MyEvents.SignalEvent(ev_ticker1, NULL);
 
   tick++;
-  if ((tick % 10)==0) MyEvents.SignalEvent("ticker.10", NULL);
-  if ((tick % 60)==0) MyEvents.SignalEvent("ticker.60", NULL);
-  if ((tick % 300)==0) MyEvents.SignalEvent("ticker.300", NULL);
-  if ((tick % 600)==0) MyEvents.SignalEvent("ticker.600", NULL);
+  if ((tick % 10)==0) MyEvents.SignalEvent(ev_ticker10, NULL);
+  if ((tick % 60)==0) MyEvents.SignalEvent(ev_ticker60, NULL);
+  if ((tick % 300)==0) MyEvents.SignalEvent(ev_ticker300, NULL);
+  if ((tick % 600)==0) MyEvents.SignalEvent(ev_ticker600, NULL);
   if ((tick % 3600)==0)
     {
     tick = 0;
-    MyEvents.SignalEvent("ticker.3600", NULL);
+    MyEvents.SignalEvent(ev_ticker3600, NULL);
     }
 
   time_t rawtime;
@@ -36,12 +36,15 @@ static const char *TAG = "metrics";
 #include <sstream>
 #include <functional>
 #include <map>
+#include <algorithm>
 #include "ovms.h"
 #include "ovms_metrics.h"
 #include "ovms_command.h"
 #include "ovms_events.h"
 #include "ovms_script.h"
 #include "ovms_config.h"
+#include "ovms_malloc.h"
+#include "ovms_utils.h"
 #include "rom/rtc.h"
 #include "string.h"
 #include <iomanip>
@@ -52,13 +55,14 @@ static const char *TAG = "metrics";
 using namespace std;
 
 #define PERSISTENT_METRICS_MAGIC        (('O' << 24) | ('V' << 16) | ('M' << 8) | '3')
-#define PERSISTENT_VERSION              3                     // increment when struct is changed
+#define PERSISTENT_VERSION              4                     // increment when struct is changed
 
 RTC_NOINIT_ATTR persistent_metrics      pmetrics;             // persistent storage container
-#define NUM_PERSISTENT_VALUES           sizeof_array(pmetrics.values)
 static const char*                      pmetrics_reason;      // reason pmetrics was zeroed
 std::map<std::size_t, std::string>      pmetrics_keymap       // hash key → metric name map (registry)
                                         __attribute__ ((init_priority (1800)));
+OvmsRecMutex                            pmetrics_mutex        // slab allocation & index lock
+                                        __attribute__ ((init_priority (1800)));
 
 OvmsMetrics                             MyMetrics
                                         __attribute__ ((init_priority (1800)));
@@ -631,6 +635,57 @@ void metrics_list(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc,
     writer->puts("Unrecognised metric name");
   }
 
+static inline persistent_values *pmetrics_record(uint16_t ref)
+  {
+  // ref = slab offset + 1, 0 = none
+  if (ref == 0 || ref - 1 + PERSISTENT_HEADER_SIZE > pmetrics.top)
+    return NULL;
+  return reinterpret_cast<persistent_values*>(&pmetrics.slab[ref - 1]);
+  }
+
+static inline uint16_t pmetrics_ref(persistent_values *vp)
+  {
+  return (reinterpret_cast<uint8_t*>(vp) - pmetrics.slab) + 1;
+  }
+
+static inline size_t pmetrics_recsize(persistent_values *vp)
+  {
+  return PERSISTENT_HEADER_SIZE + vp->capacity;
+  }
+
+static inline persistent_values *pmetrics_next_record(persistent_values *vp)
+  {
+  // Walk the slab in address order, vp = NULL starts at the first record:
+  size_t offset = vp ? (pmetrics_ref(vp) - 1 + pmetrics_recsize(vp)) : 0;
+  if (offset + PERSISTENT_HEADER_SIZE > pmetrics.top)
+    return NULL;
+  return reinterpret_cast<persistent_values*>(&pmetrics.slab[offset]);
+  }
+
+static inline uint16_t &pmetrics_bucket(size_t namehash)
+  {
+  return pmetrics.index[namehash & (PERSISTENT_INDEX_SIZE-1)];
+  }
+
+static uint32_t pmetrics_checksum()
+  {
+  // FNV-1a over the index and the record layout. Payloads and lengths are
+  // excluded, as they change with every value update.
+  uint32_t sum = 2166136261U;
+  auto add = [&sum](uint32_t v) { sum = (sum ^ v) * 16777619U; };
+  add(pmetrics.used);
+  add(pmetrics.top);
+  for (int i = 0; i < PERSISTENT_INDEX_SIZE; i++)
+    add(pmetrics.index[i]);
+  for (persistent_values *vp = pmetrics_next_record(NULL); vp; vp = pmetrics_next_record(vp))
+    {
+    add(vp->namehash);
+    add((vp->type << 24) | (vp->elemsize << 16) | vp->next);
+    add(vp->capacity);
+    }
+  return sum;
+  }
+
 void metrics_persist(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
   {
   if (argc > 0)
@@ -648,8 +703,29 @@ void metrics_persist(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int ar
   writer->printf("serial %d, ", pmetrics.serial);
   if (pmetrics_reason != NULL)
     writer->printf("%s caused reset, ", pmetrics_reason);
-  writer->printf("%d bytes, and ", pmetrics.size);
-  writer->printf("%d of %d slots used\n", pmetrics.used, NUM_PERSISTENT_VALUES);
+  writer->printf("%d bytes, ", pmetrics.size);
+  writer->printf("%d records using %u of %u bytes\n", pmetrics.used, pmetrics.top, sizeof(pmetrics.slab));
+  if (pmetrics.magic != PERSISTENT_METRICS_MAGIC || pmetrics.top > sizeof(pmetrics.slab))
+    return;
+
+  static const char* const typenames[] = { "free", "scalar", "array", "string" };
+  OvmsRecMutexLock lock(&pmetrics_mutex);
+  writer->printf("\n%-40s %-6s %5s %5s\n", "Metric", "Type", "Bytes", "Used");
+  for (persistent_values *vp = pmetrics_next_record(NULL); vp; vp = pmetrics_next_record(vp))
+    {
+    std::string name;
+    if (vp->type != PERSISTENT_TYPE_FREE)
+      {
+      auto it = pmetrics_keymap.find(vp->namehash);
+      if (it != pmetrics_keymap.end())
+        name = it->second;
+      else
+        name = string_format("#%08x", (unsigned int) vp->namehash);
+      }
+    writer->printf("%-40.40s %-6s %5u %5u\n", name.c_str(),
+      (vp->type <= PERSISTENT_TYPE_STRING) ? typenames[vp->type] : "?",
+      pmetrics_recsize(vp), vp->length);
+    }
   }
 
 static int metrics_set_validate(OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv, bool complete)
@@ -725,10 +801,34 @@ bool pmetrics_check()
     ESP_LOGE(TAG, "pmetrics_check: bad size");
     ret = false;
     }
-  if ((pmetrics.used < 0 || pmetrics.used > NUM_PERSISTENT_VALUES))
+  if (pmetrics.top > sizeof(pmetrics.slab) || pmetrics.used < 0)
     {
     ESP_LOGE(TAG, "pmetrics_check: out of range used");
-    ret = false;
+    return false;
+    }
+  if (pmetrics.checksum != pmetrics_checksum())
+    {
+    ESP_LOGE(TAG, "pmetrics_check: bad checksum");
+    return false;
+    }
+  int used = 0;
+  size_t top = 0;
+  for (persistent_values *vp = pmetrics_next_record(NULL); vp; vp = pmetrics_next_record(vp))
+    {
+    if (vp->type > PERSISTENT_TYPE_STRING || vp->length > vp->capacity
+      || (vp->capacity % sizeof(persistent_value_t)) != 0)
+      {
+      ESP_LOGE(TAG, "pmetrics_check: bad record at offset %u", pmetrics_ref(vp) - 1);
+      return false;
+      }
+    if (vp->type != PERSISTENT_TYPE_FREE)
+      used++;
+    top = pmetrics_ref(vp) - 1 + pmetrics_recsize(vp);
+    }
+  if (used != pmetrics.used || top != pmetrics.top)
+    {
+    ESP_LOGE(TAG, "pmetrics_check: bad slab layout");
+    return false;
     }
   for (OvmsMetric* m = MyMetrics.m_first; m != NULL; m = m->m_next)
     {
@@ -743,11 +843,14 @@ bool pmetrics_check()
 
 static persistent_values *pmetrics_find_hash(size_t namehash)
   {
-  int i;
   persistent_values *vp;
-  for (i = 0, vp = pmetrics.values; i < pmetrics.used; ++i, ++vp) {
+  int cnt = 0;
+  for (uint16_t ref = pmetrics_bucket(namehash); (vp = pmetrics_record(ref)) != NULL; ref = vp->next)
+    {
     if (vp->namehash == namehash)
       return vp;
+    if (++cnt > pmetrics.used)
+      break; // corrupted chain
     }
   return NULL;
   }
@@ -755,21 +858,28 @@ static persistent_values *pmetrics_find_hash(size_t namehash)
 persistent_values *pmetrics_find(const char *name)
   {
   std::size_t namehash = std::hash<std::string>{}(name);
+  OvmsRecMutexLock lock(&pmetrics_mutex);
   return pmetrics_find_hash(namehash);
   }
 
 persistent_values *pmetrics_find(const std::string &name)
   {
   std::size_t namehash = std::hash<std::string>{}(name);
+  OvmsRecMutexLock lock(&pmetrics_mutex);
   return pmetrics_find_hash(namehash);
   }
 
 void pmetrics_init(bool refresh = false)
   {
-  memset(&pmetrics, 0, sizeof(pmetrics));
-  pmetrics.magic = PERSISTENT_METRICS_MAGIC;
-  pmetrics.version = PERSISTENT_VERSION;
-  pmetrics.size = sizeof(persistent_metrics);
+    {
+    OvmsRecMutexLock lock(&pmetrics_mutex);
+    memset(&pmetrics, 0, sizeof(pmetrics));
+    pmetrics.magic = PERSISTENT_METRICS_MAGIC;
+    pmetrics.version = PERSISTENT_VERSION;
+    pmetrics.size = sizeof(persistent_metrics);
+    pmetrics.checksum = pmetrics_checksum();
+    }
+  // Metrics lock themselves before the pmetrics mutex, so refresh unlocked:
   if (refresh)
     {
     for (OvmsMetric* m = MyMetrics.m_first; m != NULL; m = m->m_next)
@@ -777,17 +887,81 @@ void pmetrics_init(bool refresh = false)
     }
   }
 
-persistent_values *pmetrics_register(const char *name)
+static void pmetrics_release(persistent_values *vp)
+  {
+  // Unlink from bucket:
+  uint16_t ref = pmetrics_ref(vp);
+  uint16_t *refp = &pmetrics_bucket(vp->namehash);
+  persistent_values *cp;
+  while ((cp = pmetrics_record(*refp)) != NULL && *refp != ref)
+    refp = &cp->next;
+  if (*refp == ref)
+    *refp = vp->next;
+  --pmetrics.used;
+
+  // Give back tail space, else leave a hole for reuse:
+  if (ref - 1 + pmetrics_recsize(vp) == pmetrics.top)
+    {
+    pmetrics.top = ref - 1;
+    }
+  else
+    {
+    vp->namehash = 0;
+    vp->type = PERSISTENT_TYPE_FREE;
+    vp->elemsize = 0;
+    vp->next = 0;
+    vp->length = 0;
+    }
+  }
+
+static persistent_values *pmetrics_alloc(size_t namehash, size_t capacity, uint8_t type, uint8_t elemsize)
+  {
+  capacity = (capacity + sizeof(persistent_value_t) - 1) & ~(sizeof(persistent_value_t) - 1);
+  if (capacity == 0)
+    capacity = sizeof(persistent_value_t);
+  if (capacity > sizeof(pmetrics.slab))
+    return NULL;
+
+  // Reuse the best fitting hole, else append:
+  persistent_values *vp = NULL;
+  for (persistent_values *cp = pmetrics_next_record(NULL); cp; cp = pmetrics_next_record(cp))
+    {
+    if (cp->type == PERSISTENT_TYPE_FREE && cp->capacity >= capacity
+      && (!vp || cp->capacity < vp->capacity))
+      vp = cp;
+    }
+  if (!vp)
+    {
+    if (pmetrics.top + PERSISTENT_HEADER_SIZE + capacity > sizeof(pmetrics.slab))
+      return NULL;
+    vp = reinterpret_cast<persistent_values*>(&pmetrics.slab[pmetrics.top]);
+    vp->capacity = capacity;
+    pmetrics.top += PERSISTENT_HEADER_SIZE + capacity;
+    }
+
+  vp->namehash = namehash;
+  vp->type = type;
+  vp->elemsize = elemsize;
+  vp->length = (type == PERSISTENT_TYPE_SCALAR) ? vp->capacity : 0;
+  memset(&vp->value, 0, vp->capacity);
+  uint16_t &bucket = pmetrics_bucket(namehash);
+  vp->next = bucket;
+  bucket = pmetrics_ref(vp);
+  ++pmetrics.used;
+  return vp;
+  }
+
+persistent_values *pmetrics_register(const char *name, size_t capacity, uint8_t type, uint8_t elemsize)
   {
   std::string str_name(name);
-  return pmetrics_register(str_name);
+  return pmetrics_register(str_name, capacity, type, elemsize);
   }
 
-persistent_values *pmetrics_register(const std::string &name)
+persistent_values *pmetrics_register(const std::string &name, size_t capacity, uint8_t type, uint8_t elemsize)
   {
-  int i;
   persistent_values *vp;
   std::size_t namehash = std::hash<std::string>{}(name);
+  OvmsRecMutexLock lock(&pmetrics_mutex);
 
   // check for hash collision:
   auto it = pmetrics_keymap.find(namehash);
@@ -798,32 +972,66 @@ persistent_values *pmetrics_register(const std::string &name)
     return NULL;
     }
 
-  // find slot:
-  for (i = 0, vp = pmetrics.values; i < pmetrics.used; ++i, ++vp)
+  // find record, drop it if the layout does not match:
+  vp = pmetrics_find_hash(namehash);
+  if (vp && (vp->type != type || vp->elemsize != elemsize || vp->capacity < capacity))
     {
-    if (vp->namehash == namehash)
-      break;
+    ESP_LOGW(TAG, "pmetrics_register: '%s' layout changed, value dropped", name.c_str());
+    pmetrics_release(vp);
+    vp = NULL;
     }
 
-  // not found? assign to next free slot:
-  if (i >= pmetrics.used)
+  // not found? allocate new record:
+  if (!vp)
     {
-    if (i >= NUM_PERSISTENT_VALUES)
+    vp = pmetrics_alloc(namehash, capacity, type, elemsize);
+    if (!vp)
       {
-      ESP_LOGE(TAG, "pmetrics_register: no free slots, cannot persist '%s'", name.c_str());
+      ESP_LOGE(TAG, "pmetrics_register: no free space, cannot persist '%s' (%u bytes)",
+        name.c_str(), capacity);
+      pmetrics.checksum = pmetrics_checksum();
       return NULL;
       }
-    vp->namehash = namehash;
-    memset(&vp->value, 0, sizeof(vp->value));
-    ++pmetrics.used;
+    pmetrics.checksum = pmetrics_checksum();
     }
 
-  ESP_LOGD(TAG, "pmetrics_register: '%s' => slot=%d, used %d/%d",
-    name.c_str(), i, pmetrics.used, NUM_PERSISTENT_VALUES);
+  ESP_LOGD(TAG, "pmetrics_register: '%s' => offset=%u, used %u/%u bytes",
+    name.c_str(), pmetrics_ref(vp) - 1, pmetrics.top, sizeof(pmetrics.slab));
   pmetrics_keymap[namehash] = name;
   return vp;
   }
 
+persistent_values *pmetrics_resize(persistent_values *vp, size_t capacity)
+  {
+  OvmsRecMutexLock lock(&pmetrics_mutex);
+  if (capacity <= vp->capacity)
+    return vp;
+
+  // Grow in place if this is the last record:
+  size_t offset = pmetrics_ref(vp) - 1;
+  capacity = (capacity + sizeof(persistent_value_t) - 1) & ~(sizeof(persistent_value_t) - 1);
+  if (offset + pmetrics_recsize(vp) == pmetrics.top
+    && offset + PERSISTENT_HEADER_SIZE + capacity <= sizeof(pmetrics.slab))
+    {
+    memset(reinterpret_cast<uint8_t*>(&vp->value) + vp->capacity, 0, capacity - vp->capacity);
+    pmetrics.top += capacity - vp->capacity;
+    vp->capacity = capacity;
+    pmetrics.checksum = pmetrics_checksum();
+    return vp;
+    }
+
+  // Move to a new record, the new one will be found first in the bucket chain:
+  persistent_values *nvp = pmetrics_alloc(vp->namehash, capacity, vp->type, vp->elemsize);
+  if (nvp)
+    {
+    memcpy(&nvp->value, &vp->value, vp->length);
+    nvp->length = vp->length;
+    pmetrics_release(vp);
+    }
+  pmetrics.checksum = pmetrics_checksum();
+  return nvp;
+  }
+
 void OvmsMetrics::EventSystemShutDown(std::string event, void* data)
   {
   /* Check for corruption and repair of possible before shutting down */
@@ -1049,7 +1257,14 @@ OvmsMetrics::OvmsMetrics()
 
   m_nextmodifier = 1;
   m_first = NULL;
+  m_listeners_all = NULL;
   m_trace = false;
+  m_index = NULL;
+  m_count = 0;
+  m_generation = 0;
+  for (int i = 0; i < METRICS_MAX_MODIFIERS; i++)
+    m_journal[i] = NULL;
+  m_journal_mask = 0;
 
   // Register our commands
   OvmsCommand* cmd_metric = MyCommandApp.RegisterCommand("metrics","METRICS framework");
@@ -1063,7 +1278,7 @@ OvmsMetrics::OvmsMetrics()
       "-p = display only persistent metrics\n"
       "-s = show metric staleness\n"
       "-t = display non-printing characters and tabs in string metrics" , 0, 2);
-  cmd_metric->RegisterCommand("persist","Show persistent metrics info", metrics_persist, "[-r]\n"
+  cmd_metric->RegisterCommand("persist","Show persistent metrics info & storage usage", metrics_persist, "[-r]\n"
       "-r = reset persistent metrics", 0, 1);
   cmd_metric->RegisterCommand("set","Set the value of a metric",metrics_set, "<metric> <value> [<unit>]", 2, 3, true, metrics_set_validate);
 
@@ -1088,8 +1303,8 @@ OvmsMetrics::OvmsMetrics()
   /* Initialize persistent metrics on cold boot or corruption */
   if (rtc_get_reset_reason(0) == POWERON_RESET || !pmetrics_check())
     pmetrics_init();
-  ESP_LOGI(TAG, "Persistent metrics serial %u using %d bytes, %d/%d slots used",
-      ++pmetrics.serial, sizeof(pmetrics), pmetrics.used, NUM_PERSISTENT_VALUES);
+  ESP_LOGI(TAG, "Persistent metrics serial %u using %d bytes, %d records in %u/%u bytes",
+      ++pmetrics.serial, sizeof(pmetrics), pmetrics.used, pmetrics.top, sizeof(pmetrics.slab));
 
   // Register our event
 #ifdef bind
@@ -1110,14 +1325,28 @@ OvmsMetrics::~OvmsMetrics()
     m = m->m_next;
     delete c;
     }
+  for (OvmsMetricIndex* index : m_index_retired)
+    free(index);
+  free(m_index);
   }
 
 void OvmsMetrics::RegisterMetric(OvmsMetric* metric)
   {
+  m_count++;
+
+  // Attach listeners registered before the metric:
+  if (!m_listeners.empty())
+    {
+    auto k = m_listeners.find(metric->m_name);
+    if (k != m_listeners.end())
+      metric->m_listeners = k->second;
+    }
+
   // Quick simple check for if we are the first metric.
   if (m_first == NULL)
     {
     m_first = metric;
+    IndexInsert(metric);
     return;
     }
 
@@ -1126,6 +1355,7 @@ void OvmsMetrics::RegisterMetric(OvmsMetric* metric)
     {
     metric->m_next = m_first;
     m_first = metric;
+    IndexInsert(metric);
     return;
     }
 
@@ -1135,12 +1365,14 @@ void OvmsMetrics::RegisterMetric(OvmsMetric* metric)
     if (m->m_next == NULL)
       {
       m->m_next = metric;
+      IndexInsert(metric);
       return;
       }
     if (strcmp(m->m_next->m_name,metric->m_name)>=0)
       {
       metric->m_next = m->m_next;
       m->m_next = metric;
+      IndexInsert(metric);
       return;
       }
     }
@@ -1148,9 +1380,21 @@ void OvmsMetrics::RegisterMetric(OvmsMetric* metric)
 
 void OvmsMetrics::DeregisterMetric(OvmsMetric* metric)
   {
+  // Invalidate cursors:
+  m_generation++;
+
+  // Journals may hold the metric, let them drop their queues:
+  for (int i = 0; i < METRICS_MAX_MODIFIERS; i++)
+    {
+    if (m_journal[i])
+      m_journal[i]->Rescan();
+    }
+
   if (m_first == metric)
     {
     m_first = metric->m_next;
+    m_count--;
+    IndexRemove(metric);
     delete metric;
     return;
     }
@@ -1160,12 +1404,138 @@ void OvmsMetrics::DeregisterMetric(OvmsMetric* metric)
     if (m->m_next == metric)
       {
       m->m_next = metric->m_next;
+      m_count--;
+      IndexRemove(metric);
       delete metric;
       return;
       }
     }
   }
 
+#define METRIC_INDEX_MINSIZE    256
+#define METRIC_INDEX_TOMBSTONE  ((OvmsMetric*)1)
+
+static inline uint32_t metric_name_hash(const char* name)
+  {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  while (*name)
+    {
+    hash ^= (uint8_t) *name++;
+    hash *= 16777619u;
+    }
+  return hash;
+  }
+
+void OvmsMetrics::IndexInsert(OvmsMetric* metric)
+  {
+  // Keep the load (including tombstones) below 75%, so probing always ends on an empty slot:
+  if (m_index == NULL || (m_index->used + 1) * 4 > m_index->size * 3)
+    {
+    // The rebuild indexes the metric list, which already includes the new metric:
+    IndexRebuild();
+    return;
+    }
+
+  size_t mask = m_index->size - 1;
+  OvmsMetric** reuse = NULL;
+  for (size_t i = metric_name_hash(metric->m_name) & mask; ; i = (i+1) & mask)
+    {
+    OvmsMetric* m = m_index->slot[i];
+    if (m == NULL)
+      {
+      if (reuse)
+        {
+        *reuse = metric;
+        }
+      else
+        {
+        m_index->slot[i] = metric;
+        m_index->used++;
+        }
+      return;
+      }
+    else if (m == METRIC_INDEX_TOMBSTONE)
+      {
+      if (!reuse)
+        reuse = &m_index->slot[i];
+      }
+    else if (strcmp(m->m_name, metric->m_name) == 0)
+      {
+      // Duplicate name: the newest metric wins, same as in the sorted list
+      m_index->slot[i] = metric;
+      return;
+      }
+    }
+  }
+
+void OvmsMetrics::IndexRemove(OvmsMetric* metric)
+  {
+  if (m_index == NULL)
+    return;
+  size_t mask = m_index->size - 1;
+  for (size_t i = metric_name_hash(metric->m_name) & mask; ; i = (i+1) & mask)
+    {
+    OvmsMetric* m = m_index->slot[i];
+    if (m == NULL)
+      return;
+    if (m == metric)
+      {
+      // Fall back to an older metric of the same name, if any is left in the list:
+      OvmsMetric* dup;
+      for (dup = m_first; dup != NULL; dup = dup->m_next)
+        {
+        if (strcmp(dup->m_name, metric->m_name) == 0)
+          break;
+        }
+      m_index->slot[i] = dup ? dup : METRIC_INDEX_TOMBSTONE;
+      return;
+      }
+    }
+  }
+
+void OvmsMetrics::IndexRebuild()
+  {
+  size_t size = METRIC_INDEX_MINSIZE;
+  while (size < m_count * 2)
+    size <<= 1;
+
+  OvmsMetricIndex* index = (OvmsMetricIndex*) ExternalRamCalloc(1,
+    sizeof(OvmsMetricIndex) + size * sizeof(OvmsMetric*));
+  if (!index)
+    {
+    ESP_LOGE(TAG, "IndexRebuild: out of memory for %u slots", size);
+    abort();
+    }
+  index->size = size;
+  index->used = 0;
+  index->slot = (OvmsMetric**) (index + 1);
+
+  // The list is sorted with the newest of equally named metrics first, so the first one wins:
+  size_t mask = size - 1;
+  for (OvmsMetric* m = m_first; m != NULL; m = m->m_next)
+    {
+    size_t i;
+    for (i = metric_name_hash(m->m_name) & mask; index->slot[i] != NULL; i = (i+1) & mask)
+      {
+      if (strcmp(index->slot[i]->m_name, m->m_name) == 0)
+        break;
+      }
+    if (index->slot[i] == NULL)
+      {
+      index->slot[i] = m;
+      index->used++;
+      }
+    }
+
+  // Readers may still be probing the old table, so it's retired instead of freed.
+  // As the table size doubles on each growth, this costs less than the current table.
+  if (m_index)
+    m_index_retired.push_back(m_index);
+  m_index = index;
+  ESP_LOGD(TAG, "IndexRebuild: %u metrics in %u slots", m_count, size);
+  }
+
 std::string OvmsMetrics::GetUnitStr(const char* metric, const char *unit)
   {
   OvmsMetric* m = Find(metric);
@@ -1227,11 +1597,15 @@ bool OvmsMetrics::SetFloat(const char* metric, float value)
 
 OvmsMetric* OvmsMetrics::Find(const char* metric)
   {
-  for (OvmsMetric* m=m_first; m != NULL; m=m->m_next)
+  OvmsMetricIndex* index = m_index;
+  if (index == NULL) return NULL;
+  size_t mask = index->size - 1;
+  for (size_t i = metric_name_hash(metric) & mask; ; i = (i+1) & mask)
     {
-    if (strcmp(m->m_name,metric)==0) return m;
+    OvmsMetric* m = index->slot[i];
+    if (m == NULL) return NULL;
+    if (m != METRIC_INDEX_TOMBSTONE && strcmp(m->m_name,metric)==0) return m;
     }
-  return NULL;
   }
 
 OvmsMetric* OvmsMetrics::FindUniquePrefix(const char* token) const
@@ -1358,6 +1732,7 @@ void OvmsMetrics::RegisterListener(std::string caller, std::string name, MetricC
 
   MetricCallbackList *ml = k->second;
   ml->push_back(new MetricCallbackEntry(caller,callback));
+  AttachListeners(name.c_str(), ml);
   }
 
 void OvmsMetrics::DeregisterListener(std::string caller)
@@ -1382,6 +1757,7 @@ void OvmsMetrics::DeregisterListener(std::string caller)
       }
     if (ml->empty())
       {
+      AttachListeners(itm->first.c_str(), NULL);
       itm = m_listeners.erase(itm);
       delete ml;
       }
@@ -1392,6 +1768,26 @@ void OvmsMetrics::DeregisterListener(std::string caller)
     }
   }
 
+/**
+ * AttachListeners: link a listener list to the metric(s) of that name,
+ *  so NotifyModified() can dispatch without looking up the name.
+ *  Metrics registered later on get their list in RegisterMetric().
+ */
+void OvmsMetrics::AttachListeners(const char* name, MetricCallbackList* ml)
+  {
+  if (strcmp(name, "*") == 0)
+    {
+    m_listeners_all = ml;
+    return;
+    }
+  // Scan the list instead of using Find() to also cover shadowed duplicates:
+  for (OvmsMetric* m = m_first; m != NULL; m = m->m_next)
+    {
+    if (strcmp(m->m_name, name) == 0)
+      m->m_listeners = ml;
+    }
+  }
+
 void OvmsMetrics::NotifyModified(OvmsMetric* metric)
   {
   if (m_trace &&
@@ -1405,28 +1801,33 @@ void OvmsMetrics::NotifyModified(OvmsMetric* metric)
       metric->m_name, metric->AsUnitString().c_str());
     }
 
-  auto k = m_listeners.find("*");
-  for (int x=0;x<2;x++)
+  if (m_listeners_all)
     {
-    if (k != m_listeners.end())
-      {
-      MetricCallbackList* ml = k->second;
-      if (ml)
-        {
-        for (MetricCallbackList::iterator itc=ml->begin(); itc!=ml->end(); ++itc)
-          {
-          MetricCallbackEntry* ec = *itc;
-          ec->m_callback(metric);
-          }
-        }
-      }
-    k = m_listeners.find(metric->m_name);
+    for (MetricCallbackEntry* ec : *m_listeners_all)
+      ec->m_callback(metric);
+    }
+  if (metric->m_listeners)
+    {
+    for (MetricCallbackEntry* ec : *metric->m_listeners)
+      ec->m_callback(metric);
     }
   }
 
-size_t OvmsMetrics::RegisterModifier()
+size_t OvmsMetrics::RegisterModifier(bool journal)
   {
-  return m_nextmodifier++;
+  size_t modifier = m_nextmodifier++;
+  if (journal && modifier < METRICS_MAX_MODIFIERS)
+    {
+    // Each metric is queued once until consumed, so the metrics count is sufficient,
+    // some headroom is added for metrics registered later on:
+    size_t size = 128;
+    while (size < m_count + 64)
+      size <<= 1;
+    m_journal[modifier] = new OvmsMetricJournal(modifier, size);
+    m_journal_mask |= 1ul << modifier;
+    ESP_LOGD(TAG, "RegisterModifier: modifier %u uses journal of %u entries", modifier, size);
+    }
+  return modifier;
   }
 
 void OvmsMetrics::InitialiseSlot(size_t modifier)
@@ -1439,6 +1840,194 @@ void OvmsMetrics::InitialiseSlot(size_t modifier)
      if (m->IsDefined())
        m->m_modified |= bit;
     }
+  OvmsMetricJournal* journal = GetJournal(modifier);
+  if (journal)
+    journal->Rescan();
+  }
+
+OvmsMetricCursor::OvmsMetricCursor()
+  {
+  Reset();
+  }
+
+void OvmsMetricCursor::Reset()
+  {
+  m_pos = NULL;
+  m_posname.clear();
+  m_generation = 0;
+  m_valid = false;
+  }
+
+/**
+ * Resume: get the metric at the cursor position (NULL = end of list)
+ */
+OvmsMetric* OvmsMetricCursor::Resume()
+  {
+  uint32_t generation = MyMetrics.GetGeneration();
+  if (!m_valid)
+    {
+    m_pos = MyMetrics.m_first;
+    m_posname = m_pos ? m_pos->m_name : "";
+    m_valid = true;
+    }
+  else if (generation != m_generation && m_pos != NULL)
+    {
+    // the metric at our position may be gone, seek to the first metric
+    // not sorting before it:
+    for (m_pos = MyMetrics.m_first; m_pos != NULL; m_pos = m_pos->m_next)
+      {
+      if (strcmp(m_pos->m_name, m_posname.c_str()) >= 0)
+        break;
+      }
+    }
+  m_generation = generation;
+  return m_pos;
+  }
+
+/**
+ * Advance: step to and get the next metric (NULL = end of list)
+ */
+OvmsMetric* OvmsMetricCursor::Advance()
+  {
+  if (m_pos)
+    {
+    m_pos = m_pos->m_next;
+    if (m_pos)
+      m_posname.assign(m_pos->m_name);
+    }
+  return m_pos;
+  }
+
+OvmsMetricJournal* OvmsMetrics::GetJournal(size_t modifier)
+  {
+  return (modifier < METRICS_MAX_MODIFIERS) ? m_journal[modifier] : NULL;
+  }
+
+/**
+ * NextModified: get the next modified metric for a journaled modifier
+ *  The modifier bit of the metric returned has been cleared.
+ *  Returns NULL if no more modified metrics are pending (or the modifier has no journal).
+ */
+OvmsMetric* OvmsMetrics::NextModified(size_t modifier)
+  {
+  OvmsMetricJournal* journal = GetJournal(modifier);
+  return journal ? journal->Next() : NULL;
+  }
+
+void OvmsMetrics::JournalModified(OvmsMetric* metric, unsigned long newbits)
+  {
+  newbits &= m_journal_mask;
+  for (size_t modifier = 0; newbits != 0; modifier++, newbits >>= 1)
+    {
+    if ((newbits & 1) && m_journal[modifier])
+      m_journal[modifier]->Push(metric);
+    }
+  }
+
+OvmsMetricJournal::OvmsMetricJournal(size_t modifier, size_t size)
+  {
+  m_modifier = modifier;
+  m_mask = size - 1;
+  m_cells = (cell_t*) ExternalRamCalloc(size, sizeof(cell_t));
+  for (size_t i = 0; i < size; i++)
+    m_cells[i].seq.store(i, std::memory_order_relaxed);
+  m_head = 0;
+  m_tail = 0;
+  m_scanpos = NULL;
+  m_scanning = false;
+  m_pushcnt = 0;
+  m_overflowcnt = 0;
+  m_scancnt = 0;
+  // Changes before the journal was created are unknown, so begin with a full scan:
+  m_rescan = true;
+  }
+
+OvmsMetricJournal::~OvmsMetricJournal()
+  {
+  free(m_cells);
+  }
+
+bool OvmsMetricJournal::Push(OvmsMetric* metric)
+  {
+  cell_t* cell;
+  size_t pos = m_head.load(std::memory_order_relaxed);
+  for (;;)
+    {
+    cell = &m_cells[pos & m_mask];
+    size_t seq = cell->seq.load(std::memory_order_acquire);
+    intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+    if (dif == 0)
+      {
+      if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+      }
+    else if (dif < 0)
+      {
+      // queue full: fall back to a full scan
+      m_overflowcnt++;
+      m_rescan = true;
+      return false;
+      }
+    else
+      {
+      pos = m_head.load(std::memory_order_relaxed);
+      }
+    }
+  cell->metric = metric;
+  cell->seq.store(pos + 1, std::memory_order_release);
+  m_pushcnt++;
+  return true;
+  }
+
+OvmsMetric* OvmsMetricJournal::Pop()
+  {
+  cell_t* cell = &m_cells[m_tail & m_mask];
+  size_t seq = cell->seq.load(std::memory_order_acquire);
+  if ((intptr_t)seq - (intptr_t)(m_tail + 1) < 0)
+    return NULL;
+  OvmsMetric* metric = cell->metric;
+  cell->seq.store(m_tail + m_mask + 1, std::memory_order_release);
+  m_tail++;
+  return metric;
+  }
+
+void OvmsMetricJournal::Rescan()
+  {
+  m_rescan = true;
+  }
+
+OvmsMetric* OvmsMetricJournal::Next()
+  {
+  OvmsMetric* m;
+
+  if (m_rescan.exchange(false))
+    {
+    // drop the queue, the scan will catch all pending changes:
+    while (Pop() != NULL);
+    m_scanpos = MyMetrics.m_first;
+    m_scanning = true;
+    m_scancnt++;
+    }
+
+  if (m_scanning)
+    {
+    while ((m = m_scanpos) != NULL)
+      {
+      m_scanpos = m->m_next;
+      if (m->IsModifiedAndClear(m_modifier))
+        return m;
+      }
+    m_scanning = false;
+    }
+
+  // The bit may have been cleared by other means (i.e. ClearModified) after queueing:
+  while ((m = Pop()) != NULL)
+    {
+    if (m->IsModifiedAndClear(m_modifier))
+      return m;
+    }
+
+  return NULL;
   }
 
 void OvmsMetrics::SetAllUnitSend(size_t modifier)
@@ -1471,6 +2060,7 @@ OvmsMetric::OvmsMetric(const char* name, uint16_t autostale, metric_unit_t units
   m_stale = false;
   m_units = units;
   m_next = NULL;
+  m_listeners = NULL;
   m_persist = false;          // only set by metrics supporting persistence
   MyMetrics.RegisterMetric(this);
   }
@@ -1508,6 +2098,22 @@ std::string OvmsMetric::AsJSON(const char* defvalue, metric_unit_t units, int pr
   return buf;
   }
 
+void OvmsMetric::AppendJSON(std::string& buf, const char* defvalue, metric_unit_t units, int precision)
+  {
+  buf.append(AsJSON(defvalue, units, precision));
+  }
+
+size_t OvmsMetric::AppendString(char* buf, size_t size, const char* defvalue, metric_unit_t units, int precision)
+  {
+  if (size == 0)
+    return 0;
+  std::string value = AsString(defvalue, units, precision);
+  size_t len = std::min(value.size(), size-1);
+  memcpy(buf, value.data(), len);
+  buf[len] = 0;
+  return len;
+  }
+
 float OvmsMetric::AsFloat(const float defvalue, metric_unit_t units)
   {
   return defvalue;
@@ -1554,7 +2160,9 @@ void OvmsMetric::SetModified(bool changed)
   m_lastmodified = monotonictime;
   if (changed)
     {
-    m_modified = ULONG_MAX;
+    unsigned long newbits = ~m_modified.exchange(ULONG_MAX);
+    if (newbits)
+      MyMetrics.JournalModified(this, newbits);
     MyMetrics.NotifyModified(this);
     }
   }
@@ -1736,7 +2344,12 @@ bool OvmsMetricInt::CheckPersist()
 
 void OvmsMetricInt::RefreshPersist()
   {
-  if (m_persist && m_valuep && IsDefined())
+  // Re-register after a storage reset:
+  if (!m_persist)
+    return;
+  persistent_values *vp = pmetrics_register(m_name);
+  m_valuep = vp ? reinterpret_cast<int*>(&vp->value) : NULL;
+  if (m_valuep && IsDefined())
     *m_valuep = m_value;
   }
 
@@ -1750,6 +2363,11 @@ std::string OvmsMetricInt::AsString(const char* defvalue, metric_unit_t units, i
       units = m_units;
     else if (units != m_units)
       value = UnitConvert(m_units,units,m_value);
+    if (units != TimeUTC && units != TimeLocal && units != DateUTC && units != DateLocal)
+      {
+      char buf[24];
+      return std::string(buf, format_int(buf, sizeof(buf), value));
+      }
     std::stringstream os;
     switch (units)
       {
@@ -1781,7 +2399,6 @@ std::string OvmsMetricInt::AsString(const char* defvalue, metric_unit_t units, i
         }
         break;
       default:
-        os << value;
         break;
       }
     return os.str();
@@ -1821,6 +2438,53 @@ std::string OvmsMetricInt::AsJSON(const char* defvalue, metric_unit_t units, int
     return std::string((defvalue && *defvalue) ? defvalue : "0");
   }
 
+void OvmsMetricInt::AppendJSON(std::string& buf, const char* defvalue, metric_unit_t units, int precision)
+  {
+  if (!IsDefined())
+    {
+    buf.append((defvalue && *defvalue) ? defvalue : "0");
+    return;
+    }
+  CheckTargetUnit(GetUnits(), units, false);
+  if (units == Native)
+    units = m_units;
+  switch (units)
+    {
+    case TimeUTC:
+    case TimeLocal:
+    case DateUTC:
+    case DateLocal:
+      buf.append(AsJSON(defvalue, units, precision));
+      break;
+    default:
+      {
+      int value = (units != m_units) ? UnitConvert(m_units,units,m_value) : m_value;
+      char num[24];
+      buf.append(num, format_int(num, sizeof(num), value));
+      }
+      break;
+    }
+  }
+
+size_t OvmsMetricInt::AppendString(char* buf, size_t size, const char* defvalue, metric_unit_t units, int precision)
+  {
+  if (!IsDefined())
+    return OvmsMetric::AppendString(buf, size, defvalue, units, precision);
+  CheckTargetUnit(GetUnits(), units, false);
+  if (units == Native)
+    units = m_units;
+  switch (units)
+    {
+    case TimeUTC:
+    case TimeLocal:
+    case DateUTC:
+    case DateLocal:
+      return OvmsMetric::AppendString(buf, size, defvalue, units, precision);
+    default:
+      return format_int(buf, size, (units != m_units) ? UnitConvert(m_units,units,m_value) : m_value);
+    }
+  }
+
 float OvmsMetricInt::AsFloat(const float defvalue, metric_unit_t units)
   {
   return (float)AsInt((int)defvalue, units);
@@ -2033,7 +2697,12 @@ bool OvmsMetricBool::CheckPersist()
 
 void OvmsMetricBool::RefreshPersist()
   {
-  if (m_persist && m_valuep && IsDefined())
+  // Re-register after a storage reset:
+  if (!m_persist)
+    return;
+  persistent_values *vp = pmetrics_register(m_name);
+  m_valuep = vp ? reinterpret_cast<bool*>(&vp->value) : NULL;
+  if (m_valuep && IsDefined())
     *m_valuep = m_value;
   }
 
@@ -2052,6 +2721,14 @@ std::string OvmsMetricBool::AsString(const char* defvalue, metric_unit_t units,
     }
   }
 
+void OvmsMetricBool::AppendJSON(std::string& buf, const char* defvalue, metric_unit_t units, int precision)
+  {
+  if (IsDefined())
+    buf.append(m_value ? "true" : "false");
+  else
+    buf.append(strtobool(defvalue) ? "true" : "false");
+  }
+
 std::string OvmsMetricBool::AsJSON(const char* defvalue, metric_unit_t units, int precision)
   {
   if (IsDefined())
@@ -2192,7 +2869,12 @@ bool OvmsMetricFloat::CheckPersist()
 
 void OvmsMetricFloat::RefreshPersist()
   {
-  if (m_persist && m_valuep && IsDefined())
+  // Re-register after a storage reset:
+  if (!m_persist)
+    return;
+  persistent_values *vp = pmetrics_register(m_name);
+  m_valuep = vp ? reinterpret_cast<float*>(&vp->value) : NULL;
+  if (m_valuep && IsDefined())
     *m_valuep = m_value;
   }
 
@@ -2200,18 +2882,11 @@ std::string OvmsMetricFloat::AsString(const char* defvalue, metric_unit_t units,
   {
   if (IsDefined())
     {
-    std::ostringstream ss;
-    if (precision >= 0)
-      {
-      ss.precision(precision); // Set desired precision
-      ss << fixed;
-      }
+    char buf[32];
+    float value = m_value;
     if ((units != Other)&&(units != m_units))
-      ss << UnitConvert(m_units,units,m_value);
-    else
-      ss << m_value;
-    std::string s(ss.str());
-    return s;
+      value = UnitConvert(m_units,units,m_value);
+    return std::string(buf, format_float(buf, sizeof(buf), value, precision));
     }
   else
     {
@@ -2227,6 +2902,30 @@ std::string OvmsMetricFloat::AsJSON(const char* defvalue, metric_unit_t units, i
     return std::string((defvalue && *defvalue) ? defvalue : "0");
   }
 
+void OvmsMetricFloat::AppendJSON(std::string& buf, const char* defvalue, metric_unit_t units, int precision)
+  {
+  if (IsDefined())
+    {
+    char num[32];
+    float value = m_value;
+    if ((units != Other)&&(units != m_units))
+      value = UnitConvert(m_units,units,m_value);
+    buf.append(num, format_float(num, sizeof(num), value, precision));
+    }
+  else
+    buf.append((defvalue && *defvalue) ? defvalue : "0");
+  }
+
+size_t OvmsMetricFloat::AppendString(char* buf, size_t size, const char* defvalue, metric_unit_t units, int precision)
+  {
+  if (!IsDefined())
+    return OvmsMetric::AppendString(buf, size, defvalue, units, precision);
+  float value = m_value;
+  if ((units != Other)&&(units != m_units))
+    value = UnitConvert(m_units,units,m_value);
+  return format_float(buf, size, value, precision);
+  }
+
 float OvmsMetricFloat::AsFloat(const float defvalue, metric_unit_t units)
   {
   if (IsDefined())
@@ -2291,6 +2990,21 @@ void OvmsMetricFloat::Clear()
 OvmsMetricString::OvmsMetricString(const char* name, uint16_t autostale, metric_unit_t units, bool persist)
   : OvmsMetric(name, autostale, units, persist)
   {
+  m_valuep = NULL;
+  if (m_persist)
+    {
+    m_valuep = pmetrics_register(name, 0, PERSISTENT_TYPE_STRING);
+    if (!m_valuep)
+      {
+      m_persist = false;
+      }
+    else if (m_valuep->length > 0)
+      {
+      m_value.assign(reinterpret_cast<const char*>(&m_valuep->value), m_valuep->length);
+      SetModified(true);
+      ESP_LOGI(TAG, "persist %s = %s", name, m_value.c_str());
+      }
+    }
   }
 
 OvmsMetricString::~OvmsMetricString()
@@ -2327,6 +3041,8 @@ bool OvmsMetricString::SetValue(std::string value, metric_unit_t units)
       {
       m_value = value;
       modified = true;
+      if (m_valuep)
+        PersistValue();
       }
     m_mutex.Unlock();
     SetModified(modified);
@@ -2341,6 +3057,64 @@ void OvmsMetricString::Clear()
   OvmsMetric::Clear();
   }
 
+void OvmsMetricString::PersistValue()
+  {
+  // Called with m_mutex held. Strings grow in steps of 16 bytes to limit
+  // record reallocations:
+  size_t len = m_value.size();
+  if (len > m_valuep->capacity)
+    {
+    persistent_values *vp = pmetrics_resize(m_valuep, (len + 15) & ~15);
+    if (!vp)
+      {
+      ESP_LOGE(TAG, "%s persistence lost: can't allocate %u bytes", m_name, len);
+      m_valuep->length = 0;
+      m_valuep = NULL;
+      m_persist = false;
+      return;
+      }
+    m_valuep = vp;
+    }
+  memcpy(&m_valuep->value, m_value.data(), len);
+  m_valuep->length = len;
+  }
+
+bool OvmsMetricString::CheckPersist()
+  {
+  if (!m_persist || !m_valuep || !IsDefined())
+    return true;
+  OvmsMutexLock lock(&m_mutex);
+  if (m_valuep->length != m_value.size()
+    || memcmp(&m_valuep->value, m_value.data(), m_value.size()) != 0)
+    {
+    ESP_LOGE(TAG, "CheckPersist: bad value for %s", m_name);
+    return false;
+    }
+  persistent_values *vp = pmetrics_find(m_name);
+  if (!vp)
+    {
+    ESP_LOGE(TAG, "CheckPersist: can't find %s", m_name);
+    return false;
+    }
+  if (m_valuep != vp)
+    {
+    ESP_LOGE(TAG, "CheckPersist: bad address for %s", m_name);
+    return false;
+    }
+  return true;
+  }
+
+void OvmsMetricString::RefreshPersist()
+  {
+  // Re-register after a storage reset:
+  if (!m_persist)
+    return;
+  OvmsMutexLock lock(&m_mutex);
+  m_valuep = pmetrics_register(m_name, m_value.size(), PERSISTENT_TYPE_STRING);
+  if (m_valuep && IsDefined())
+    PersistValue();
+  }
+
 OvmsMetric64::OvmsMetric64(const char* name, uint16_t autostale, metric_unit_t units, bool persist)
   : OvmsMetric(name, autostale, units, persist)
   {
@@ -2348,23 +3122,19 @@ OvmsMetric64::OvmsMetric64(const char* name, uint16_t autostale, metric_unit_t u
   m_valuep_lo = nullptr;
   m_valuep_hi = nullptr;
   }
- void OvmsMetric64::InitPersist()
-   {
+void OvmsMetric64::InitPersist()
+  {
   if (m_persist)
     {
-    std::string lo_name(m_name);
-    std::string hi_name = lo_name + "_hi";
-
-    persistent_values *hi_vp = pmetrics_register(hi_name);
-    persistent_values *lo_vp = pmetrics_register(lo_name);
-    if (!hi_vp || !lo_vp)
+    persistent_values *vp = pmetrics_register(m_name, 2 * sizeof(persistent_value_t));
+    if (!vp)
       {
       m_persist = false;
       }
     else
       {
-      m_valuep_hi = (&hi_vp->value);
-      m_valuep_lo = (&lo_vp->value);
+      m_valuep_lo = (&vp->value);
+      m_valuep_hi = m_valuep_lo + 1;
       if (SetValueParts(*m_valuep_lo, *m_valuep_hi))
         {
         SetModified(true);
@@ -2385,29 +3155,15 @@ bool OvmsMetric64::CheckPersist()
     ESP_LOGE(TAG, "CheckPersist: bad value for %s", m_name);
     return false;
     }
-  std::string lo_name(m_name);
-  std::string hi_name = lo_name + "_hi";
-
-  persistent_values *hi_vp = pmetrics_find(hi_name);
-  if (!hi_vp)
-    {
-    ESP_LOGE(TAG, "CheckPersist: can't find %s", hi_name.c_str());
-    return false;
-    }
-  persistent_values *lo_vp = pmetrics_find(lo_name);
-  if ( !lo_vp)
-    {
-    ESP_LOGE(TAG, "CheckPersist: can't find %s", lo_name.c_str());
-    return false;
-    }
-  if (m_valuep_hi != &hi_vp->value)
+  persistent_values *vp = pmetrics_find(m_name);
+  if (!vp)
     {
-    ESP_LOGE(TAG, "CheckPersist: bad address for %s",hi_name.c_str());
+    ESP_LOGE(TAG, "CheckPersist: can't find %s", m_name);
     return false;
     }
-  if (m_valuep_lo != &lo_vp->value)
+  if (m_valuep_lo != &vp->value)
     {
-    ESP_LOGE(TAG, "CheckPersist: bad address for %s",lo_name.c_str());
+    ESP_LOGE(TAG, "CheckPersist: bad address for %s", m_name);
     return false;
     }
   return true;
@@ -2415,7 +3171,13 @@ bool OvmsMetric64::CheckPersist()
 
 void OvmsMetric64::RefreshPersist()
   {
-  if (m_persist && m_valuep_lo && m_valuep_hi && IsDefined())
+  // Re-register after a storage reset:
+  if (!m_persist)
+    return;
+  persistent_values *vp = pmetrics_register(m_name, 2 * sizeof(persistent_value_t));
+  m_valuep_lo = vp ? (&vp->value) : nullptr;
+  m_valuep_hi = vp ? m_valuep_lo + 1 : nullptr;
+  if (m_valuep_lo && IsDefined())
     {
     GetValueParts(*m_valuep_lo, *m_valuep_hi);
     }
@@ -2651,7 +3413,7 @@ bool OvmsMetricInt64::SetValue(std::string value, metric_unit_t units)
 
 bool OvmsMetricInt64::SetValue(dbcNumber& value)
   {
-  return SetValue(value.GetSignedInteger());
+  return SetValue(value.GetSignedInteger64());
   }
 
 void OvmsMetricInt64::Clear()
@@ -37,9 +37,11 @@
 #include <string>
 #include <bitset>
 #include <stdint.h>
+#include <stddef.h>
 #include <sstream>
 #include <set>
 #include <vector>
+#include <type_traits>
 #include <atomic>
 #include "ovms_mutex.h"
 #include "dbc_number.h"
@@ -198,26 +200,59 @@ metric_unit_t OvmsMetricCheckUnit(metric_unit_t fromUnit, metric_unit_t toUnit);
 
 typedef uint32_t persistent_value_t;
 
+#define PERSISTENT_INDEX_SIZE           64                    // hash buckets (power of two)
+
+// Persistent record types:
+#define PERSISTENT_TYPE_FREE            0                     // released, may be reused
+#define PERSISTENT_TYPE_SCALAR          1                     // fixed size value(s)
+#define PERSISTENT_TYPE_ARRAY           2                     // elements of elemsize bytes
+#define PERSISTENT_TYPE_STRING          3                     // characters, no terminator
+
+/**
+ * Persistent metrics live in a slab of variable length records in RTC memory.
+ * Each record consists of this header followed by the payload, which begins at
+ * 'value' and extends over 'capacity' bytes (a multiple of persistent_value_t).
+ * Growing a payload beyond its capacity (pmetrics_resize) extends the last
+ * record in place or moves the record, so holders need to take the returned
+ * pointer. Lookup is by name hash via the bucket index, with buckets chained
+ * through 'next' (slab offset + 1).
+ */
 struct persistent_values
   {
   std::size_t                 namehash;
-  persistent_value_t          value;
+  uint8_t                     type;                       // PERSISTENT_TYPE_*
+  uint8_t                     elemsize;                   // array element size, else 0
+  uint16_t                    next;                       // next record in bucket (offset + 1)
+  uint16_t                    capacity;                   // payload capacity in bytes
+  uint16_t                    length;                     // payload bytes in use
+  persistent_value_t          value;                      // payload start
   };
 
+#define PERSISTENT_HEADER_SIZE          offsetof(persistent_values, value)
+
 struct persistent_metrics
   {
   u_long                      magic;
   int                         version;
   unsigned int                serial;
   size_t                      size;
-  int                         used;
-  persistent_values           values[100];
+  int                         used;                       // number of records
+  size_t                      top;                        // slab bytes allocated
+  uint32_t                    checksum;                   // over index & record headers
+  uint16_t                    index[PERSISTENT_INDEX_SIZE];
+  uint8_t                     slab[CONFIG_OVMS_SYS_PERSIST_METRICS_SIZE] __attribute__ ((aligned (4)));
   };
 
 extern persistent_values *pmetrics_find(const char *name);
 extern persistent_values *pmetrics_find(const std::string &name);
-extern persistent_values *pmetrics_register(const char *name);
-extern persistent_values *pmetrics_register(const std::string &name);
+extern persistent_values *pmetrics_register(const char *name, size_t capacity = sizeof(persistent_value_t),
+  uint8_t type = PERSISTENT_TYPE_SCALAR, uint8_t elemsize = 0);
+extern persistent_values *pmetrics_register(const std::string &name, size_t capacity = sizeof(persistent_value_t),
+  uint8_t type = PERSISTENT_TYPE_SCALAR, uint8_t elemsize = 0);
+extern persistent_values *pmetrics_resize(persistent_values *vp, size_t capacity);
+
+class MetricCallbackEntry;
+typedef std::list<MetricCallbackEntry*> MetricCallbackList;
 
 class OvmsMetric
   {
@@ -229,6 +264,8 @@ class OvmsMetric
     virtual std::string AsString(const char* defvalue = "", metric_unit_t units = Other, int precision = -1);
     std::string AsUnitString(const char* defvalue = "", metric_unit_t units = Other, int precision = -1);
     virtual std::string AsJSON(const char* defvalue = "", metric_unit_t units = Other, int precision = -1);
+    virtual void AppendJSON(std::string& buf, const char* defvalue = "", metric_unit_t units = Other, int precision = -1);
+    virtual size_t AppendString(char* buf, size_t size, const char* defvalue = "", metric_unit_t units = Other, int precision = -1);
     virtual float AsFloat(const float defvalue = 0, metric_unit_t units = Other);
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
     virtual void DukPush(DukContext &dc, metric_unit_t units = Other);
@@ -264,6 +301,7 @@ class OvmsMetric
   public:
     OvmsMetric* m_next;
     const char* m_name;
+    MetricCallbackList* m_listeners;    // listeners registered by name, owned by OvmsMetrics
     std::atomic_ulong m_modified, m_sendunit;
     uint32_t m_lastmodified;
     uint16_t m_autostale;
@@ -282,6 +320,7 @@ class OvmsMetricBool : public OvmsMetric
   public:
     std::string AsString(const char* defvalue = "", metric_unit_t units = Other, int precision = -1) override;
     std::string AsJSON(const char* defvalue = "", metric_unit_t units = Other, int precision = -1) override;
+    void AppendJSON(std::string& buf, const char* defvalue = "", metric_unit_t units = Other, int precision = -1) override;
     float AsFloat(const float defvalue = 0, metric_unit_t units = Other) override;
     int AsBool(const bool defvalue = false);
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
@@ -310,6 +349,8 @@ class OvmsMetricInt : public OvmsMetric
   public:
     std::string AsString(const char* defvalue = "", metric_unit_t units = Other, int precision = -1) override;
     std::string AsJSON(const char* defvalue = "", metric_unit_t units = Other, int precision = -1) override;
+    void AppendJSON(std::string& buf, const char* defvalue = "", metric_unit_t units = Other, int precision = -1) override;
+    size_t AppendString(char* buf, size_t size, const char* defvalue = "", metric_unit_t units = Other, int precision = -1) override;
     float AsFloat(const float defvalue = 0, metric_unit_t units = Other) override;
     int AsInt(const int defvalue = 0, metric_unit_t units = Other);
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
@@ -338,6 +379,8 @@ class OvmsMetricFloat : public OvmsMetric
   public:
     std::string AsString(const char* defvalue = "", metric_unit_t units = Other, int precision = -1) override;
     std::string AsJSON(const char* defvalue = "", metric_unit_t units = Other, int precision = -1) override;
+    void AppendJSON(std::string& buf, const char* defvalue = "", metric_unit_t units = Other, int precision = -1) override;
+    size_t AppendString(char* buf, size_t size, const char* defvalue = "", metric_unit_t units = Other, int precision = -1) override;
     float AsFloat(const float defvalue = 0, metric_unit_t units = Other) override;
     int AsInt(const int defvalue = 0, metric_unit_t units = Other);
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
@@ -372,10 +415,16 @@ class OvmsMetricString : public OvmsMetric
     void operator=(std::string value) override { SetValue(value); }
     void Clear() override;
     bool IsString() override { return true; };
+    bool CheckPersist() override;
+    void RefreshPersist() override;
+
+  protected:
+    void PersistValue();
 
   protected:
     OvmsMutex m_mutex;
     std::string m_value;
+    persistent_values* m_valuep;
   };
 
 
@@ -618,10 +667,10 @@ class OvmsMetricSet : public OvmsMetric
  *
  * Note: use ExtRamAllocator<type> for large vectors (= use SPIRAM)
  *
- * Persistence can only be used on ElemTypes fitting into a pmetrics storage container.
- * A persistent vector will need 1+size pmetrics slots. It will allocate new slots as
- * needed when growing, but the slots will remain used when shrinking the vector. If any
- * new element cannot allocate a pmetrics slot, the whole vector loses its persistence.
+ * Persistence can only be used on plain data ElemTypes. A persistent vector is stored
+ * as a single pmetrics array record of size * sizeof(ElemType) bytes. The record is
+ * reallocated when growing beyond its capacity, and keeps its capacity when shrinking.
+ * If the record cannot grow, the vector loses its persistence.
  *
  * Unit conversion currently casts to and from float for the conversion, it's assumed to
  * only be necessary for floating point values here. If you need int conversion, rework
@@ -639,24 +688,30 @@ class OvmsMetricVector : public OvmsMetric
     OvmsMetricVector(const char* name, uint16_t autostale=0, metric_unit_t units = Other, bool persist = false)
       : OvmsMetric(name, autostale, units, persist)
       {
-      m_valuep_size = NULL;
+      m_valuep = NULL;
       if (!persist)
         return;
 
-      // Ensure ElemType fits into persistent value:
-      if (sizeof(ElemType) > sizeof(persistent_value_t))
+      // Ensure ElemType can be stored as raw data:
+      if (!std::is_pod<ElemType>::value || sizeof(ElemType) > UINT8_MAX)
+        {
+        m_persist = false;
         return;
+        }
 
-      // Vector persistence is currently implemented by a size entry with the metric name
-      //  + one additional entry per element using the metric name extended by the element index.
-      // This may be optimized when the persistence system supports arrays.
-      struct persistent_values *vp = pmetrics_register(m_name);
-      if (!vp)
+      m_valuep = pmetrics_register(m_name, 0, PERSISTENT_TYPE_ARRAY, sizeof(ElemType));
+      if (!m_valuep)
+        {
+        m_persist = false;
         return;
-      m_valuep_size = reinterpret_cast<std::size_t*>(&vp->value);
-      std::size_t psize = *m_valuep_size;
-      if (SetPersistSize(psize))
+        }
+      std::size_t psize = m_valuep->length / sizeof(ElemType);
+      if (psize > 0)
         {
+        const ElemType* pdata = PersistData();
+        m_value.resize(psize);
+        for (std::size_t i = 0; i < psize; i++)
+          m_value[i] = pdata[i];
         SetModified(true);
         ESP_LOGI(TAG, "persist %s = %s", m_name, AsUnitString().c_str());
         }
@@ -666,69 +721,49 @@ class OvmsMetricVector : public OvmsMetric
       }
 
   private:
-    bool SetPersistSize(std::size_t new_size)
+    ElemType* PersistData()
       {
-      // Used by the constructor for initial read and by later SetValue() calls
-      // on vector size changes:
-      //  m_persist false => register & read persistent values
-      //  m_persist true  => only register new elements
-      //
-      // Persistent element pointers will be retained on shrinking, and reused
-      // when the size grows again. Overall vector persistence is cancelled if any
-      // new element fails to register.
-
-      if (!m_valuep_size)
-        return false;
+      return reinterpret_cast<ElemType*>(&m_valuep->value);
+      }
 
-      std::size_t old_size = m_valuep_elem.size();
-      if (new_size <= old_size)
-        {
-        *m_valuep_size = new_size;
-        m_persist = true;
+    bool SetPersistSize(std::size_t new_size)
+      {
+      // Used by SetValue() calls on vector size changes, with m_mutex held.
+      // New elements are initialized from m_value as far as already resized.
+      if (!m_valuep)
         return false;
-        }
 
-      m_valuep_elem.resize(new_size);
-      if (!m_persist)
-        m_value.resize(new_size);
-
-      struct persistent_values *vp;
-      char elem_name[100];
-      for (std::size_t i = old_size; i < new_size; i++)
+      std::size_t old_size = m_valuep->length / sizeof(ElemType);
+      std::size_t bytes = new_size * sizeof(ElemType);
+      if (bytes > m_valuep->capacity)
         {
-        snprintf(elem_name, sizeof(elem_name), "%s_%u", m_name, i);
-        vp = pmetrics_register(elem_name);
+        persistent_values *vp = pmetrics_resize(m_valuep, bytes);
         if (!vp)
           {
-          // if any element fails to register, the whole vector persistence fails:
-          ESP_LOGE(TAG, "%s persistence lost: can't register slot for elem index %u", m_name, i);
-          *m_valuep_size = 0;
-          m_valuep_size = NULL;
-          m_valuep_elem.resize(0);
-          if (!m_persist)
-            m_value.resize(0);
+          ESP_LOGE(TAG, "%s persistence lost: can't allocate %u bytes for %u elements",
+            m_name, bytes, new_size);
+          m_valuep->length = 0;
+          m_valuep = NULL;
           m_persist = false;
           return false;
           }
-        else
-          {
-          m_valuep_elem[i] = reinterpret_cast<ElemType*>(&vp->value);
-          if (!m_persist)
-            m_value[i] = *m_valuep_elem[i];
-          }
+        m_valuep = vp;
         }
 
-      *m_valuep_size = new_size;
-      m_persist = true;
+      ElemType* pdata = PersistData();
+      for (std::size_t i = old_size; i < new_size; i++)
+        pdata[i] = (i < m_value.size()) ? m_value[i] : ElemType();
+      m_valuep->length = bytes;
       return true;
       }
 
   public:
     bool CheckPersist()
       {
-      if (!m_persist || !m_valuep_size || !IsDefined())
+      if (!m_persist || !m_valuep || !IsDefined())
         return true;
-      if (*m_valuep_size != m_value.size())
+      OvmsMutexLock lock(&m_mutex);
+      if (m_valuep->length != m_value.size() * sizeof(ElemType))
         {
         ESP_LOGE(TAG, "CheckPersist: bad value for %s[] size", m_name);
         return false;
@@ -736,48 +771,40 @@ class OvmsMetricVector : public OvmsMetric
       persistent_values *vp = pmetrics_find(m_name);
       if (vp == NULL)
         {
-        ESP_LOGE(TAG, "CheckPersist: can't find %s[] size", m_name);
+        ESP_LOGE(TAG, "CheckPersist: can't find %s[]", m_name);
         return false;
         }
-      if (m_valuep_size != reinterpret_cast<std::size_t*>(&vp->value))
+      if (m_valuep != vp)
         {
-        ESP_LOGE(TAG, "CheckPersist: bad address for %s[] size", m_name);
+        ESP_LOGE(TAG, "CheckPersist: bad address for %s[]", m_name);
         return false;
         }
+      const ElemType* pdata = PersistData();
       for (std::size_t i = 0; i < m_value.size(); i++)
         {
-        if (*m_valuep_elem[i] != m_value[i])
+        if (pdata[i] != m_value[i])
           {
           ESP_LOGE(TAG, "CheckPersist: bad value for %s[%d]", m_name, i);
           return false;
           }
         }
-      char elem_name[100];
-      for (std::size_t i = 0; i < m_value.size(); ++i)
-        {
-        snprintf(elem_name, sizeof(elem_name), "%s_%u", m_name, i);
-        vp = pmetrics_find(elem_name);
-        if (!vp)
-          {
-          ESP_LOGE(TAG, "CheckPersist: can't find %s[%d]", m_name, i);
-          return false;
-          }
-        if (m_valuep_elem[i] != reinterpret_cast<ElemType*>(&vp->value))
-          {
-          ESP_LOGE(TAG, "CheckPersist: bad address for %s[%d]", m_name, i);
-          return false;
-          }
-        }
       return true;
       }
 
     void RefreshPersist() override
       {
-      if (m_persist && m_valuep_size && IsDefined())
+      // Re-register after a storage reset:
+      if (!m_persist)
+        return;
+      OvmsMutexLock lock(&m_mutex);
+      m_valuep = pmetrics_register(m_name, m_value.size() * sizeof(ElemType),
+        PERSISTENT_TYPE_ARRAY, sizeof(ElemType));
+      if (m_valuep && IsDefined())
         {
-        *m_valuep_size = m_value.size();
-        for (int i = 0; i < m_value.size(); i++)
-          *m_valuep_elem[i] = m_value[i];
+        ElemType* pdata = PersistData();
+        for (std::size_t i = 0; i < m_value.size(); i++)
+          pdata[i] = m_value[i];
+        m_valuep->length = m_value.size() * sizeof(ElemType);
         }
       }
 
@@ -901,8 +928,8 @@ class OvmsMetricVector : public OvmsMetric
             {
             m_value[i] = ivalue;
             modified = true;
-            if (m_persist)
-              *m_valuep_elem[i] = ivalue;
+            if (m_valuep)
+              PersistData()[i] = ivalue;
             }
           }
         m_mutex.Unlock();
@@ -991,8 +1018,8 @@ class OvmsMetricVector : public OvmsMetric
           {
           m_value[n] = value;
           modified = true;
-          if (m_persist)
-            *m_valuep_elem[n] = value;
+          if (m_valuep)
+            PersistData()[n] = value;
           }
         m_mutex.Unlock();
         }
@@ -1022,8 +1049,8 @@ class OvmsMetricVector : public OvmsMetric
             {
             m_value[start+i] = ivalue;
             modified = true;
-            if (m_persist)
-              *m_valuep_elem[start+i] = ivalue;
+            if (m_valuep)
+              PersistData()[start+i] = ivalue;
             }
           }
         m_mutex.Unlock();
@@ -1039,8 +1066,7 @@ class OvmsMetricVector : public OvmsMetric
   protected:
     OvmsMutex m_mutex;
     std::vector<ElemType, Allocator> m_value;
-    std::size_t* m_valuep_size;
-    std::vector<ElemType*, AllocatorStar> m_valuep_elem;
+    persistent_values* m_valuep;
   };
 
 /* Base class for 64 bit persisted metrics.
@@ -1143,9 +1169,89 @@ class UnitConfigMap
     void InitialiseSlot(size_t modifier);
   };
 
-typedef std::list<MetricCallbackEntry*> MetricCallbackList;
 typedef std::map<std::string, MetricCallbackList*> MetricCallbackMap;
 
+/**
+ * OvmsMetricIndex: open addressing hash table (linear probing) on the metric names,
+ *  kept alongside the sorted m_first list so Find() doesn't need to scan the list.
+ *  Readers don't lock, so removed entries become tombstones, and tables replaced
+ *  on growth are retired instead of freed.
+ */
+struct OvmsMetricIndex
+  {
+  size_t                      size;       // number of slots, power of 2
+  size_t                      used;       // slots used by metrics or tombstones
+  OvmsMetric**                slot;
+  };
+
+/**
+ * OvmsMetricCursor: resumable position in the metrics list
+ *  Keeps a pointer to the next metric to visit, so iterating in steps (i.e. chunked
+ *  transmissions) continues in O(1). Insertions don't affect the cursor, metrics
+ *  inserted after the position will be visited. If any metric has been removed
+ *  meanwhile, the position is restored by the name of the next metric (the list
+ *  is sorted by name), so no metric is skipped or repeated.
+ */
+class OvmsMetricCursor
+  {
+  public:
+    OvmsMetricCursor();
+
+  public:
+    void Reset();
+    OvmsMetric* Resume();
+    OvmsMetric* Advance();
+
+  protected:
+    OvmsMetric*               m_pos;
+    std::string               m_posname;
+    uint32_t                  m_generation;
+    bool                      m_valid;
+  };
+
+/**
+ * OvmsMetricJournal: change journal for a metrics modifier
+ *  A metric pushes itself into the journal when its modifier bit goes from 0 to 1,
+ *  so consumers can drain the changed metrics instead of scanning the full list.
+ *  Push() may be called from any task concurrently (bounded lock free MPSC queue),
+ *  Next() must only be called by the single consumer owning the modifier.
+ *  On queue overflow or external bit changes the journal falls back to a full scan.
+ */
+class OvmsMetricJournal
+  {
+  public:
+    OvmsMetricJournal(size_t modifier, size_t size);
+    ~OvmsMetricJournal();
+
+  public:
+    bool Push(OvmsMetric* metric);
+    OvmsMetric* Next();
+    void Rescan();
+
+  protected:
+    OvmsMetric* Pop();
+
+  protected:
+    struct cell_t
+      {
+      std::atomic<size_t>     seq;
+      OvmsMetric*             metric;
+      };
+    size_t                    m_modifier;
+    size_t                    m_mask;
+    cell_t*                   m_cells;
+    std::atomic<size_t>       m_head;
+    size_t                    m_tail;
+    std::atomic<bool>         m_rescan;
+    OvmsMetric*               m_scanpos;
+    bool                      m_scanning;
+
+  public:
+    std::atomic<uint32_t>     m_pushcnt;
+    std::atomic<uint32_t>     m_overflowcnt;
+    uint32_t                  m_scancnt;
+  };
+
 class OvmsMetrics
   {
   public:
@@ -1211,11 +1317,20 @@ class OvmsMetrics
     void DeregisterListener(std::string caller);
     void NotifyModified(OvmsMetric* metric);
   protected:
-    MetricCallbackMap m_listeners;
+    void AttachListeners(const char* name, MetricCallbackList* ml);
+  protected:
+    MetricCallbackMap m_listeners;          // all listener lists by name (incl. "*")
+    MetricCallbackList* m_listeners_all;    // wildcard listeners
 
   public:
-    size_t RegisterModifier();
+    size_t RegisterModifier(bool journal = false);
     void InitialiseSlot(size_t modifier);
+    OvmsMetric* NextModified(size_t modifier);
+    void JournalModified(OvmsMetric* metric, unsigned long newbits);
+    OvmsMetricJournal* GetJournal(size_t modifier);
+  protected:
+    OvmsMetricJournal* m_journal[METRICS_MAX_MODIFIERS];
+    std::atomic_ulong m_journal_mask;
 
   public:
     void EventSystemShutDown(std::string event, void* data);
@@ -1223,6 +1338,20 @@ class OvmsMetrics
   protected:
     size_t m_nextmodifier;
 
+  protected:
+    void IndexInsert(OvmsMetric* metric);
+    void IndexRemove(OvmsMetric* metric);
+    void IndexRebuild();
+    OvmsMetricIndex* m_index;
+    std::list<OvmsMetricIndex*> m_index_retired;
+    size_t m_count;
+
+  public:
+    size_t GetCount() { return m_count; }
+    uint32_t GetGeneration() { return m_generation; }
+  protected:
+    uint32_t m_generation;             // incremented on metric removal
+
   public:
     OvmsMetric* m_first;
     bool m_trace;
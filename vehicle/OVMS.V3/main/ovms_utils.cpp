@@ -35,6 +35,7 @@
 #include <stdarg.h>
 #include <memory>
 #include <fstream>
+#include <cmath>
 #include "ovms_utils.h"
 #include "ovms_config.h"
 #include "ovms_events.h"
@@ -729,6 +730,157 @@ fail:
 }
 #endif
 
+/**
+ * format_int: allocation free integer formatting
+ */
+static char* format_uint_digits(char* p, uint64_t value)
+  {
+  char digits[20];
+  int n = 0;
+  do
+    {
+    digits[n++] = '0' + (value % 10);
+    value /= 10;
+    } while (value);
+  while (n)
+    *p++ = digits[--n];
+  return p;
+  }
+
+static std::size_t format_copy(char* buffer, std::size_t buf_size, const char* src, std::size_t len)
+  {
+  if (buf_size == 0)
+    return 0;
+  if (len >= buf_size)
+    len = buf_size - 1;
+  memcpy(buffer, src, len);
+  buffer[len] = 0;
+  return len;
+  }
+
+std::size_t format_int(char* buffer, std::size_t buf_size, int64_t value)
+  {
+  char tmp[24];
+  char* p = tmp;
+  uint64_t uvalue = value;
+  if (value < 0)
+    {
+    *p++ = '-';
+    uvalue = -uvalue;
+    }
+  p = format_uint_digits(p, uvalue);
+  return format_copy(buffer, buf_size, tmp, p - tmp);
+  }
+
+/**
+ * format_float: allocation free float formatting
+ *  Covers the usual metric value ranges in integer arithmetic. A float has a 24 bit
+ *  mantissa, so multiplying by 10^n (n <= 12) is exact in double precision, which
+ *  allows exact (round half to even) decimal rounding like printf.
+ *  Other values (and NaN/Inf) fall back to snprintf.
+ */
+static const uint64_t format_pow10[] =
+  {
+  1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+  100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull
+  };
+
+static inline uint64_t format_scale(double value, int decimals)
+  {
+  double scaled = value * (double)format_pow10[decimals];
+  uint64_t n = (uint64_t) scaled;
+  double frac = scaled - (double) n;
+  if (frac > 0.5 || (frac == 0.5 && (n & 1)))
+    n++;
+  return n;
+  }
+
+static inline char* format_fraction(char* p, uint64_t frac, int decimals, bool strip)
+  {
+  char* end = p + 1 + decimals;
+  *p = '.';
+  for (char* d = end - 1; d > p; d--)
+    {
+    *d = '0' + (frac % 10);
+    frac /= 10;
+    }
+  if (strip)
+    {
+    while (end[-1] == '0')
+      end--;
+    if (end[-1] == '.')
+      end--;
+    }
+  return end;
+  }
+
+std::size_t format_float(char* buffer, std::size_t buf_size, float value, int precision)
+  {
+  char tmp[40];
+  char* p = tmp;
+  double v = value;
+
+  if (std::isnan(v) || std::isinf(v) || precision > 12)
+    goto fallback;
+  if (std::signbit(v))
+    {
+    *p++ = '-';
+    v = -v;
+    }
+
+  if (precision >= 0)
+    {
+    // fixed notation:
+    if (v * (double)format_pow10[precision] >= 1e18)
+      goto fallback;
+    uint64_t n = format_scale(v, precision);
+    p = format_uint_digits(p, n / format_pow10[precision]);
+    if (precision > 0)
+      p = format_fraction(p, n % format_pow10[precision], precision, false);
+    }
+  else if (v == 0)
+    {
+    *p++ = '0';
+    }
+  else
+    {
+    // general notation with 6 significant digits (std::ostream default):
+    if (v < 1e-5 || v >= 1e6)
+      goto fallback;
+    int exp = 5;
+    while (exp > -5 && v < (double)format_pow10[exp+5] / 1e5)
+      exp--;
+    uint64_t n = format_scale(v, 5 - exp);
+    if (n >= 1000000)
+      {
+      // rounding carried into the next digit:
+      if (++exp > 5)
+        goto fallback;
+      n = format_scale(v, 5 - exp);
+      }
+    if (exp < -4)
+      goto fallback;
+    int decimals = 5 - exp;
+    p = format_uint_digits(p, n / format_pow10[decimals]);
+    if (decimals > 0)
+      p = format_fraction(p, n % format_pow10[decimals], decimals, true);
+    }
+
+  return format_copy(buffer, buf_size, tmp, p - tmp);
+
+fallback:
+  int len;
+  if (precision >= 0)
+    len = snprintf(buffer, buf_size, "%.*f", precision, (double)value);
+  else
+    len = snprintf(buffer, buf_size, "%g", (double)value);
+  if (len < 0)
+    len = 0;
+  else if (buf_size && (std::size_t)len >= buf_size)
+    len = buf_size - 1;
+  return len;
+  }
+
 /**
  * Format string with std::string result (sprintf for std::string).
  */
@@ -616,6 +616,15 @@ static inline std::string trim_copy(std::string s) {
  */
 void format_file_size(char* buffer, std::size_t buf_size, std::size_t fsize);
 
+/**
+ * format_int / format_float: allocation free number formatting
+ *  Output is identical to std::ostream << value, for floats with a precision >= 0
+ *  identical to fixed notation (printf "%.*f"). The result is always NUL terminated.
+ *  Returns the string length (excluding the NUL), truncated to buf_size-1.
+ */
+std::size_t format_int(char* buffer, std::size_t buf_size, int64_t value);
+std::size_t format_float(char* buffer, std::size_t buf_size, float value, int precision = -1);
+
 /** Format to a std::string.
  */
 std::string string_format(const char *fmt_str, ...) __attribute__ ((format (printf, 1, 2)));
@@ -44,6 +44,7 @@ static const char *TAG = "vfs";
 #include "ovms_vfs.h"
 #include "ovms_config.h"
 #include "ovms_command.h"
+#include "ovms_events.h"
 #include "ovms_peripherals.h"
 #include "crypt_md5.h"
 
@@ -305,7 +306,10 @@ void vfs_rm(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const
     }
 
   if (unlink(argv[0]) == 0)
-    { writer->puts("VFS File deleted"); }
+    {
+    writer->puts("VFS File deleted");
+    MyEvents.SignalEvent("system.vfs.file.changed", (void*)argv[0], strlen(argv[0])+1);
+    }
   else
     { writer->puts("Error: Could not delete VFS file"); }
   }
@@ -323,7 +327,11 @@ void vfs_mv(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const
     return;
     }
   if (rename(argv[0],argv[1]) == 0)
-    { writer->puts("VFS File renamed"); }
+    {
+    writer->puts("VFS File renamed");
+    MyEvents.SignalEvent("system.vfs.file.changed", (void*)argv[0], strlen(argv[0])+1);
+    MyEvents.SignalEvent("system.vfs.file.changed", (void*)argv[1], strlen(argv[1])+1);
+    }
   else
     { writer->puts("Error: Could not rename VFS file"); }
   }
@@ -355,7 +363,10 @@ void vfs_mkdir(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, co
   int res = (parents) ? mkpath(dirpath,0) : mkdir(dirpath,0);
 
   if (res == 0)
-    { writer->puts("VFS directory created"); }
+    {
+    writer->puts("VFS directory created");
+    MyEvents.SignalEvent("system.vfs.file.changed", (void*)dirpath, strlen(dirpath)+1);
+    }
   else
     { writer->puts("Error: Could not create VFS directory"); }
   }
@@ -387,7 +398,10 @@ void vfs_rmdir(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, co
   int res = (recursive) ? rmtree(dirpath) : rmdir(dirpath);
 
   if (res == 0)
-    { writer->puts("VFS directory removed"); }
+    {
+    writer->puts("VFS directory removed");
+    MyEvents.SignalEvent("system.vfs.file.changed", (void*)dirpath, strlen(dirpath)+1);
+    }
   else
     { writer->puts("Error: Could not remove VFS directory"); }
   }
@@ -428,6 +442,7 @@ void vfs_cp(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const
   fclose(w);
   fclose(f);
   writer->puts("VFS copy complete");
+  MyEvents.SignalEvent("system.vfs.file.changed", (void*)argv[1], strlen(argv[1])+1);
   }
 
 void vfs_append(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
@@ -34,10 +34,13 @@ static const char *TAG = "test";
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <sys/stat.h>
+#include <sstream>
 #include <esp_timer.h>
 #include "esp_system.h"
 #include "esp_event.h"
 #include "esp_sleep.h"
+#include "esp_heap_caps.h"
 #include "test_framework.h"
 #include "ovms_command.h"
 #include "ovms_peripherals.h"
@@ -45,6 +48,15 @@ static const char *TAG = "test";
 #include "metrics_standard.h"
 #include "ovms_config.h"
 #include "can.h"
+#include "dbc.h"
+#include "dbc_app.h"
+#include "canplay_vfs.h"
+#ifdef CONFIG_OVMS_COMP_RE_TOOLS
+#include "retools.h"
+#endif // #ifdef CONFIG_OVMS_COMP_RE_TOOLS
+#include "ovms_events.h"
+#include "ovms_malloc.h"
+#include "ovms_utils.h"
 #if ESP_IDF_VERSION_MAJOR < 4
 #include "strverscmp.h"
 #endif
@@ -380,6 +392,788 @@ void test_string(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc,
     (int)((esp_timer_get_time() - time_start_us) / 1000));
   }
 
+void test_metricfind(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  int loopcnt = (argc > 0) ? atoi(argv[0]) : 10;
+  size_t count = MyMetrics.GetCount();
+  if (loopcnt <= 0 || count == 0)
+    return;
+
+  // Copy the names, so lookups don't profit from pointer equality:
+  std::vector<std::string> names;
+  names.reserve(count);
+  for (OvmsMetric* m = MyMetrics.m_first; m != NULL; m = m->m_next)
+    names.push_back(m->m_name);
+
+  int errcnt = 0;
+  int64_t time_start_us = esp_timer_get_time();
+  for (int j = 0; j < loopcnt; j++)
+    {
+    for (auto& name : names)
+      {
+      OvmsMetric* m;
+      for (m = MyMetrics.m_first; m != NULL && strcmp(m->m_name, name.c_str()) != 0; m = m->m_next);
+      if (!m) errcnt++;
+      }
+    }
+  int64_t time_linear_us = esp_timer_get_time() - time_start_us;
+
+  time_start_us = esp_timer_get_time();
+  for (int j = 0; j < loopcnt; j++)
+    {
+    for (auto& name : names)
+      {
+      if (!MyMetrics.Find(name.c_str())) errcnt++;
+      }
+    }
+  int64_t time_hashed_us = esp_timer_get_time() - time_start_us;
+
+  uint64_t lookups = (uint64_t) loopcnt * names.size();
+  writer->printf("%u metrics, %llu lookups per method, %d errors\n", names.size(), lookups, errcnt);
+  writer->printf("list scan : %lld ms = %llu lookups/s\n",
+    time_linear_us / 1000, (lookups * 1000000) / (time_linear_us ? time_linear_us : 1));
+  writer->printf("hash index: %lld ms = %llu lookups/s\n",
+    time_hashed_us / 1000, (lookups * 1000000) / (time_hashed_us ? time_hashed_us : 1));
+  }
+
+// Simulate chunked full metrics dumps to concurrent websocket clients,
+// resuming each chunk by list index (legacy) vs. by cursor:
+static int64_t test_metricdump_run(int clients, bool use_cursor)
+  {
+  const size_t chunksize = 1024;
+  std::vector<int> index(clients, 0);
+  std::vector<OvmsMetricCursor> cursor(clients);
+  std::vector<bool> done(clients, false);
+  std::string msg;
+  msg.reserve(2*chunksize+128);
+  int pending = clients;
+
+  int64_t time_start_us = esp_timer_get_time();
+  while (pending > 0)
+    {
+    // serve clients round robin, one chunk each:
+    for (int c = 0; c < clients; c++)
+      {
+      if (done[c]) continue;
+      OvmsMetric* m;
+      int i;
+      if (use_cursor)
+        m = cursor[c].Resume();
+      else
+        for (i=0, m=MyMetrics.m_first; i < index[c] && m != NULL; m=m->m_next, i++);
+      msg = "{\"metrics\":{";
+      while (m && msg.size() < chunksize)
+        {
+        msg += '\"';
+        msg += m->m_name;
+        msg += "\":";
+        msg += m->AsJSON();
+        msg += ',';
+        if (use_cursor)
+          m = cursor[c].Advance();
+        else
+          {
+          m = m->m_next;
+          index[c]++;
+          }
+        }
+      if (!m)
+        {
+        done[c] = true;
+        pending--;
+        }
+      }
+    }
+  return esp_timer_get_time() - time_start_us;
+  }
+
+void test_metricdump(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  static const int clientcnt[] = { 1, 4, 8 };
+  writer->printf("Full dump of %u metrics in 1024 byte chunks:\n", MyMetrics.GetCount());
+  writer->puts("clients  index resume  cursor resume");
+  for (int clients : clientcnt)
+    {
+    int64_t time_index_us = test_metricdump_run(clients, false);
+    int64_t time_cursor_us = test_metricdump_run(clients, true);
+    writer->printf("%7d  %9lld ms  %10lld ms\n", clients, time_index_us / 1000, time_cursor_us / 1000);
+    }
+  }
+
+void test_metricformat(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  static const float values[] = { 0, 12.5, -3.75, 0.001234, 98.6, 1234.56789, 99999.95, 401.2 };
+  static const int precisions[] = { -1, 2 };
+  int loopcnt = (argc > 0) ? atoi(argv[0]) : 10000;
+  if (loopcnt <= 0)
+    return;
+
+  uint64_t conversions = (uint64_t) loopcnt * (sizeof(values)/sizeof(values[0]));
+  writer->printf("%llu float conversions per method:\n", conversions);
+  writer->puts("precision  ostringstream  format_float");
+  for (int precision : precisions)
+    {
+    size_t len = 0;
+    int64_t time_start_us = esp_timer_get_time();
+    for (int j = 0; j < loopcnt; j++)
+      {
+      for (float value : values)
+        {
+        std::ostringstream ss;
+        if (precision >= 0)
+          {
+          ss.precision(precision);
+          ss << std::fixed;
+          }
+        ss << value;
+        len += ss.str().size();
+        }
+      }
+    int64_t time_stream_us = esp_timer_get_time() - time_start_us;
+
+    char buf[32];
+    time_start_us = esp_timer_get_time();
+    for (int j = 0; j < loopcnt; j++)
+      {
+      for (float value : values)
+        len -= format_float(buf, sizeof(buf), value, precision);
+      }
+    int64_t time_format_us = esp_timer_get_time() - time_start_us;
+
+    writer->printf("%9d  %10lld ms  %9lld ms%s\n", precision,
+      time_stream_us / 1000, time_format_us / 1000, len ? "  (MISMATCH)" : "");
+    }
+  }
+
+static volatile int test_events_received;
+
+static void test_events_listener(std::string event, void* data)
+  {
+  test_events_received++;
+  }
+
+// Signal <count> events and wait for their delivery, returns the time in us:
+static int64_t test_events_run(int count, event_id_t id, const std::string& name)
+  {
+  test_events_received = 0;
+  int64_t time_start_us = esp_timer_get_time();
+  for (int i = 0; i < count; i++)
+    {
+    // leave room for system events:
+    while (uxQueueSpacesAvailable(MyEvents.m_taskqueue) < CONFIG_OVMS_HW_EVENT_QUEUE_SIZE/2)
+      taskYIELD();
+    if (id != EVENT_ID_NONE)
+      MyEvents.SignalEvent(id, NULL);
+    else
+      MyEvents.SignalEvent(name, NULL);
+    }
+  while (test_events_received < count)
+    taskYIELD();
+  return esp_timer_get_time() - time_start_us;
+  }
+
+void test_events(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  int count = (argc > 0) ? atoi(argv[0]) : 1000;
+  if (count <= 0)
+    return;
+
+  std::string name = "test.events.benchmark";
+  MyEvents.RegisterEvent(TAG, name, test_events_listener);
+  event_id_t id = MyEvents.Intern(name);
+
+  // Per signal overhead of the former name based queueing & dispatch
+  // (name copy, map lookups for the name and "*", prefix checks):
+  int errcnt = 0;
+  int64_t time_start_us = esp_timer_get_time();
+  for (int i = 0; i < count; i++)
+    {
+    char* event = (char*)ExternalRamMalloc(name.size()+1);
+    strcpy(event, name.c_str());
+    std::string current = event;
+    if (startsWith(current, "ticker.") || startsWith(current, "clock.")) errcnt++;
+    if (MyEvents.Map().find(current) == MyEvents.Map().end()) errcnt++;
+    MyEvents.Map().find("*");
+    free(event);
+    }
+  int64_t time_legacy_us = esp_timer_get_time() - time_start_us;
+
+  // Per signal overhead of the name to ID lookup:
+  time_start_us = esp_timer_get_time();
+  for (int i = 0; i < count; i++)
+    {
+    if (MyEvents.Lookup(name) != id) errcnt++;
+    }
+  int64_t time_intern_us = esp_timer_get_time() - time_start_us;
+
+  // End to end throughput:
+  int64_t time_byname_us = test_events_run(count, EVENT_ID_NONE, name);
+  int64_t time_byid_us = test_events_run(count, id, name);
+
+  MyEvents.DeregisterEvent(TAG);
+
+  writer->printf("%d events per method, %d errors:\n", count, errcnt);
+  writer->printf("name copy + lookups : %7.2f us/event\n", (float)time_legacy_us / count);
+  writer->printf("name intern lookup  : %7.2f us/event\n", (float)time_intern_us / count);
+  writer->printf("signal by name      : %7.2f us/event = %lld events/s\n",
+    (float)time_byname_us / count, ((int64_t)count * 1000000) / (time_byname_us ? time_byname_us : 1));
+  writer->printf("signal by id        : %7.2f us/event = %lld events/s\n",
+    (float)time_byid_us / count, ((int64_t)count * 1000000) / (time_byid_us ? time_byid_us : 1));
+  }
+
+void test_configbatch(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  int count = (argc > 0) ? atoi(argv[0]) : 50;
+  if (count <= 0)
+    return;
+  if (!MyConfig.ismounted())
+    {
+    writer->puts("Error: config store not mounted");
+    return;
+    }
+
+  const char* param = "test.configbatch";
+  char instance[16], value[16];
+  MyConfig.RegisterParam(param, "Test: config batch", true, true);
+
+  // single changes, paced to let the event task process the config.changed
+  // events (the event queue must not overflow):
+  uint32_t writes_start = MyConfig.GetWriteCount();
+  int64_t time_start_us = esp_timer_get_time();
+  for (int i = 0; i < count; i++)
+    {
+    while (uxQueueSpacesAvailable(MyEvents.m_taskqueue) < CONFIG_OVMS_HW_EVENT_QUEUE_SIZE/2)
+      vTaskDelay(pdMS_TO_TICKS(10));
+    snprintf(instance, sizeof(instance), "key%d", i);
+    snprintf(value, sizeof(value), "single%d", i);
+    MyConfig.SetParamValue(param, instance, value);
+    }
+  int64_t time_single_us = esp_timer_get_time() - time_start_us;
+  uint32_t writes_single = MyConfig.GetWriteCount() - writes_start;
+
+  // transaction:
+  writes_start = MyConfig.GetWriteCount();
+  time_start_us = esp_timer_get_time();
+    {
+    OvmsConfigTransaction transaction;
+    for (int i = 0; i < count; i++)
+      {
+      snprintf(instance, sizeof(instance), "key%d", i);
+      snprintf(value, sizeof(value), "batch%d", i);
+      MyConfig.SetParamValue(param, instance, value);
+      }
+    }
+  int64_t time_batch_us = esp_timer_get_time() - time_start_us;
+  uint32_t writes_batch = MyConfig.GetWriteCount() - writes_start;
+
+  // cleanup: the param stays registered, as queued config.changed events
+  // refer to it; removing the instances in one transaction signals once:
+    {
+    OvmsConfigTransaction transaction;
+    for (int i = 0; i < count; i++)
+      {
+      snprintf(instance, sizeof(instance), "key%d", i);
+      MyConfig.DeleteInstance(param, instance);
+      }
+    }
+
+  writer->printf("%d config changes:\n", count);
+  writer->printf("single     : %3" PRIu32 " file writes, %6lld ms\n", writes_single, time_single_us / 1000);
+  writer->printf("transaction: %3" PRIu32 " file writes, %6lld ms\n", writes_batch, time_batch_us / 1000);
+  }
+
+// Per frame cost of a canfilter with 50 ID ranges on two buses,
+// compared to a linear scan of the same ranges:
+void test_canfilter(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  int frames = (argc > 0) ? atoi(argv[0]) : 100000;
+  if (frames <= 0)
+    return;
+
+  canfilter filter;
+  std::vector<CAN_filter_t> ranges;
+  for (int i = 0; i < 50; i++)
+    {
+    CAN_filter_t f;
+    f.bus = '1' + (i & 1);
+    if (i < 40)
+      {
+      f.id_from = 0x100 + i * 0x18;
+      f.id_to = f.id_from + (i % 4);
+      }
+    else
+      {
+      f.id_from = 0x18daf100 + (i - 40) * 0x100;
+      f.id_to = f.id_from + 0xff;
+      }
+    filter.AddFilter(f.bus, f.id_from, f.id_to);
+    ranges.push_back(f);
+    }
+
+  canbus* buses[2] = { MyCan.GetBus(0), MyCan.GetBus(1) };
+  if (!buses[0] || !buses[1])
+    {
+    writer->puts("Error: can1 and can2 required");
+    return;
+    }
+  CAN_frame_t frame = {};
+  uint32_t matched = 0, matched_scan = 0;
+
+  int64_t time_start_us = esp_timer_get_time();
+  for (int i = 0; i < frames; i++)
+    {
+    frame.origin = buses[i & 1];
+    frame.MsgID = (i & 2) ? (0x18daf100 + (i * 7 & 0xfff)) : (i * 13 & 0x7ff);
+    if (filter.IsFiltered(&frame)) matched++;
+    }
+  int64_t time_compiled_us = esp_timer_get_time() - time_start_us;
+
+  time_start_us = esp_timer_get_time();
+  for (int i = 0; i < frames; i++)
+    {
+    frame.origin = buses[i & 1];
+    frame.MsgID = (i & 2) ? (0x18daf100 + (i * 7 & 0xfff)) : (i * 13 & 0x7ff);
+    char buskey = frame.origin->m_busnumber + '1';
+    for (const CAN_filter_t& f : ranges)
+      {
+      if ((f.bus)&&(f.bus != buskey)) continue;
+      if ((frame.MsgID >= f.id_from) && (frame.MsgID <= f.id_to))
+        {
+        matched_scan++;
+        break;
+        }
+      }
+    }
+  int64_t time_scan_us = esp_timer_get_time() - time_start_us;
+
+  writer->printf("%d frames, 50 ranges, %" PRIu32 "/%" PRIu32 " matched:\n", frames, matched, matched_scan);
+  writer->printf("Compiled filter: %6lld ms = %7.3f us/frame\n",
+    time_compiled_us / 1000, (float)time_compiled_us / frames);
+  writer->printf("Linear scan    : %6lld ms = %7.3f us/frame\n",
+    time_scan_us / 1000, (float)time_scan_us / frames);
+  }
+
+// CAN frame distribution to multiple consumer tasks at 10k frames/s,
+// shared frame ring vs. one queue per consumer (the former listener model):
+typedef struct
+  {
+  canring_reader* reader;
+  QueueHandle_t queue;
+  volatile bool stop;
+  volatile bool done;
+  uint32_t received;
+  } test_canring_consumer_t;
+
+static void test_canring_task(void *pvParameters)
+  {
+  test_canring_consumer_t* c = (test_canring_consumer_t*) pvParameters;
+  CAN_frame_t frame;
+  for (;;)
+    {
+    bool ok = (c->reader)
+      ? c->reader->Read(&frame, pdMS_TO_TICKS(20))
+      : (xQueueReceive(c->queue, &frame, pdMS_TO_TICKS(20)) == pdTRUE);
+    if (ok)
+      c->received++;
+    else if (c->stop)
+      break;
+    }
+  c->done = true;
+  vTaskDelete(NULL);
+  }
+
+void test_canring(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  int frames = (argc > 0) ? atoi(argv[0]) : 10000;
+  int consumers = (argc > 1) ? atoi(argv[1]) : 5;
+  if (frames <= 0 || consumers <= 0 || consumers > 10)
+    return;
+
+  canbus* bus = MyCan.GetBus(0);
+  if (!bus)
+    {
+    writer->puts("Error: can1 required");
+    return;
+    }
+
+  CAN_frame_t frame = {};
+  frame.origin = bus;
+  frame.FIR.B.DLC = 8;
+  test_canring_consumer_t c[10];
+  canring ring;
+
+  for (int mode = 0; mode < 2; mode++)
+    {
+    for (int k = 0; k < consumers; k++)
+      {
+      memset(&c[k], 0, sizeof(c[k]));
+      if (mode == 0)
+        c[k].reader = ring.AddReader("test", CAN_RING_RX);
+      else
+        c[k].queue = xQueueCreate(CAN_RING_SIZE, sizeof(CAN_frame_t));
+      xTaskCreatePinnedToCore(test_canring_task, "OVMS TestRing", 3072, &c[k], 5, NULL, CORE(1));
+      }
+
+    // Produce in bursts of 10 frames per 1 ms tick:
+    uint32_t overflows = 0;
+    int64_t time_us = 0;
+    for (int i = 0; i < frames; i++)
+      {
+      frame.MsgID = 0x100 + (i & 0xff);
+      frame.data.u8[0] = i & 0xff;
+      int64_t time_start_us = esp_timer_get_time();
+      if (mode == 0)
+        {
+        ring.Write(bus, CAN_LogFrame_RX, &frame);
+        }
+      else
+        {
+        for (int k = 0; k < consumers; k++)
+          {
+          if (xQueueSend(c[k].queue, &frame, 0) != pdTRUE)
+            overflows++;
+          }
+        }
+      time_us += esp_timer_get_time() - time_start_us;
+      if ((i % 10) == 9)
+        vTaskDelay(pdMS_TO_TICKS(1));
+      }
+
+    uint32_t received = 0;
+    for (int k = 0; k < consumers; k++)
+      {
+      c[k].stop = true;
+      while (!c[k].done)
+        vTaskDelay(pdMS_TO_TICKS(10));
+      received += c[k].received;
+      if (mode == 0)
+        {
+        overflows += c[k].reader->m_overflows;
+        ring.RemoveReader(c[k].reader);
+        }
+      else
+        {
+        vQueueDelete(c[k].queue);
+        }
+      }
+
+    writer->printf("%s: %6lld ms = %7.3f us/frame producer time, %" PRIu32 " received, %" PRIu32 " lost\n",
+      (mode == 0) ? "Frame ring " : "Queue fanout",
+      time_us / 1000, (float)time_us / frames, received, overflows);
+    }
+  }
+
+// DBC frame decoding throughput of all signals of a loaded DBC file,
+// precompiled decode plan vs. message table lookup & dbcSignal::Decode():
+void test_dbcdecode(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  int frames = (argc > 1) ? atoi(argv[1]) : 10000;
+  if (frames <= 0)
+    return;
+  dbcfile* dbc = MyDBC.Find(argv[0]);
+  if (!dbc)
+    {
+    writer->printf("Error: DBC file %s not loaded\n", argv[0]);
+    return;
+    }
+
+  std::vector<uint32_t> ids;
+  for (auto& it : dbc->m_messages.m_entrymap)
+    ids.push_back(it.first);
+  if (ids.empty())
+    {
+    writer->puts("Error: DBC file has no messages");
+    return;
+    }
+
+  dbcDecodePlan plan;
+  plan.Compile(&dbc->m_messages, true);
+
+  CAN_frame_t frame = {};
+  frame.FIR.B.DLC = 8;
+  uint32_t signals_plan = 0, signals_table = 0;
+  dbcNumber r;
+
+  int64_t time_start_us = esp_timer_get_time();
+  for (int i = 0; i < frames; i++)
+    {
+    uint32_t id = ids[i % ids.size()];
+    frame.FIR.B.FF = (id & 0x80000000) ? CAN_frame_ext : CAN_frame_std;
+    frame.MsgID = id & 0x7FFFFFFF;
+    frame.data.u32[0] = i * 2654435761U;
+    frame.data.u32[1] = ~frame.data.u32[0];
+    int n = plan.Decode(&frame);
+    if (n > 0) signals_plan += n;
+    }
+  int64_t time_plan_us = esp_timer_get_time() - time_start_us;
+
+  time_start_us = esp_timer_get_time();
+  for (int i = 0; i < frames; i++)
+    {
+    uint32_t id = ids[i % ids.size()];
+    frame.FIR.B.FF = (id & 0x80000000) ? CAN_frame_ext : CAN_frame_std;
+    frame.MsgID = id & 0x7FFFFFFF;
+    frame.data.u32[0] = i * 2654435761U;
+    frame.data.u32[1] = ~frame.data.u32[0];
+    dbcMessage* msg = dbc->m_messages.FindMessage(frame.FIR.B.FF, frame.MsgID);
+    if (!msg) continue;
+    dbcSignal* mux = msg->GetMultiplexorSignal();
+    uint32_t muxval = 0;
+    if (mux)
+      muxval = mux->Decode(&frame).GetSignedInteger();
+    for (dbcSignal* sig : msg->m_signals)
+      {
+      if (mux && sig != mux && sig->IsMultiplexSwitch() && sig->GetMultiplexSwitchvalue() != muxval)
+        continue;
+      r = sig->Decode(&frame);
+      signals_table++;
+      }
+    }
+  int64_t time_table_us = esp_timer_get_time() - time_start_us;
+
+  writer->printf("%d frames, %u messages, %d signals, %" PRIu32 "/%" PRIu32 " decoded:\n",
+    frames, ids.size(), plan.GetSignalCount(), signals_plan, signals_table);
+  writer->printf("Decode plan  : %6lld ms = %7.3f us/frame\n",
+    time_plan_us / 1000, (float)time_plan_us / frames);
+  writer->printf("Message table: %6lld ms = %7.3f us/frame\n",
+    time_table_us / 1000, (float)time_table_us / frames);
+  }
+
+// DBC file load time and retained heap, parsing vs. binary cache:
+void test_dbcload(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  struct stat st;
+  if (stat(argv[0], &st) != 0)
+    {
+    writer->printf("Error: cannot access %s\n", argv[0]);
+    return;
+    }
+
+  // Create/update the cache:
+    {
+    dbcfile dbc;
+    if (!dbc.LoadFile("test", argv[0]))
+      {
+      writer->printf("Error: failed to load %s\n", argv[0]);
+      return;
+      }
+    }
+
+  writer->printf("%s: %ld bytes\n", argv[0], (long)st.st_size);
+  for (int mode = 0; mode < 2; mode++)
+    {
+    size_t heap_start = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    int64_t time_start_us = esp_timer_get_time();
+    dbcfile* dbc = new dbcfile();
+    bool ok = dbc->LoadFile("test", argv[0], NULL, (mode == 1));
+    int64_t time_us = esp_timer_get_time() - time_start_us;
+    size_t heap_used = heap_start - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    writer->printf("%s: %6lld ms, %u bytes heap%s\n",
+      (mode == 0) ? "Parser" : "Cache ",
+      time_us / 1000, heap_used, ok ? "" : " (failed)");
+    delete dbc;
+    }
+  }
+
+#ifdef CONFIG_OVMS_COMP_RE_TOOLS
+// Former string record key of re::GetKey() (before integer keys):
+static std::string test_retools_strkey(re* r, CAN_frame_t* frame)
+  {
+  std::string key;
+  if (frame->origin != NULL)
+    key = std::string(frame->origin->GetName());
+  else
+    key = std::string("can?");
+  key.append("/");
+
+  char id[9];
+  if (frame->FIR.B.FF == CAN_frame_std)
+    sprintf(id,"%03" PRIx32,frame->MsgID);
+  else
+    sprintf(id,"%08" PRIx32,frame->MsgID);
+  key.append(id);
+
+  if (((r->m_obdii_std_min>0) &&
+       (frame->FIR.B.FF == CAN_frame_std) &&
+       (frame->MsgID >= r->m_obdii_std_min) &&
+       (frame->MsgID <= r->m_obdii_std_max))
+      ||
+       ((r->m_obdii_ext_min>0) &&
+       (frame->FIR.B.FF == CAN_frame_ext) &&
+       (frame->MsgID >= r->m_obdii_ext_min) &&
+       (frame->MsgID <= r->m_obdii_ext_max)))
+    {
+    if (frame->data.u8[0] > 8)
+      return key;
+    uint8_t mode = frame->data.u8[1];
+    char req[16];
+    if (mode > 0x4a)
+      sprintf(req,":O2Pm%d:%d",mode-0x40,((int)frame->data.u8[2]<<8)+frame->data.u8[3]);
+    else if (mode > 0x40)
+      sprintf(req,":O2Pm%d:%d",mode-0x40,(int)frame->data.u8[2]);
+    else if (mode > 0x0a)
+      sprintf(req,":O2Qm%d:%d",mode,((int)frame->data.u8[2]<<8)+frame->data.u8[3]);
+    else
+      sprintf(req,":O2Qm%d:%d",mode,(int)frame->data.u8[2]);
+    key.append(req);
+    return key;
+    }
+
+  if (frame->origin != NULL)
+    {
+    dbcfile* dbc = frame->origin->GetDBC();
+    if (dbc != NULL)
+      {
+      dbcMessage* m = dbc->m_messages.FindMessage(frame->FIR.B.FF, frame->MsgID);
+      if ((m != NULL)&&(m->IsMultiplexor()))
+        {
+        dbcNumber muxn = m->GetMultiplexorSignal()->Decode(frame);
+        char b[8];
+        sprintf(b,":%04" PRIx32,muxn.GetUnsignedInteger());
+        key.append(b);
+        }
+      }
+    }
+
+  return key;
+  }
+
+// retools frame analysis rate on a recorded CAN log, replayed from memory
+// through a non-live re instance (no task & ring reader, so live traffic
+// and MyRE don't interfere), vs. the former string keyed record map:
+void test_retools(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  int maxframes = (argc > 2) ? atoi(argv[2]) : 20000;
+  if (maxframes <= 0)
+    return;
+
+  // Load the log:
+  canplay_vfs* player = new canplay_vfs(argv[1], argv[0]);
+  if (!player->Open())
+    {
+    writer->printf("Error: Could not open %s log %s\n", argv[0], argv[1]);
+    delete player;
+    return;
+    }
+  std::vector<CAN_frame_t, ExtRamAllocator<CAN_frame_t>> frames;
+  frames.reserve(maxframes);
+  CAN_log_message_t msg;
+  while ((int)frames.size() < maxframes && player->InputMsg(&msg))
+    {
+    if (msg.type == CAN_LogFrame_RX || msg.type == CAN_LogFrame_TX)
+      frames.push_back(msg.frame);
+    }
+  delete player;
+  if (frames.empty())
+    {
+    writer->puts("Error: no frames found in log");
+    return;
+    }
+  int count = frames.size();
+
+  re* bench = new re("re-bench", NULL, false);
+  bench->m_obdii_std_min = 0x7e8;
+  bench->m_obdii_std_max = 0x7ef;
+
+  // Integer keys & hash table:
+  int64_t time_start_us = esp_timer_get_time();
+  for (CAN_frame_t& frame : frames)
+    bench->DoAnalyse(&frame);
+  int64_t time_int_us = esp_timer_get_time() - time_start_us;
+  uint32_t keys = bench->m_rmap.size();
+
+  // String keys & map, as analysed by the former re::DoAnalyse():
+  std::map<std::string, re_record_t*> smap;
+  time_start_us = esp_timer_get_time();
+  for (CAN_frame_t& frame : frames)
+    {
+    OvmsRecMutexLock lock(&bench->m_mutex);
+    std::string key = test_retools_strkey(bench, &frame);
+    auto k = smap.find(key);
+    re_record_t* r;
+    if (k == smap.end())
+      {
+      r = new re_record_t;
+      memset(r,0,sizeof(re_record_t));
+      r->attr.b.Changed = 1;
+      r->attr.dc = 0xff;
+      smap[key] = r;
+      }
+    else
+      {
+      r = k->second;
+      for (int j=0;j<r->last.FIR.B.DLC;j++)
+        {
+        if (r->last.data.u8[j] != frame.data.u8[j])
+          r->attr.dc |= (1<<j);
+        }
+      }
+    memcpy(&r->last,&frame,sizeof(CAN_frame_t));
+    r->rxcount++;
+    }
+  int64_t time_str_us = esp_timer_get_time() - time_start_us;
+
+  writer->printf("%d frames, %" PRIu32 "/%u keys:\n", count, keys, smap.size());
+  writer->printf("Integer keys: %6lld ms = %7.3f us/frame = %7lld frames/s\n",
+    time_int_us / 1000, (float)time_int_us / count, (long long)count * 1000000 / (time_int_us ? time_int_us : 1));
+  writer->printf("String keys : %6lld ms = %7.3f us/frame = %7lld frames/s\n",
+    time_str_us / 1000, (float)time_str_us / count, (long long)count * 1000000 / (time_str_us ? time_str_us : 1));
+
+  for (auto& it : smap)
+    delete it.second;
+  delete bench;
+  }
+#endif // #ifdef CONFIG_OVMS_COMP_RE_TOOLS
+
+// Simulate BMS cell voltage series updates (96 cells), reading the
+// four deviation thresholds per completed series like BmsSetCellVoltage():
+void test_configvalue(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  const int cells = 96;
+  int series = (argc > 0) ? atoi(argv[0]) : 1000;
+  if (series <= 0)
+    return;
+
+  float voltages[cells];
+  for (int i = 0; i < cells; i++)
+    voltages[i] = 3.7 + 0.001 * (i % 10);
+  double sum = 0;
+
+  int64_t time_start_us = esp_timer_get_time();
+  for (int j = 0; j < series; j++)
+    {
+    for (int i = 0; i < cells; i++)
+      sum += voltages[i];
+    sum += MyConfig.GetParamValueFloat("vehicle", "bms.dev.voltage.maxgrad", 0.01);
+    sum += MyConfig.GetParamValueFloat("vehicle", "bms.dev.voltage.maxsddev", 0.01);
+    sum += MyConfig.GetParamValueFloat("vehicle", "bms.dev.voltage.warn", 0.02);
+    sum += MyConfig.GetParamValueFloat("vehicle", "bms.dev.voltage.alert", 0.03);
+    }
+  int64_t time_lookup_us = esp_timer_get_time() - time_start_us;
+
+  OvmsConfigValue<float> cfg_maxgrad("vehicle", "bms.dev.voltage.maxgrad");
+  OvmsConfigValue<float> cfg_maxsddev("vehicle", "bms.dev.voltage.maxsddev");
+  OvmsConfigValue<float> cfg_warn("vehicle", "bms.dev.voltage.warn");
+  OvmsConfigValue<float> cfg_alert("vehicle", "bms.dev.voltage.alert");
+  time_start_us = esp_timer_get_time();
+  for (int j = 0; j < series; j++)
+    {
+    for (int i = 0; i < cells; i++)
+      sum += voltages[i];
+    sum += cfg_maxgrad.Get(0.01);
+    sum += cfg_maxsddev.Get(0.01);
+    sum += cfg_warn.Get(0.02);
+    sum += cfg_alert.Get(0.03);
+    }
+  int64_t time_cached_us = esp_timer_get_time() - time_start_us;
+
+  writer->printf("%d series of %d cells (checksum %.0f):\n", series, cells, sum);
+  writer->printf("GetParamValueFloat: %6lld ms = %7.2f us/series\n",
+    time_lookup_us / 1000, (float)time_lookup_us / series);
+  writer->printf("OvmsConfigValue   : %6lld ms = %7.2f us/series\n",
+    time_cached_us / 1000, (float)time_cached_us / series);
+  }
+
 void test_command(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
   {
   MyCommandApp.Display(writer);
@@ -412,5 +1206,20 @@ TestFrameworkInit::TestFrameworkInit()
   cmd_test->RegisterCommand("mkstemp", "Test mkstemp function", test_mkstemp, "<file>", 1, 1);
   cmd_test->RegisterCommand("string", "Test std::string memory corruption", test_string, "<loopcnt> <mode>\n"
     "mode: 1=m.AsJSON, 2=m.AsString, 3=m.name, 4=const cfg string, 5=const local cstr, 6=const local string", 2, 2);
+  cmd_test->RegisterCommand("metricfind", "Benchmark metric lookups by name", test_metricfind, "[<loopcnt>]", 0, 1);
+  cmd_test->RegisterCommand("metricdump", "Benchmark chunked full metrics dumps", test_metricdump);
+  cmd_test->RegisterCommand("configbatch", "Benchmark config change transactions", test_configbatch, "[<count>]", 0, 1);
+  cmd_test->RegisterCommand("canfilter", "Benchmark CAN filter per frame cost", test_canfilter, "[<frames>]", 0, 1);
+  cmd_test->RegisterCommand("canring", "Benchmark CAN frame distribution to consumers", test_canring, "[<frames>] [<consumers>]", 0, 2);
+  cmd_test->RegisterCommand("dbcdecode", "Benchmark DBC frame decoding", test_dbcdecode, "<dbc> [<frames>]", 1, 2);
+  cmd_test->RegisterCommand("dbcload", "Benchmark DBC file loading", test_dbcload, "<path>", 1, 1);
+#ifdef CONFIG_OVMS_COMP_RE_TOOLS
+  cmd_test->RegisterCommand("retools", "Benchmark retools frame analysis on a CAN log", test_retools,
+    "<format> <path> [<frames>]\n"
+    "Replays up to <frames> (default 20000) frames from the log file", 2, 3);
+#endif // #ifdef CONFIG_OVMS_COMP_RE_TOOLS
+  cmd_test->RegisterCommand("configvalue", "Benchmark cached config values", test_configvalue, "[<series>]", 0, 1);
+  cmd_test->RegisterCommand("events", "Benchmark event signalling", test_events, "[<count>]", 0, 1);
+  cmd_test->RegisterCommand("metricformat", "Benchmark metric value formatting", test_metricformat, "[<loopcnt>]", 0, 1);
   cmd_test->RegisterCommand("commands", "List command tree", test_command);
   }
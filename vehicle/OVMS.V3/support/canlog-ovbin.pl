@@ -0,0 +1,285 @@
+#!/usr/bin/perl
+
+# Convert CAN logs between CRTD and the compact binary "ovbin" format
+# (see components/can/src/canformat_ovbin.h for the format description).
+#
+# Usage: canlog-ovbin.pl encode|decode [<infile> [<outfile>]]
+#   encode: CRTD -> ovbin
+#   decode: ovbin -> CRTD
+
+use strict;
+use warnings;
+
+my $VERSION     = 1;
+my $SYNCRECORDS = 1024;
+my $DICTSIZE    = 512;
+my $MAXTEXT     = 255;
+my $NOBUS       = 7;
+my $MARKER      = "\xffOVB";
+
+# Log types as in CAN_log_type_t:
+my @TYPES = ('-', 'RX', 'TX', 'TX_Queue', 'TX_Fail', 'Error', 'Status', 'Comment', 'Info', 'Event', 'Metric');
+my %TYPENUM = map { $TYPES[$_] => $_ } 0..$#TYPES;
+my $T_ERROR = 5;
+
+# CAN_status_t fields in ovbin order, with their CRTD names:
+my @STATUS = ('intr', 'rxpkt', 'txpkt', 'txdelay', 'rxovr', 'txovr', 'txfail',
+              'errflags', 'rxerr', 'txerr', 'rxinval', 'wdgreset', 'errreset', 'errtime');
+
+my $mode = shift @ARGV || '';
+my $in = \*STDIN;
+my $out = \*STDOUT;
+if (@ARGV) { open $in, '<', shift @ARGV or die "Cannot open input: $!\n"; }
+if (@ARGV) { open $out, '>', shift @ARGV or die "Cannot open output: $!\n"; }
+binmode $in;
+binmode $out;
+
+if ($mode eq 'encode')
+  { encode(); }
+elsif ($mode eq 'decode')
+  { decode(); }
+else
+  { die "Usage: $0 encode|decode [<infile> [<outfile>]]\n"; }
+exit 0;
+
+sub varint
+  {
+  my ($v) = @_;
+  my $r = '';
+  while ($v >= 0x80)
+    {
+    $r .= chr(($v & 0x7f) | 0x80);
+    $v = int($v / 128);
+    }
+  return $r . chr($v);
+  }
+
+sub encode
+  {
+  my (@dict, $time, $records, $total, $bytes, $sync);
+  $sync = 1;
+  $total = $bytes = 0;
+
+  print $out $MARKER . 'H' . chr($VERSION);
+
+  while (my $line = <$in>)
+    {
+    $line =~ s/[\r\n]+$//;
+    next unless $line =~ /^(\d+)(?:\.(\d+))?\s+(\d?)(\S+)\s*(.*)$/;
+    my ($sec, $frac, $bus, $code, $rest) = ($1, $2 || '0', $3, $4, $5);
+    my $usec = substr($frac . '000000', 0, 6) + 0;
+    my $t = $sec * 1000000 + $usec;
+    $bus = ($bus eq '') ? 0 : $bus - 1;
+    $bus = $NOBUS if ($bus < 0 || $bus > $NOBUS);
+
+    # Parse the record:
+    my ($type, $ext, $id, @data, @status, $text);
+    if ($code =~ /^([RT])(11|29)$/)
+      {
+      $type = ($1 eq 'R') ? $TYPENUM{'RX'} : $TYPENUM{'TX'};
+      $ext = ($2 eq '29') ? 1 : 0;
+      ($id, @data) = split /\s+/, $rest;
+      }
+    elsif ($code eq 'CER' && $rest =~ /^(TX_Queue|TX_Fail)\s+[RT](11|29)\s+(.*)$/)
+      {
+      $type = $TYPENUM{$1};
+      $ext = ($2 eq '29') ? 1 : 0;
+      ($id, @data) = split /\s+/, $3;
+      }
+    elsif (($code eq 'CER' || $code eq 'CST') && $rest =~ /^(Error|Status)\s+(.*)$/)
+      {
+      $type = $TYPENUM{$1};
+      my %kv = map { split /=/, $_, 2 } split /\s+/, $2;
+      @status = map { defined $kv{$_} ? (($kv{$_} =~ /^0x/i) ? hex($kv{$_}) : $kv{$_} + 0) : 0 } @STATUS;
+      }
+    elsif ($code eq 'CXX' || $code eq 'CEV' || $code eq 'CMT')
+      {
+      next if ($rest eq 'OVMS CRTD');
+      if ($rest =~ /^(Comment|Info|Event|Metric)\s(.*)$/)
+        { ($type, $text) = ($TYPENUM{$1}, $2); }
+      else
+        { ($type, $text) = ($TYPENUM{'Comment'}, $rest); }
+      }
+    else
+      {
+      next;
+      }
+
+    # Encode it:
+    my $rec = '';
+    if ($sync || $records >= $SYNCRECORDS || $t < $time)
+      {
+      $rec .= $MARKER . 'S' . varint($sec) . varint($usec) . varint($total) . varint($bytes);
+      @dict = ();
+      ($time, $records, $bytes, $sync) = ($t, 0, 0, 0);
+      }
+
+    if (defined $id)
+      {
+      @data = map { hex } @data[0 .. ($#data < 7 ? $#data : 7)];
+      my $spec = (($type - 1) << 6) | ($ext ? 0x20 : 0) | scalar(@data);
+      my $key = $spec . ':' . hex($id);
+      $dict[$bus] ||= {};
+      if (defined $dict[$bus]{$key})
+        {
+        $rec .= chr($bus << 3) . varint($dict[$bus]{$key});
+        }
+      else
+        {
+        if (scalar(keys %{$dict[$bus]}) >= $DICTSIZE)
+          {
+          print $out $rec;
+          $rec = $MARKER . 'S' . varint($sec) . varint($usec) . varint($total) . varint($bytes);
+          @dict = ();
+          $dict[$bus] = {};
+          ($time, $records, $bytes) = ($t, 0, 0);
+          }
+        $dict[$bus]{$key} = scalar(keys %{$dict[$bus]});
+        $rec .= chr(0x40 | ($bus << 3)) . chr($spec) . varint(hex($id));
+        }
+      $rec .= varint($t - $time) . join('', map { chr } @data);
+      }
+    else
+      {
+      $rec .= chr(0x80 | ($bus << 3) | ($type - $T_ERROR)) . varint($t - $time);
+      if (@status)
+        {
+        $rec .= join('', map { varint($_) } @status);
+        }
+      else
+        {
+        $text = substr($text, 0, $MAXTEXT);
+        $rec .= varint(length($text)) . $text;
+        }
+      }
+
+    print $out $rec;
+    $time = $t;
+    $records++;
+    $total++;
+    $bytes += length($rec);
+    }
+  }
+
+sub decode
+  {
+  local $/;
+  my $buf = <$in>;
+  my $len = length($buf);
+  my $pos = 0;
+  my (@dict, $time);
+  my $synced = 0;
+
+  my $getvarint = sub
+    {
+    my ($v, $shift) = (0, 0);
+    while (1)
+      {
+      die "Truncated input at offset $pos\n" if ($pos >= $len);
+      my $b = ord(substr($buf, $pos++, 1));
+      $v += ($b & 0x7f) * (2 ** $shift);
+      return $v if (($b & 0x80) == 0);
+      $shift += 7;
+      }
+    };
+
+  print $out "0.000000 CXX OVMS CRTD\n0.000000 CVR 3.1\n";
+
+  while ($pos < $len)
+    {
+    if (substr($buf, $pos, 4) eq $MARKER)
+      {
+      my $kind = substr($buf, $pos+4, 1);
+      $pos += 5;
+      if ($kind eq 'H')
+        {
+        my $version = ord(substr($buf, $pos++, 1));
+        die "Unsupported format version $version\n" if ($version != $VERSION);
+        }
+      elsif ($kind eq 'S')
+        {
+        my $sec = $getvarint->();
+        my $usec = $getvarint->();
+        $getvarint->();
+        $getvarint->();
+        $time = $sec * 1000000 + $usec;
+        @dict = ();
+        $synced = 1;
+        }
+      next;
+      }
+    if (!$synced)
+      {
+      $pos++;
+      next;
+      }
+
+    my $tag = ord(substr($buf, $pos++, 1));
+    my $bus = ($tag >> 3) & 0x07;
+    my $busc = ($bus == $NOBUS) ? '1' : $bus + 1;
+    my ($spec, $id);
+    if (($tag & 0x80) == 0)
+      {
+      $dict[$bus] ||= [];
+      if ($tag & 0x40)
+        {
+        $spec = ord(substr($buf, $pos++, 1));
+        $id = $getvarint->();
+        push @{$dict[$bus]}, [$spec, $id];
+        }
+      else
+        {
+        my $index = $getvarint->();
+        die "Invalid dictionary reference at offset $pos\n" if ($index > $#{$dict[$bus]});
+        ($spec, $id) = @{$dict[$bus][$index]};
+        }
+      $time += $getvarint->();
+      my $dlc = $spec & 0x0f;
+      my @data = map { sprintf('%02X', ord) } split //, substr($buf, $pos, $dlc);
+      $pos += $dlc;
+      my $type = ($spec >> 6) + 1;
+      my $ff = ($spec & 0x20) ? '29' : '11';
+      my $idstr = ($spec & 0x20) ? sprintf('%08X', $id) : sprintf('%03X', $id);
+      my $frame = join(' ', $ff, $idstr, @data);
+      if ($TYPES[$type] eq 'RX')
+        { printf $out "%s %sR%s\n", timestr($time), $busc, $frame; }
+      elsif ($TYPES[$type] eq 'TX')
+        { printf $out "%s %sT%s\n", timestr($time), $busc, $frame; }
+      else
+        { printf $out "%s %sCER %s T%s\n", timestr($time), $busc, $TYPES[$type], $frame; }
+      }
+    elsif ($tag < 0xc0)
+      {
+      my $type = $T_ERROR + ($tag & 0x07);
+      $time += $getvarint->();
+      if ($TYPES[$type] eq 'Error' || $TYPES[$type] eq 'Status')
+        {
+        my %kv;
+        $kv{$_} = $getvarint->() foreach (@STATUS);
+        printf $out "%s %s%s %s intr=%d rxpkt=%d txpkt=%d errflags=%#x rxerr=%d txerr=%d"
+          . " rxinval=%d rxovr=%d txovr=%d txdelay=%d txfail=%d wdgreset=%d errreset=%d\n",
+          timestr($time), $busc, ($TYPES[$type] eq 'Error') ? 'CER' : 'CST', $TYPES[$type],
+          @kv{qw(intr rxpkt txpkt errflags rxerr txerr rxinval rxovr txovr txdelay txfail wdgreset errreset)};
+        }
+      else
+        {
+        my $n = $getvarint->();
+        my $text = substr($buf, $pos, $n);
+        $pos += $n;
+        my $code = ($TYPES[$type] eq 'Event') ? 'CEV' : ($TYPES[$type] eq 'Metric') ? 'CMT' : 'CXX';
+        printf $out "%s %s%s %s %s\n", timestr($time), $busc, $code, $TYPES[$type], $text;
+        }
+      }
+    else
+      {
+      warn sprintf("Invalid record tag 0x%02x at offset %d, resyncing\n", $tag, $pos-1);
+      $synced = 0;
+      }
+    }
+  }
+
+sub timestr
+  {
+  my ($t) = @_;
+  return sprintf('%d.%06d', int($t / 1000000), $t % 1000000);
+  }
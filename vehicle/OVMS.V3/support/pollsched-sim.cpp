@@ -0,0 +1,253 @@
+/*
+ * Host simulation of the vehicle poll list schedulers
+ *
+ * Runs a 100 entry poll list with intervals from 100 ms to 60 s against
+ *  a) the per second list scan (ticker % polltime, PollSetTimeBase(0))
+ *  b) the deadline scheduler (OvmsPollScheduler, PollSetTimeBase(50))
+ * using a simulated response time per request, the FreeRTOS tick granularity
+ * for the vehicle task wakeups, the poll throttling (PollSetThrottling(), polls
+ * per second resp. per time base unit, 0 = unlimited) and background bus
+ * traffic processed by the vehicle task, and reports the achieved poll rate
+ * and the interval jitter per interval class.
+ *
+ * Build & run from the OVMS.V3 directory:
+ *   g++ -std=gnu++11 -O2 -I components/vehicle -o pollsched-sim \
+ *     support/pollsched-sim.cpp components/vehicle/vehicle_poller_sched.cpp
+ *   ./pollsched-sim [<seconds> [<resp_min_ms> <resp_max_ms> [<tick_ms>
+ *     [<sequence_max> [<bus_frames_per_second>]]]]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <vector>
+#include "vehicle_poller_sched.h"
+
+struct sim_class_t
+  {
+  uint32_t interval;        // requested interval [ms]
+  int count;                // entries in list
+  };
+
+static const sim_class_t sim_classes[] =
+  {
+  {   100,  5 },
+  {   250,  5 },
+  {   500, 10 },
+  {  1000, 35 },
+  {  2000, 20 },
+  {  5000, 10 },
+  { 10000, 10 },
+  { 60000,  5 },
+  };
+#define SIM_NCLASSES (sizeof(sim_classes)/sizeof(sim_classes[0]))
+#define SIM_TIMEBASE 50
+#define SIM_WARMUP   60000
+#define SIM_FRAME_US 50           // vehicle task time per background frame [us]
+
+struct sim_entry_t
+  {
+  int cls;
+  uint32_t interval;        // requested interval [ms]
+  uint16_t polltime_scan;   // polltime for the list scan [s]
+  uint16_t polltime_sched;  // polltime for the deadline scheduler [time base units]
+  std::vector<uint32_t> sent;
+  };
+
+static std::vector<sim_entry_t> entries;
+static std::vector<uint32_t> burst;     // polls per 100 ms window
+static uint32_t seed;
+static uint32_t resp_min = 2, resp_max = 8, tick = 10, duration = 600000;
+static uint32_t sequence_max = 1, bus_fps = 2000;
+
+static uint32_t ResponseTime()
+  {
+  seed = seed * 1103515245 + 12345;
+  return resp_min + ((seed >> 16) % (resp_max - resp_min + 1));
+  }
+
+static void Sent(int index, uint32_t t)
+  {
+  entries[index].sent.push_back(t);
+  if (t / 100 < burst.size()) burst[t / 100]++;
+  }
+
+static void Reset()
+  {
+  seed = 4711;
+  for (auto& e : entries) e.sent.clear();
+  burst.assign(duration / 100 + 1, 0);
+  }
+
+// Per second list scan: the primary (1 Hz) ticker advances the ticker when the
+// run is complete and sends the first due request, further due requests follow
+// on each response while the throttling allows; the cursor keeps its position
+// over throttled seconds. Background frames only delay the responses slightly,
+// as the list scan doesn't depend on the vehicle task wakeups.
+static uint32_t SimScan()
+  {
+  uint32_t checks = 0;
+  uint32_t ticker = 0;
+  size_t cursor = entries.size();   // at end: start a new run on the next tick
+  for (uint32_t t = 0; t < duration; t += 1000)
+    {
+    if (cursor >= entries.size())
+      {
+      if (t > 0 && ++ticker > 3600) ticker -= 3600;
+      cursor = 0;
+      }
+    uint32_t c = t, cnt = 0;
+    while (cursor < entries.size() && (!sequence_max || cnt < sequence_max) && c < t + 1000)
+      {
+      checks++;
+      size_t i = cursor++;
+      if ((ticker % entries[i].polltime_scan) == 0)
+        {
+        Sent(i, c);
+        uint32_t r = ResponseTime();
+        c += r + (r * bus_fps * SIM_FRAME_US) / 1000000;
+        cnt++;
+        }
+      }
+    }
+  return checks;
+  }
+
+// Deadline scheduler: the vehicle task checks the schedule after each received
+// frame and on wakeup, and sends whenever an entry is due, no response is pending
+// and the throttling allows (per time base unit). Time is simulated in microseconds,
+// background frames arrive evenly and take SIM_FRAME_US each to process.
+static OvmsPollScheduler SimSched()
+  {
+  OvmsPollScheduler sched;
+  for (size_t i = 0; i < entries.size(); i++)
+    sched.Add(i, entries[i].polltime_sched * SIM_TIMEBASE, 0);
+  uint64_t t = 0, end = (uint64_t)duration * 1000;
+  uint64_t frame_us = bus_fps ? 1000000 / bus_fps : 0;
+  uint64_t next_frame = frame_us ? 0 : UINT64_MAX;
+  uint32_t sched_tick = 0, cnt = 0;
+  while (t < end)
+    {
+    // process background frames received until now:
+    while (next_frame <= t)
+      {
+      t += SIM_FRAME_US;
+      next_frame += frame_us;
+      }
+    uint32_t now = t / 1000;
+    uint64_t wake;
+    if (now / SIM_TIMEBASE != sched_tick)
+      {
+      sched_tick = now / SIM_TIMEBASE;
+      cnt = 0;
+      }
+    if (sequence_max && cnt >= sequence_max)
+      {
+      // throttled: wait for the next time base tick
+      wake = (uint64_t)(sched_tick + 1) * SIM_TIMEBASE * 1000;
+      }
+    else
+      {
+      int index = sched.Pop(now);
+      if (index >= 0)
+        {
+        Sent(index, now);
+        cnt++;
+        t += ResponseTime() * 1000;
+        continue;
+        }
+      wake = (uint64_t)(now + sched.TimeToDue(now)) * 1000;
+      }
+    // sleep until the next frame or the wakeup, rounded up to the next tick:
+    if (next_frame < wake)
+      t = next_frame;
+    else
+      t = ((wake + tick*1000 - 1) / (tick*1000)) * tick*1000;
+    }
+  return sched;
+  }
+
+static void Report(const char* title)
+  {
+  printf("\n%s:\n", title);
+  printf("  %8s %5s %10s %10s %10s %10s %10s\n",
+    "Interval", "Count", "Req/s", "Polls/s", "Mean ms", "Jitter ms", "Max dev");
+  double total = 0;
+  for (size_t c = 0; c < SIM_NCLASSES; c++)
+    {
+    double polls = 0, n = 0, sum = 0, sum2 = 0, maxdev = 0;
+    for (auto& e : entries)
+      {
+      if (e.cls != (int)c) continue;
+      for (size_t k = 1; k < e.sent.size(); k++)
+        {
+        if (e.sent[k-1] < SIM_WARMUP) continue;
+        double dt = e.sent[k] - e.sent[k-1];
+        n++; sum += dt; sum2 += dt*dt;
+        if (fabs(dt - e.interval) > maxdev) maxdev = fabs(dt - e.interval);
+        }
+      for (auto s : e.sent)
+        if (s >= SIM_WARMUP) polls++;
+      }
+    double secs = (duration - SIM_WARMUP) / 1000.0;
+    double mean = n ? sum/n : 0;
+    double sd = n ? sqrt(sum2/n - mean*mean) : 0;
+    total += polls / secs;
+    printf("  %8u %5d %10.2f %10.2f %10.1f %10.1f %10.0f\n",
+      sim_classes[c].interval, sim_classes[c].count,
+      sim_classes[c].count * 1000.0 / sim_classes[c].interval,
+      polls / secs, mean, sd, maxdev);
+    }
+  uint32_t peak = 0;
+  for (size_t k = SIM_WARMUP / 100; k < burst.size(); k++)
+    if (burst[k] > peak) peak = burst[k];
+  printf("  Total %.1f polls/s, peak %u polls per 100 ms window\n", total, peak);
+  }
+
+int main(int argc, char* argv[])
+  {
+  if (argc > 1) duration = atoi(argv[1]) * 1000;
+  if (argc > 3) { resp_min = atoi(argv[2]); resp_max = atoi(argv[3]); }
+  if (argc > 4) tick = atoi(argv[4]);
+  if (argc > 5) sequence_max = atoi(argv[5]);
+  if (argc > 6) bus_fps = atoi(argv[6]);
+  if (duration <= SIM_WARMUP || resp_max < resp_min || tick == 0 || bus_fps > 1000000 / SIM_FRAME_US / 2)
+    {
+    fprintf(stderr, "Usage: %s [<seconds> [<resp_min_ms> <resp_max_ms> [<tick_ms> [<sequence_max> [<bus_fps>]]]]]\n", argv[0]);
+    return 1;
+    }
+
+  for (size_t c = 0; c < SIM_NCLASSES; c++)
+    {
+    for (int k = 0; k < sim_classes[c].count; k++)
+      {
+      sim_entry_t e;
+      e.cls = c;
+      e.interval = sim_classes[c].interval;
+      e.polltime_scan = (e.interval < 1000) ? 1 : e.interval / 1000;
+      e.polltime_sched = e.interval / SIM_TIMEBASE;
+      entries.push_back(e);
+      }
+    }
+
+  printf("Poll list: %u entries, response time %u-%u ms, task tick %u ms, %u s simulated (%u s warmup)\n",
+    (unsigned)entries.size(), resp_min, resp_max, tick, duration/1000, SIM_WARMUP/1000);
+  printf("Throttling: %u polls per tick (0 = unlimited), background traffic: %u frames/s @ %u us\n",
+    sequence_max, bus_fps, SIM_FRAME_US);
+
+  Reset();
+  uint32_t checks = SimScan();
+  Report("Per second list scan (PollSetTimeBase(0))");
+  size_t polls = 0;
+  for (auto& e : entries) polls += e.sent.size();
+  printf("  %.1f entries checked per poll\n", polls ? (double)checks / polls : 0.0);
+
+  Reset();
+  OvmsPollScheduler sched = SimSched();
+  Report("Deadline scheduler (PollSetTimeBase(50))");
+  printf("  Lateness: mean %.1f ms, max %u ms, %u rounds skipped\n",
+    sched.m_polls ? (double)sched.m_late_sum / sched.m_polls : 0.0, sched.m_late_max, sched.m_skipped);
+
+  return 0;
+  }